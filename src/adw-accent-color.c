@@ -11,6 +11,8 @@
 
 #include "adw-color-utils-private.h"
 
+#include <math.h>
+
 /**
  * AdwAccentColor:
  * @ADW_ACCENT_COLOR_BLUE: Use a blue color (`#3584e4`). This is the default value.
@@ -197,3 +199,313 @@ adw_accent_color_nearest_from_rgba (const GdkRGBA *original_color)
 
   return ADW_ACCENT_COLOR_PINK;
 }
+
+#define MAX_SAMPLE_SIZE 64
+#define MAX_CELL_SAMPLES 4
+#define CHROMA_THRESHOLD 0.04f
+#define MIN_CHROMATIC_FRACTION 0.05
+#define N_L_BINS 4
+#define N_AB_BINS 16
+#define AB_RANGE 0.4f
+
+typedef struct {
+  GdkTexture *texture;
+  GBytes *bytes;
+  gsize stride;
+  int width;
+  int height;
+} ExtractData;
+
+typedef struct {
+  AdwAccentColor accent;
+  GdkRGBA rgba;
+} ExtractResult;
+
+typedef struct {
+  float L;
+  float a;
+  float b;
+  guint count;
+} Bin;
+
+static void
+extract_data_free (ExtractData *data)
+{
+  g_clear_object (&data->texture);
+  g_clear_pointer (&data->bytes, g_bytes_unref);
+  g_free (data);
+}
+
+static GBytes *
+download_texture (GdkTexture *texture,
+                  gsize      *stride)
+{
+  GdkTextureDownloader *downloader = gdk_texture_downloader_new (texture);
+  GBytes *bytes;
+
+  gdk_texture_downloader_set_format (downloader, GDK_MEMORY_R8G8B8A8);
+  bytes = gdk_texture_downloader_download_bytes (downloader, stride);
+  gdk_texture_downloader_free (downloader);
+
+  return bytes;
+}
+
+/* Averages the mostly opaque pixels in cells of the texture, so that there
+ * are at most MAX_SAMPLE_SIZE × MAX_SAMPLE_SIZE samples. Large cells are only
+ * sampled every few pixels in each direction, reading at most
+ * MAX_CELL_SAMPLES × MAX_CELL_SAMPLES pixels per cell */
+static gsize
+downsample (ExtractData   *data,
+            GCancellable  *cancellable,
+            float        **samples)
+{
+  const guchar *pixels = g_bytes_get_data (data->bytes, NULL);
+  int cell_size = (MAX (data->width, data->height) + MAX_SAMPLE_SIZE - 1) / MAX_SAMPLE_SIZE;
+  int n_cols = (data->width + cell_size - 1) / cell_size;
+  int n_rows = (data->height + cell_size - 1) / cell_size;
+  int step = MAX (1, cell_size / MAX_CELL_SAMPLES);
+  float *rgb = g_new (float, n_cols * n_rows * 3);
+  gsize n = 0;
+  int row, col;
+
+  for (row = 0; row < n_rows; row++) {
+    int y0 = row * cell_size;
+    int y1 = MIN (y0 + cell_size, data->height);
+
+    if (g_cancellable_is_cancelled (cancellable))
+      break;
+
+    for (col = 0; col < n_cols; col++) {
+      int x0 = col * cell_size;
+      int x1 = MIN (x0 + cell_size, data->width);
+      guint sum[3] = { 0, };
+      guint count = 0, n_read = 0;
+      int x, y;
+
+      for (y = y0; y < y1; y += step) {
+        const guchar *p = pixels + y * data->stride + x0 * 4;
+
+        for (x = x0; x < x1; x += step, p += step * 4) {
+          n_read++;
+
+          if (p[3] < 128)
+            continue;
+
+          sum[0] += p[0];
+          sum[1] += p[1];
+          sum[2] += p[2];
+          count++;
+        }
+      }
+
+      /* Skip cells that are mostly transparent */
+      if (count * 2 < n_read)
+        continue;
+
+      rgb[n * 3] = sum[0] / (255.0f * count);
+      rgb[n * 3 + 1] = sum[1] / (255.0f * count);
+      rgb[n * 3 + 2] = sum[2] / (255.0f * count);
+      n++;
+    }
+  }
+
+  *samples = rgb;
+
+  return n;
+}
+
+static inline int
+get_bin_index (float value,
+               float min,
+               float max,
+               int   n_bins)
+{
+  return CLAMP ((int) ((value - min) / (max - min) * n_bins), 0, n_bins - 1);
+}
+
+static void
+extract_thread (GTask        *task,
+                gpointer      source_object,
+                ExtractData  *data,
+                GCancellable *cancellable)
+{
+  ExtractResult *result = g_new0 (ExtractResult, 1);
+  Bin *bins, *best = NULL;
+  float *samples;
+  float L = 0, a = 0, b = 0;
+  gsize n_samples, n_chromatic = 0, i;
+
+  /* Textures can be downloaded from any thread, GL textures take care of
+   * doing it with their context themselves. Large textures take a while to
+   * download, so don't do it on the calling thread */
+  data->bytes = download_texture (data->texture, &data->stride);
+
+  n_samples = downsample (data, cancellable, &samples);
+
+  if (g_task_return_error_if_cancelled (task)) {
+    g_free (samples);
+    g_free (result);
+    return;
+  }
+
+  if (n_samples == 0) {
+    g_free (samples);
+
+    result->accent = ADW_ACCENT_COLOR_BLUE;
+    adw_accent_color_to_rgba (result->accent, &result->rgba);
+    g_task_return_pointer (task, result, g_free);
+    return;
+  }
+
+  adw_rgb_to_oklab_n (samples, samples, n_samples);
+
+  /* Find the most common chromatic color, grays and near-grays would end up
+   * as slate regardless of their lightness */
+  bins = g_new0 (Bin, N_L_BINS * N_AB_BINS * N_AB_BINS);
+
+  for (i = 0; i < n_samples; i++) {
+    float *lab = &samples[i * 3];
+    Bin *bin;
+
+    L += lab[0];
+    a += lab[1];
+    b += lab[2];
+
+    if (hypotf (lab[1], lab[2]) < CHROMA_THRESHOLD)
+      continue;
+
+    bin = &bins[(get_bin_index (lab[0], 0, 1, N_L_BINS) * N_AB_BINS +
+                 get_bin_index (lab[1], -AB_RANGE, AB_RANGE, N_AB_BINS)) * N_AB_BINS +
+                get_bin_index (lab[2], -AB_RANGE, AB_RANGE, N_AB_BINS)];
+
+    bin->L += lab[0];
+    bin->a += lab[1];
+    bin->b += lab[2];
+    bin->count++;
+
+    if (!best || bin->count > best->count)
+      best = bin;
+
+    n_chromatic++;
+  }
+
+  if (best && n_chromatic >= n_samples * MIN_CHROMATIC_FRACTION) {
+    L = best->L / best->count;
+    a = best->a / best->count;
+    b = best->b / best->count;
+  } else {
+    L /= n_samples;
+    a /= n_samples;
+    b /= n_samples;
+  }
+
+  adw_oklab_to_rgb (L, a, b,
+                    &result->rgba.red,
+                    &result->rgba.green,
+                    &result->rgba.blue);
+
+  result->rgba.red =   CLAMP (result->rgba.red,   0, 1);
+  result->rgba.green = CLAMP (result->rgba.green, 0, 1);
+  result->rgba.blue =  CLAMP (result->rgba.blue,  0, 1);
+  result->rgba.alpha = 1;
+
+  if (best && n_chromatic >= n_samples * MIN_CHROMATIC_FRACTION)
+    result->accent = adw_accent_color_nearest_from_rgba (&result->rgba);
+  else
+    result->accent = ADW_ACCENT_COLOR_SLATE;
+
+  g_free (bins);
+  g_free (samples);
+
+  g_task_return_pointer (task, result, g_free);
+}
+
+/**
+ * adw_accent_color_from_texture_async:
+ * @texture: a texture
+ * @cancellable: (nullable): a cancellable
+ * @callback: (scope async): a callback to call when the operation is complete
+ * @user_data: (closure callback): data to pass to @callback
+ *
+ * Finds the accent color closest to the dominant color of @texture.
+ *
+ * This can be used to pick an accent color from an album cover or a wallpaper,
+ * for example.
+ *
+ * The texture is downloaded, downscaled and its colors are grouped in the
+ * OKLab color space on a worker thread, so this is safe to use even for very
+ * large textures. Transparent parts of the texture are ignored.
+ *
+ * If the texture is mostly gray, the result is [enum@AccentColor.SLATE]. If
+ * the texture is fully transparent, the result is [enum@AccentColor.BLUE].
+ *
+ * Call [func@AccentColor.from_texture_finish] in @callback to get the result.
+ *
+ * Since: 1.10
+ */
+void
+adw_accent_color_from_texture_async (GdkTexture          *texture,
+                                     GCancellable        *cancellable,
+                                     GAsyncReadyCallback  callback,
+                                     gpointer             user_data)
+{
+  ExtractData *data;
+  GTask *task;
+
+  g_return_if_fail (GDK_IS_TEXTURE (texture));
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  data = g_new0 (ExtractData, 1);
+  data->texture = g_object_ref (texture);
+  data->width = gdk_texture_get_width (texture);
+  data->height = gdk_texture_get_height (texture);
+
+  task = g_task_new (NULL, cancellable, callback, user_data);
+  g_task_set_source_tag (task, adw_accent_color_from_texture_async);
+  g_task_set_task_data (task, data, (GDestroyNotify) extract_data_free);
+  g_task_run_in_thread (task, (GTaskThreadFunc) extract_thread);
+
+  g_object_unref (task);
+}
+
+/**
+ * adw_accent_color_from_texture_finish:
+ * @result: a `GAsyncResult`
+ * @rgba: (out) (optional): return location for the dominant color
+ * @error: return location for an error
+ *
+ * Finishes an operation started with [func@AccentColor.from_texture_async].
+ *
+ * If @rgba is not `NULL`, it's set to the dominant color of the texture, which
+ * can be used when the exact color is needed rather than an accent color.
+ *
+ * Returns: the accent color, or [enum@AccentColor.BLUE] on error
+ *
+ * Since: 1.10
+ */
+AdwAccentColor
+adw_accent_color_from_texture_finish (GAsyncResult  *result,
+                                      GdkRGBA       *rgba,
+                                      GError       **error)
+{
+  ExtractResult *extract_result;
+  AdwAccentColor accent;
+
+  g_return_val_if_fail (g_task_is_valid (result, NULL), ADW_ACCENT_COLOR_BLUE);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == adw_accent_color_from_texture_async,
+                        ADW_ACCENT_COLOR_BLUE);
+
+  extract_result = g_task_propagate_pointer (G_TASK (result), error);
+
+  if (!extract_result)
+    return ADW_ACCENT_COLOR_BLUE;
+
+  if (rgba)
+    *rgba = extract_result->rgba;
+
+  accent = extract_result->accent;
+
+  g_free (extract_result);
+
+  return accent;
+}
@@ -42,4 +42,14 @@ void adw_rgba_to_standalone (const GdkRGBA *rgba,
                              gboolean       dark,
                              GdkRGBA       *standalone_rgba);
 
+ADW_AVAILABLE_IN_1_10
+void           adw_accent_color_from_texture_async  (GdkTexture           *texture,
+                                                     GCancellable         *cancellable,
+                                                     GAsyncReadyCallback   callback,
+                                                     gpointer              user_data);
+ADW_AVAILABLE_IN_1_10
+AdwAccentColor adw_accent_color_from_texture_finish (GAsyncResult         *result,
+                                                     GdkRGBA              *rgba,
+                                                     GError              **error);
+
 G_END_DECLS
@@ -109,13 +109,45 @@ enum {
 
 static guint signals[SIGNAL_LAST_SIGNAL];
 
-static gboolean
-string_is_not_empty (AdwActionRow *self,
-                     const char   *string)
+static inline gboolean
+string_is_not_empty (const char *string)
 {
   return string && string[0];
 }
 
+static void
+update_title (AdwActionRow *self)
+{
+  AdwActionRowPrivate *priv = adw_action_row_get_instance_private (self);
+  const char *title = adw_preferences_row_get_title (ADW_PREFERENCES_ROW (self));
+
+  gtk_label_set_label (priv->title, title);
+  gtk_widget_set_visible (GTK_WIDGET (priv->title), string_is_not_empty (title));
+}
+
+static void
+notify_cb (AdwActionRow *self,
+           GParamSpec   *pspec)
+{
+  AdwActionRowPrivate *priv = adw_action_row_get_instance_private (self);
+  const char *name = g_param_spec_get_name (pspec);
+
+  if (!g_strcmp0 (name, "title")) {
+    update_title (self);
+  } else if (!g_strcmp0 (name, "use-underline")) {
+    gtk_label_set_use_underline (priv->title,
+                                 adw_preferences_row_get_use_underline (ADW_PREFERENCES_ROW (self)));
+  } else if (!g_strcmp0 (name, "title-selectable")) {
+    gtk_label_set_selectable (priv->title,
+                              adw_preferences_row_get_title_selectable (ADW_PREFERENCES_ROW (self)));
+  } else if (!g_strcmp0 (name, "use-markup")) {
+    gboolean use_markup = adw_preferences_row_get_use_markup (ADW_PREFERENCES_ROW (self));
+
+    gtk_label_set_use_markup (priv->title, use_markup);
+    gtk_label_set_use_markup (priv->subtitle, use_markup);
+  }
+}
+
 static void
 pressed_cb (AdwActionRow *self,
             int           n_press,
@@ -426,23 +458,97 @@ adw_action_row_class_init (AdwActionRowClass *klass)
                               G_TYPE_FROM_CLASS (klass),
                               adw_marshal_VOID__VOIDv);
 
-  gtk_widget_class_set_template_from_resource (widget_class,
-                                               "/org/gnome/Adwaita/ui/adw-action-row.ui");
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, header);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, image);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, prefixes);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, subtitle);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, suffixes);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, title);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwActionRow, title_box);
-  gtk_widget_class_bind_template_callback (widget_class, string_is_not_empty);
-  gtk_widget_class_bind_template_callback (widget_class, pressed_cb);
 }
 
+static GtkLabel *
+create_label (const char *css_class)
+{
+  GtkLabel *label = GTK_LABEL (gtk_label_new (NULL));
+
+  gtk_label_set_lines (label, 0);
+  gtk_label_set_wrap (label, TRUE);
+  gtk_label_set_wrap_mode (label, PANGO_WRAP_WORD_CHAR);
+  gtk_label_set_xalign (label, 0);
+  gtk_widget_set_visible (GTK_WIDGET (label), FALSE);
+  gtk_widget_add_css_class (GTK_WIDGET (label), css_class);
+
+  return label;
+}
+
+static GtkBox *
+create_box (GtkOrientation  orientation,
+            const char     *css_class)
+{
+  GtkBox *box = GTK_BOX (gtk_box_new (orientation, 0));
+
+  gtk_widget_add_css_class (GTK_WIDGET (box), css_class);
+
+  return box;
+}
+
+/* Action rows are often created by the hundreds, so the widgets are created
+ * directly instead of going through GtkBuilder */
 static void
 adw_action_row_init (AdwActionRow *self)
 {
-  gtk_widget_init_template (GTK_WIDGET (self));
+  AdwActionRowPrivate *priv = adw_action_row_get_instance_private (self);
+  GtkEventController *gesture;
+
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (self), FALSE);
+
+  priv->header = GTK_WIDGET (create_box (GTK_ORIENTATION_HORIZONTAL, "header"));
+  gtk_widget_set_valign (priv->header, GTK_ALIGN_CENTER);
+  gtk_widget_set_hexpand (priv->header, FALSE);
+  gtk_list_box_row_set_child (GTK_LIST_BOX_ROW (self), priv->header);
+
+  priv->prefixes = create_box (GTK_ORIENTATION_HORIZONTAL, "prefixes");
+  gtk_widget_set_visible (GTK_WIDGET (priv->prefixes), FALSE);
+  gtk_box_append (GTK_BOX (priv->header), GTK_WIDGET (priv->prefixes));
+
+  priv->image = g_object_new (GTK_TYPE_IMAGE,
+                              "accessible-role", GTK_ACCESSIBLE_ROLE_PRESENTATION,
+                              "valign", GTK_ALIGN_CENTER,
+                              "visible", FALSE,
+                              NULL);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->image), "icon");
+  gtk_box_append (GTK_BOX (priv->header), GTK_WIDGET (priv->image));
+
+  priv->title_box = create_box (GTK_ORIENTATION_VERTICAL, "title");
+  gtk_widget_set_valign (GTK_WIDGET (priv->title_box), GTK_ALIGN_CENTER);
+  gtk_widget_set_hexpand (GTK_WIDGET (priv->title_box), TRUE);
+  gtk_box_append (GTK_BOX (priv->header), GTK_WIDGET (priv->title_box));
+
+  priv->title = create_label ("title");
+  gtk_label_set_mnemonic_widget (priv->title, GTK_WIDGET (self));
+  gtk_box_append (priv->title_box, GTK_WIDGET (priv->title));
+
+  priv->subtitle = create_label ("subtitle");
+  gtk_box_append (priv->title_box, GTK_WIDGET (priv->subtitle));
+
+  priv->suffixes = create_box (GTK_ORIENTATION_HORIZONTAL, "suffixes");
+  gtk_widget_set_visible (GTK_WIDGET (priv->suffixes), FALSE);
+  gtk_box_append (GTK_BOX (priv->header), GTK_WIDGET (priv->suffixes));
+
+  gtk_accessible_update_relation (GTK_ACCESSIBLE (self),
+                                  GTK_ACCESSIBLE_RELATION_LABELLED_BY, priv->title, NULL,
+                                  GTK_ACCESSIBLE_RELATION_DESCRIBED_BY, priv->subtitle, NULL,
+                                  -1);
+
+  gesture = GTK_EVENT_CONTROLLER (gtk_gesture_click_new ());
+  g_signal_connect_swapped (gesture, "pressed", G_CALLBACK (pressed_cb), self);
+  gtk_widget_add_controller (GTK_WIDGET (self), gesture);
+
+  update_title (self);
+  gtk_label_set_use_underline (priv->title,
+                               adw_preferences_row_get_use_underline (ADW_PREFERENCES_ROW (self)));
+  gtk_label_set_selectable (priv->title,
+                            adw_preferences_row_get_title_selectable (ADW_PREFERENCES_ROW (self)));
+  gtk_label_set_use_markup (priv->title,
+                            adw_preferences_row_get_use_markup (ADW_PREFERENCES_ROW (self)));
+  gtk_label_set_use_markup (priv->subtitle,
+                            adw_preferences_row_get_use_markup (ADW_PREFERENCES_ROW (self)));
+
+  g_signal_connect (self, "notify", G_CALLBACK (notify_cb), NULL);
 }
 
 static void
@@ -603,6 +709,7 @@ adw_action_row_set_subtitle (AdwActionRow *self,
     return;
 
   gtk_label_set_label (priv->subtitle, subtitle ? subtitle : "");
+  gtk_widget_set_visible (GTK_WIDGET (priv->subtitle), string_is_not_empty (subtitle));
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SUBTITLE]);
 }
@@ -654,6 +761,7 @@ adw_action_row_set_icon_name (AdwActionRow *self,
     return;
 
   gtk_image_set_from_icon_name (priv->image, icon_name);
+  gtk_widget_set_visible (GTK_WIDGET (priv->image), string_is_not_empty (icon_name));
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ICON_NAME]);
 }
@@ -894,6 +1002,8 @@ adw_action_row_set_subtitle_selectable (AdwActionRow *self,
 
   priv->subtitle_selectable = subtitle_selectable;
 
+  gtk_label_set_selectable (priv->subtitle, subtitle_selectable);
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SUBTITLE_SELECTABLE]);
 }
 
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+  ADW_ADAPTIVE_CONTEXT_NAVIGATION_PAGE,
+  ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR,
+  ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_CONTENT,
+  ADW_ADAPTIVE_CONTEXT_DIALOG,
+  ADW_ADAPTIVE_CONTEXT_DIALOG_HOST,
+  ADW_ADAPTIVE_CONTEXT_SHEET,
+  ADW_ADAPTIVE_CONTEXT_ADAPTIVE_PREVIEW,
+} AdwAdaptiveContextKind;
+
+#define ADW_TYPE_ADAPTIVE_CONTEXT (adw_adaptive_context_get_type())
+
+G_DECLARE_FINAL_TYPE (AdwAdaptiveContext, adw_adaptive_context, ADW, ADAPTIVE_CONTEXT, GObject)
+
+AdwAdaptiveContext *adw_adaptive_context_new (GtkWidget              *owner,
+                                              AdwAdaptiveContextKind  kind) G_GNUC_WARN_UNUSED_RESULT;
+
+void adw_adaptive_context_attach (AdwAdaptiveContext *self,
+                                  GtkWidget          *anchor);
+
+void adw_adaptive_context_invalidate (AdwAdaptiveContext *self);
+
+AdwAdaptiveContext *adw_adaptive_context_lookup (GtkWidget *widget);
+
+GtkWidget              *adw_adaptive_context_get_owner (AdwAdaptiveContext *self);
+AdwAdaptiveContextKind  adw_adaptive_context_get_kind  (AdwAdaptiveContext *self);
+
+GtkWidget *adw_adaptive_context_get_navigation_page  (AdwAdaptiveContext *self);
+GtkWidget *adw_adaptive_context_get_dialog           (AdwAdaptiveContext *self);
+GtkWidget *adw_adaptive_context_get_dialog_host      (AdwAdaptiveContext *self);
+GtkWidget *adw_adaptive_context_get_sheet            (AdwAdaptiveContext *self);
+GtkWidget *adw_adaptive_context_get_adaptive_preview (AdwAdaptiveContext *self);
+
+GSList *adw_adaptive_context_get_split_views (AdwAdaptiveContext *self);
+
+G_END_DECLS
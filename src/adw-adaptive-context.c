@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-adaptive-context-private.h"
+
+#include "adw-marshalers.h"
+
+/*
+ * AdwAdaptiveContext:
+ *
+ * Describes the surroundings of a widget for the purposes of adaptive
+ * widgets such as `AdwHeaderBar`.
+ *
+ * Navigation pages, split views, dialogs, dialog hosts, sheets and the
+ * adaptive preview each own a context and attach it to the widget that
+ * contains their children with adw_adaptive_context_attach(). Widgets inside
+ * can then use adw_adaptive_context_lookup() to find the nearest context
+ * instead of walking up the tree looking for each ancestor type separately.
+ *
+ * Each context resolves its parent context lazily and caches the result, so
+ * the walk between two contexts only happens once no matter how many widgets
+ * query them. The owner must call adw_adaptive_context_invalidate() when
+ * it's unrooted, as the cached data is only valid while the tree above it
+ * stays the same.
+ *
+ * The ::changed signal is emitted when a split view changes its collapsed
+ * state, sidebar position or sidebar visibility, or when the adaptive preview
+ * toggles window controls, and is propagated to every context inside.
+ */
+
+struct _AdwAdaptiveContext
+{
+  GObject parent_instance;
+
+  GtkWidget *owner;
+  AdwAdaptiveContextKind kind;
+
+  gboolean resolved;
+  AdwAdaptiveContext *parent;
+  gulong parent_changed_id;
+
+  GtkWidget *navigation_page;
+  GtkWidget *dialog;
+  GtkWidget *dialog_host;
+  GtkWidget *sheet;
+  GtkWidget *adaptive_preview;
+  GSList *split_views;
+};
+
+G_DEFINE_FINAL_TYPE (AdwAdaptiveContext, adw_adaptive_context, G_TYPE_OBJECT)
+
+enum {
+  SIGNAL_CHANGED,
+  SIGNAL_LAST_SIGNAL,
+};
+
+static guint signals[SIGNAL_LAST_SIGNAL];
+
+static GQuark
+get_context_quark (void)
+{
+  static GQuark quark = 0;
+
+  if (G_UNLIKELY (quark == 0))
+    quark = g_quark_from_static_string ("adw-adaptive-context");
+
+  return quark;
+}
+
+static void
+emit_changed (AdwAdaptiveContext *self)
+{
+  g_signal_emit (self, signals[SIGNAL_CHANGED], 0);
+}
+
+static void
+owner_notify_cb (AdwAdaptiveContext *self,
+                 GParamSpec         *pspec)
+{
+  const char *name = g_param_spec_get_name (pspec);
+
+  if (self->kind == ADW_ADAPTIVE_CONTEXT_ADAPTIVE_PREVIEW) {
+    if (!g_strcmp0 (name, "window-controls"))
+      emit_changed (self);
+
+    return;
+  }
+
+  if (!g_strcmp0 (name, "collapsed") ||
+      !g_strcmp0 (name, "sidebar-position") ||
+      !g_strcmp0 (name, "show-sidebar"))
+    emit_changed (self);
+}
+
+static inline gboolean
+is_split_view (AdwAdaptiveContext *self)
+{
+  return self->kind == ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR ||
+         self->kind == ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_CONTENT;
+}
+
+static void
+ensure_resolved (AdwAdaptiveContext *self)
+{
+  AdwAdaptiveContext *parent = NULL;
+  GtkWidget *parent_widget;
+
+  if (self->resolved)
+    return;
+
+  self->resolved = TRUE;
+
+  parent_widget = gtk_widget_get_parent (self->owner);
+
+  if (parent_widget && !GTK_IS_NATIVE (self->owner))
+    parent = adw_adaptive_context_lookup (parent_widget);
+
+  if (parent) {
+    ensure_resolved (parent);
+
+    self->parent = g_object_ref (parent);
+    self->navigation_page = parent->navigation_page;
+    self->dialog = parent->dialog;
+    self->dialog_host = parent->dialog_host;
+    self->sheet = parent->sheet;
+    self->adaptive_preview = parent->adaptive_preview;
+    self->split_views = g_slist_copy (parent->split_views);
+  }
+
+  switch (self->kind) {
+  case ADW_ADAPTIVE_CONTEXT_NAVIGATION_PAGE:
+    self->navigation_page = self->owner;
+    break;
+  case ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR:
+  case ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_CONTENT:
+    self->split_views = g_slist_prepend (self->split_views, self);
+    break;
+  case ADW_ADAPTIVE_CONTEXT_DIALOG:
+    self->dialog = self->owner;
+    break;
+  case ADW_ADAPTIVE_CONTEXT_DIALOG_HOST:
+    self->dialog_host = self->owner;
+    break;
+  case ADW_ADAPTIVE_CONTEXT_SHEET:
+    /* Pages, split views and the adaptive preview outside the sheet don't
+     * affect its contents */
+    self->sheet = self->owner;
+    self->navigation_page = NULL;
+    self->adaptive_preview = NULL;
+    g_clear_pointer (&self->split_views, g_slist_free);
+    break;
+  case ADW_ADAPTIVE_CONTEXT_ADAPTIVE_PREVIEW:
+    self->adaptive_preview = self->owner;
+    g_clear_pointer (&self->split_views, g_slist_free);
+    break;
+  default:
+    g_assert_not_reached ();
+  }
+
+  if (self->parent &&
+      self->kind != ADW_ADAPTIVE_CONTEXT_SHEET &&
+      self->kind != ADW_ADAPTIVE_CONTEXT_ADAPTIVE_PREVIEW) {
+    self->parent_changed_id =
+      g_signal_connect_swapped (self->parent, "changed",
+                                G_CALLBACK (emit_changed), self);
+  }
+}
+
+static void
+adw_adaptive_context_dispose (GObject *object)
+{
+  AdwAdaptiveContext *self = ADW_ADAPTIVE_CONTEXT (object);
+
+  adw_adaptive_context_invalidate (self);
+
+  G_OBJECT_CLASS (adw_adaptive_context_parent_class)->dispose (object);
+}
+
+static void
+adw_adaptive_context_class_init (AdwAdaptiveContextClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = adw_adaptive_context_dispose;
+
+  signals[SIGNAL_CHANGED] =
+    g_signal_new ("changed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__VOID,
+                  G_TYPE_NONE,
+                  0);
+  g_signal_set_va_marshaller (signals[SIGNAL_CHANGED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__VOIDv);
+}
+
+static void
+adw_adaptive_context_init (AdwAdaptiveContext *self)
+{
+}
+
+AdwAdaptiveContext *
+adw_adaptive_context_new (GtkWidget              *owner,
+                          AdwAdaptiveContextKind  kind)
+{
+  AdwAdaptiveContext *self;
+
+  g_return_val_if_fail (GTK_IS_WIDGET (owner), NULL);
+
+  self = g_object_new (ADW_TYPE_ADAPTIVE_CONTEXT, NULL);
+
+  self->owner = owner;
+  self->kind = kind;
+
+  if (is_split_view (self) || kind == ADW_ADAPTIVE_CONTEXT_ADAPTIVE_PREVIEW)
+    g_signal_connect_object (owner, "notify",
+                             G_CALLBACK (owner_notify_cb), self,
+                             G_CONNECT_SWAPPED);
+
+  return self;
+}
+
+/*
+ * adw_adaptive_context_attach:
+ * @self: an adaptive context
+ * @anchor: the widget containing the children of the owner
+ *
+ * Makes @self the context of @anchor and its descendants.
+ *
+ * @anchor is either the owner itself or an internal widget of it. Split views
+ * use this to give their sidebar and content different contexts.
+ */
+void
+adw_adaptive_context_attach (AdwAdaptiveContext *self,
+                             GtkWidget          *anchor)
+{
+  g_return_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self));
+  g_return_if_fail (GTK_IS_WIDGET (anchor));
+
+  g_object_set_qdata_full (G_OBJECT (anchor), get_context_quark (),
+                           g_object_ref (self), g_object_unref);
+}
+
+/*
+ * adw_adaptive_context_invalidate:
+ * @self: an adaptive context
+ *
+ * Drops the cached data of @self.
+ *
+ * It will be resolved again the next time it's queried.
+ */
+void
+adw_adaptive_context_invalidate (AdwAdaptiveContext *self)
+{
+  g_return_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self));
+
+  if (!self->resolved)
+    return;
+
+  if (self->parent) {
+    g_clear_signal_handler (&self->parent_changed_id, self->parent);
+    g_clear_object (&self->parent);
+  }
+
+  g_clear_pointer (&self->split_views, g_slist_free);
+
+  self->navigation_page = NULL;
+  self->dialog = NULL;
+  self->dialog_host = NULL;
+  self->sheet = NULL;
+  self->adaptive_preview = NULL;
+  self->resolved = FALSE;
+}
+
+/*
+ * adw_adaptive_context_lookup:
+ * @widget: a widget
+ *
+ * Finds the nearest context containing @widget within the same native.
+ *
+ * Returns: (transfer none) (nullable): the context
+ */
+AdwAdaptiveContext *
+adw_adaptive_context_lookup (GtkWidget *widget)
+{
+  g_return_val_if_fail (GTK_IS_WIDGET (widget), NULL);
+
+  while (widget) {
+    AdwAdaptiveContext *context = g_object_get_qdata (G_OBJECT (widget), get_context_quark ());
+
+    if (context)
+      return context;
+
+    if (GTK_IS_NATIVE (widget))
+      return NULL;
+
+    widget = gtk_widget_get_parent (widget);
+  }
+
+  return NULL;
+}
+
+GtkWidget *
+adw_adaptive_context_get_owner (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  return self->owner;
+}
+
+AdwAdaptiveContextKind
+adw_adaptive_context_get_kind (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), ADW_ADAPTIVE_CONTEXT_NAVIGATION_PAGE);
+
+  return self->kind;
+}
+
+GtkWidget *
+adw_adaptive_context_get_navigation_page (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  ensure_resolved (self);
+
+  return self->navigation_page;
+}
+
+GtkWidget *
+adw_adaptive_context_get_dialog (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  ensure_resolved (self);
+
+  return self->dialog;
+}
+
+GtkWidget *
+adw_adaptive_context_get_dialog_host (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  ensure_resolved (self);
+
+  return self->dialog_host;
+}
+
+GtkWidget *
+adw_adaptive_context_get_sheet (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  ensure_resolved (self);
+
+  return self->sheet;
+}
+
+GtkWidget *
+adw_adaptive_context_get_adaptive_preview (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  ensure_resolved (self);
+
+  return self->adaptive_preview;
+}
+
+/*
+ * adw_adaptive_context_get_split_views:
+ * @self: an adaptive context
+ *
+ * Gets the split view contexts containing @self, from the innermost to the
+ * outermost, up to the nearest sheet or adaptive preview.
+ *
+ * Use adw_adaptive_context_get_kind() to tell whether the widget is in the
+ * sidebar or the content of each split view.
+ *
+ * Returns: (transfer none) (element-type AdwAdaptiveContext): the split views
+ */
+GSList *
+adw_adaptive_context_get_split_views (AdwAdaptiveContext *self)
+{
+  g_return_val_if_fail (ADW_IS_ADAPTIVE_CONTEXT (self), NULL);
+
+  ensure_resolved (self);
+
+  return self->split_views;
+}
@@ -12,6 +12,7 @@
 #include "adw-adaptive-preview-private.h"
 #include "adw-adaptive-preview-presets-private.h"
 
+#include "adw-adaptive-context-private.h"
 #include "adw-animation.h"
 #include "adw-animation-util.h"
 #include "adw-bin.h"
@@ -77,6 +78,8 @@ struct _AdwAdaptivePreview
 
   gboolean highlight_bezel;
 
+  AdwAdaptiveContext *adaptive_context;
+
   gboolean changing_screen_size;
   gboolean changing_shell;
 
@@ -702,6 +705,16 @@ allocate_scale_bin (GtkWidget *widget,
   gtk_widget_allocate (child, child_width, child_height, -1, transform);
 }
 
+static void
+adw_adaptive_preview_unroot (GtkWidget *widget)
+{
+  AdwAdaptivePreview *self = ADW_ADAPTIVE_PREVIEW (widget);
+
+  adw_adaptive_context_invalidate (self->adaptive_context);
+
+  GTK_WIDGET_CLASS (adw_adaptive_preview_parent_class)->unroot (widget);
+}
+
 static void
 adw_adaptive_preview_dispose (GObject *object)
 {
@@ -709,6 +722,7 @@ adw_adaptive_preview_dispose (GObject *object)
 
   gtk_widget_dispose_template (GTK_WIDGET (self), ADW_TYPE_ADAPTIVE_PREVIEW);
 
+  g_clear_object (&self->adaptive_context);
   g_clear_object (&self->rotate_animation);
   g_clear_object (&self->device_paintable);
   g_clear_pointer (&self->screen_path, gsk_path_unref);
@@ -778,6 +792,7 @@ adw_adaptive_preview_class_init (AdwAdaptivePreviewClass *klass)
   object_class->get_property = adw_adaptive_preview_get_property;
   object_class->set_property = adw_adaptive_preview_set_property;
 
+  widget_class->unroot = adw_adaptive_preview_unroot;
   widget_class->compute_expand = adw_widget_compute_expand;
 
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
@@ -881,6 +896,10 @@ adw_adaptive_preview_init (AdwAdaptivePreview *self)
 
   adw_gizmo_set_snapshot_func (ADW_GIZMO (self->screen_view), snapshot_screen_view);
 
+  self->adaptive_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_ADAPTIVE_PREVIEW);
+  adw_adaptive_context_attach (self->adaptive_context, self->screen_view);
+
   setup_presets (self);
 
   gtk_adjustment_set_value (self->width_adj, 360);
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+  ADW_ALLOC_COUNTER_WRAP_LAYOUT,
+  ADW_ALLOC_COUNTER_SNAP_POINTS,
+  ADW_ALLOC_COUNTER_AVATAR_COLOR,
+  ADW_ALLOC_COUNTER_STYLE_CSS,
+  ADW_N_ALLOC_COUNTERS,
+} AdwAllocCounter;
+
+typedef struct {
+  guint last_frame;
+  guint peak;
+  guint64 total;
+} AdwAllocCounterStats;
+
+void     adw_alloc_counters_set_enabled (gboolean enabled);
+gboolean adw_alloc_counters_get_enabled (void);
+
+void adw_alloc_counters_add (AdwAllocCounter counter,
+                             guint           n_allocations);
+
+void adw_alloc_counters_end_frame (void);
+
+void adw_alloc_counters_get_stats (AdwAllocCounter       counter,
+                                   AdwAllocCounterStats *stats);
+
+guint adw_alloc_counters_get_n_frames      (void);
+guint adw_alloc_counters_get_n_clean_frames (void);
+
+const char *adw_alloc_counters_get_name (AdwAllocCounter counter);
+
+void adw_alloc_counters_reset (void);
+
+G_END_DECLS
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+#include <glib/gi18n-lib.h>
+
+#include "adw-alloc-counters-private.h"
+
+#include <string.h>
+
+/*
+ * The allocation counters count the temporary allocations made in a few hot
+ * paths of layout, snapshot and styling code, to check that steady-state
+ * frames don't allocate.
+ *
+ * They are enabled with ADW_DEBUG_ALLOC_COUNTERS=1 and are shown in the
+ * inspector page, which also ends a frame each time the inspected window is
+ * painted. They count the allocating calls made in each path rather than
+ * individual malloc() calls or bytes.
+ *
+ * The counters are global, so allocations made while painting other windows,
+ * including the inspector itself, are attributed to the current frame as well.
+ */
+
+typedef struct {
+  guint current_frame;
+  AdwAllocCounterStats stats;
+} Counter;
+
+static gboolean enabled = FALSE;
+static Counter counters[ADW_N_ALLOC_COUNTERS];
+static guint n_frames = 0;
+static guint n_clean_frames = 0;
+
+void
+adw_alloc_counters_set_enabled (gboolean is_enabled)
+{
+  enabled = !!is_enabled;
+}
+
+gboolean
+adw_alloc_counters_get_enabled (void)
+{
+  return enabled;
+}
+
+/*
+ * adw_alloc_counters_add:
+ * @counter: the counter to increase
+ * @n_allocations: the number of allocations
+ *
+ * Attributes @n_allocations allocations to @counter in the current frame.
+ *
+ * Does nothing unless the counters are enabled.
+ */
+void
+adw_alloc_counters_add (AdwAllocCounter counter,
+                        guint           n_allocations)
+{
+  if (G_LIKELY (!enabled))
+    return;
+
+  g_return_if_fail (counter < ADW_N_ALLOC_COUNTERS);
+
+  counters[counter].current_frame += n_allocations;
+  counters[counter].stats.total += n_allocations;
+}
+
+/*
+ * adw_alloc_counters_end_frame:
+ *
+ * Finishes the current frame, making its counts available as the last frame.
+ */
+void
+adw_alloc_counters_end_frame (void)
+{
+  gboolean clean = TRUE;
+  guint i;
+
+  if (!enabled)
+    return;
+
+  for (i = 0; i < ADW_N_ALLOC_COUNTERS; i++) {
+    Counter *counter = &counters[i];
+
+    if (counter->current_frame > 0)
+      clean = FALSE;
+
+    counter->stats.last_frame = counter->current_frame;
+    counter->stats.peak = MAX (counter->stats.peak, counter->current_frame);
+    counter->current_frame = 0;
+  }
+
+  n_frames++;
+
+  if (clean)
+    n_clean_frames++;
+}
+
+void
+adw_alloc_counters_get_stats (AdwAllocCounter       counter,
+                              AdwAllocCounterStats *stats)
+{
+  g_return_if_fail (counter < ADW_N_ALLOC_COUNTERS);
+  g_return_if_fail (stats != NULL);
+
+  *stats = counters[counter].stats;
+}
+
+guint
+adw_alloc_counters_get_n_frames (void)
+{
+  return n_frames;
+}
+
+/*
+ * adw_alloc_counters_get_n_clean_frames:
+ *
+ * Gets the number of frames in which none of the counters increased.
+ *
+ * Returns: the number of allocation-free frames
+ */
+guint
+adw_alloc_counters_get_n_clean_frames (void)
+{
+  return n_clean_frames;
+}
+
+const char *
+adw_alloc_counters_get_name (AdwAllocCounter counter)
+{
+  switch (counter) {
+  case ADW_ALLOC_COUNTER_WRAP_LAYOUT:
+    /* Translators: name of an allocation counter in inspector */
+    return _("Wrap Layout Sizes");
+  case ADW_ALLOC_COUNTER_SNAP_POINTS:
+    /* Translators: name of an allocation counter in inspector */
+    return _("Swipe Snap Points");
+  case ADW_ALLOC_COUNTER_AVATAR_COLOR:
+    /* Translators: name of an allocation counter in inspector */
+    return _("Avatar Color Classes");
+  case ADW_ALLOC_COUNTER_STYLE_CSS:
+    /* Translators: name of an allocation counter in inspector */
+    return _("Style Manager CSS");
+  case ADW_N_ALLOC_COUNTERS:
+  default:
+    g_assert_not_reached ();
+  }
+}
+
+/*
+ * adw_alloc_counters_reset:
+ *
+ * Resets all counters and frame counts to zero.
+ */
+void
+adw_alloc_counters_reset (void)
+{
+  memset (counters, 0, sizeof (counters));
+  n_frames = 0;
+  n_clean_frames = 0;
+}
@@ -33,6 +33,10 @@
  * will set up an `app.shortcuts` action that creates and presents this dialog,
  * as well as a <kbd>Ctrl</kbd><kbd>?</kbd> accelerator for it.
  *
+ * By default the dialog is created from scratch every time it's presented. For
+ * large dialogs, set [property@Application:cache-shortcuts-dialog] to create it
+ * once in advance and present the same dialog every time instead.
+ *
  * ### Stylesheet
  *
  * If there's a resource located at `style.css`, `AdwApplication` will load
@@ -62,10 +66,12 @@
 typedef struct
 {
   GtkStyleProvider *base_style_provider;
-  GtkStyleProvider *dark_style_provider;
-  GtkStyleProvider *hc_style_provider;
-  GtkStyleProvider *hc_dark_style_provider;
+  GtkStyleProvider *legacy_style_provider;
   char *shortcuts_dialog_path;
+
+  gboolean cache_shortcuts_dialog;
+  AdwDialog *shortcuts_dialog;
+  guint preload_shortcuts_dialog_id;
 } AdwApplicationPrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE (AdwApplication, adw_application, GTK_TYPE_APPLICATION)
@@ -73,6 +79,7 @@ G_DEFINE_TYPE_WITH_PRIVATE (AdwApplication, adw_application, GTK_TYPE_APPLICATIO
 enum {
   PROP_0,
   PROP_STYLE_MANAGER,
+  PROP_CACHE_SHORTCUTS_DIALOG,
   LAST_PROP,
 };
 
@@ -108,14 +115,13 @@ disable_shortcuts_action (AdwApplication *self)
   g_simple_action_set_enabled (G_SIMPLE_ACTION (action), FALSE);
 }
 
-static void
-shortcuts_action_cb (AdwApplication *self)
+static AdwDialog *
+create_shortcuts_dialog (AdwApplication *self)
 {
   AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
   GtkBuilder *builder;
   GError *error = NULL;
   GObject *dialog;
-  GtkWindow *window;
 
   builder = gtk_builder_new ();
 
@@ -126,45 +132,103 @@ shortcuts_action_cb (AdwApplication *self)
     disable_shortcuts_action (self);
     g_error_free (error);
     g_object_unref (builder);
-    return;
+    return NULL;
   }
 
   dialog = gtk_builder_get_object (builder, "shortcuts_dialog");
   if (!ADW_IS_DIALOG (dialog)) {
     disable_shortcuts_action (self);
     g_object_unref (builder);
+    return NULL;
+  }
+
+  g_object_ref_sink (dialog);
+  g_object_unref (builder);
+
+  return ADW_DIALOG (dialog);
+}
+
+static void
+preload_shortcuts_dialog_cb (AdwApplication *self)
+{
+  AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
+
+  priv->preload_shortcuts_dialog_id = 0;
+
+  if (!priv->shortcuts_dialog)
+    priv->shortcuts_dialog = create_shortcuts_dialog (self);
+}
+
+static void
+schedule_preload_shortcuts_dialog (AdwApplication *self)
+{
+  AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
+
+  if (!priv->cache_shortcuts_dialog ||
+      !priv->shortcuts_dialog_path ||
+      priv->shortcuts_dialog ||
+      priv->preload_shortcuts_dialog_id)
     return;
+
+  priv->preload_shortcuts_dialog_id =
+    g_idle_add_once ((GSourceOnceFunc) preload_shortcuts_dialog_cb, self);
+}
+
+static void
+shortcuts_action_cb (AdwApplication *self)
+{
+  AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
+  AdwDialog *dialog;
+  GtkWindow *window;
+
+  g_clear_handle_id (&priv->preload_shortcuts_dialog_id, g_source_remove);
+
+  if (priv->shortcuts_dialog) {
+    /* It's already open */
+    if (gtk_widget_get_root (GTK_WIDGET (priv->shortcuts_dialog)))
+      return;
+
+    dialog = g_object_ref (priv->shortcuts_dialog);
+  } else {
+    dialog = create_shortcuts_dialog (self);
+
+    if (!dialog)
+      return;
+
+    if (priv->cache_shortcuts_dialog)
+      priv->shortcuts_dialog = g_object_ref (dialog);
   }
 
   window = gtk_application_get_active_window (GTK_APPLICATION (self));
 
-  adw_dialog_present (ADW_DIALOG (dialog), GTK_WIDGET (window));
+  adw_dialog_present (dialog, GTK_WIDGET (window));
 
-  g_object_unref (builder);
+  g_object_unref (dialog);
 }
 
-static inline void
-style_provider_set_enabled (GtkStyleProvider *provider,
-                            gboolean          enabled)
+/* The stylesheets are applied to the default display, so follow its style
+ * manager rather than the default one. It notifies after its own stylesheet
+ * has been updated, so both change together. */
+static AdwStyleManager *
+get_style_manager (void)
 {
-  if (enabled)
-    gtk_style_context_add_provider_for_display (gdk_display_get_default (),
-                                                provider,
-                                                GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-  else
-    gtk_style_context_remove_provider_for_display (gdk_display_get_default (),
-                                                   provider);
+  GdkDisplay *display = gdk_display_get_default ();
+
+  if (display)
+    return adw_style_manager_get_for_display (display);
+
+  return adw_style_manager_get_default ();
 }
 
 static void
 update_css_provider (AdwApplication   *self,
                      GtkStyleProvider *provider)
 {
-  AdwStyleManager *manager = adw_style_manager_get_default ();
+  AdwStyleManager *manager = get_style_manager ();
   GtkSettings *settings = gtk_settings_get_default ();
-  GtkInterfaceColorScheme color_scheme;
-  GtkInterfaceContrast contrast;
-  GtkReducedMotion reduced_motion;
+  GtkInterfaceColorScheme color_scheme, old_color_scheme;
+  GtkInterfaceContrast contrast, old_contrast;
+  GtkReducedMotion reduced_motion, old_reduced_motion;
 
   if (!provider)
     return;
@@ -183,44 +247,38 @@ update_css_provider (AdwApplication   *self,
                 "gtk-interface-reduced-motion", &reduced_motion,
                 NULL);
 
-  g_object_set (provider,
-                "prefers-color-scheme", color_scheme,
-                "prefers-contrast", contrast,
-                "prefers-reduced-motion", reduced_motion,
+  g_object_get (provider,
+                "prefers-color-scheme", &old_color_scheme,
+                "prefers-contrast", &old_contrast,
+                "prefers-reduced-motion", &old_reduced_motion,
                 NULL);
+
+  /* Each of these invalidates the styles of the whole display, so only set
+   * the ones that actually changed */
+  if (color_scheme != old_color_scheme)
+    g_object_set (provider, "prefers-color-scheme", color_scheme, NULL);
+
+  if (contrast != old_contrast)
+    g_object_set (provider, "prefers-contrast", contrast, NULL);
+
+  if (reduced_motion != old_reduced_motion)
+    g_object_set (provider, "prefers-reduced-motion", reduced_motion, NULL);
 }
 
 static void
 update_stylesheet (AdwApplication *self)
 {
   AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
-  AdwStyleManager *manager = adw_style_manager_get_default ();
-  gboolean is_dark, is_hc;
-
-  is_dark = adw_style_manager_get_dark (manager);
-  is_hc = adw_style_manager_get_high_contrast (manager);
-
-  if (priv->dark_style_provider)
-    style_provider_set_enabled (priv->dark_style_provider, is_dark);
-
-  if (priv->hc_style_provider)
-    style_provider_set_enabled (priv->hc_style_provider, is_hc);
-
-  if (priv->hc_dark_style_provider)
-    style_provider_set_enabled (priv->hc_dark_style_provider, is_hc && is_dark);
 
   update_css_provider (self, priv->base_style_provider);
-  update_css_provider (self, priv->dark_style_provider);
-  update_css_provider (self, priv->hc_style_provider);
-  update_css_provider (self, priv->hc_dark_style_provider);
+  update_css_provider (self, priv->legacy_style_provider);
 }
 
 static void
 init_provider_from_file (AdwApplication    *self,
                          GtkStyleProvider **provider,
                          GFile             *base_file,
-                         const char        *name,
-                         gboolean           deprecated)
+                         const char        *name)
 {
   GFile *file = g_file_get_child (base_file, name);
 
@@ -235,13 +293,257 @@ init_provider_from_file (AdwApplication    *self,
 
   gtk_css_provider_load_from_file (GTK_CSS_PROVIDER (*provider), file);
 
-    if (deprecated) {
-    g_warning ("The resource %s is deprecated and shouldn't be used anymore. "
-               "Use style.css with media queries instead.",
-               name);
+  g_object_unref (file);
+}
+
+#define MAX_IMPORT_DEPTH 8
+
+static void append_resolved_css (GString    *css,
+                                 GFile      *file,
+                                 const char *contents,
+                                 int         depth);
+
+static gboolean
+is_ident_char (char c)
+{
+  return g_ascii_isalnum (c) || c == '-' || c == '_';
+}
+
+static const char *
+skip_string (const char *p)
+{
+  char quote = *p++;
+
+  while (*p && *p != quote) {
+    if (*p == '\\' && p[1])
+      p++;
+
+    p++;
+  }
+
+  return *p ? p + 1 : p;
+}
+
+/* Parses the argument of url() or a quoted string, returning the position
+ * after it. Returns NULL if it can't be parsed */
+static const char *
+parse_url (const char  *p,
+           char       **url)
+{
+  const char *start, *end;
+
+  while (g_ascii_isspace (*p))
+    p++;
+
+  if (g_ascii_strncasecmp (p, "url(", 4) == 0) {
+    p += 4;
+
+    while (g_ascii_isspace (*p))
+      p++;
+
+    if (*p == '"' || *p == '\'') {
+      start = p + 1;
+      p = skip_string (p);
+      end = p - 1;
+    } else {
+      start = p;
+
+      while (*p && *p != ')' && !g_ascii_isspace (*p))
+        p++;
+
+      end = p;
+    }
+
+    while (g_ascii_isspace (*p))
+      p++;
+
+    if (*p != ')')
+      return NULL;
+
+    p++;
+  } else if (*p == '"' || *p == '\'') {
+    start = p + 1;
+    p = skip_string (p);
+    end = p - 1;
+  } else {
+    return NULL;
+  }
+
+  if (end < start || memchr (start, '\\', end - start))
+    return NULL;
+
+  *url = g_strndup (start, end - start);
+
+  return p;
+}
+
+static GFile *
+resolve_url (GFile      *file,
+             const char *url)
+{
+  char *scheme = g_uri_parse_scheme (url);
+  GFile *parent, *resolved;
+
+  if (scheme) {
+    g_free (scheme);
+    return g_file_new_for_uri (url);
+  }
+
+  parent = g_file_get_parent (file);
+  resolved = g_file_resolve_relative_path (parent, url);
+  g_object_unref (parent);
+
+  return resolved;
+}
+
+static void
+append_import (GString    *css,
+               GFile      *file,
+               const char *url,
+               int         depth)
+{
+  GFile *import_file = resolve_url (file, url);
+  GError *error = NULL;
+  char *contents;
+
+  if (depth >= MAX_IMPORT_DEPTH) {
+    g_critical ("Too many nested imports in %s", url);
+  } else if (!g_file_load_contents (import_file, NULL, &contents, NULL, NULL, &error)) {
+    g_critical ("Failed to import %s: %s", url, error->message);
+    g_error_free (error);
+  } else {
+    append_resolved_css (css, import_file, contents, depth + 1);
+    g_free (contents);
+  }
+
+  g_object_unref (import_file);
+}
+
+/* A stylesheet loaded from a string has no location, so relative URLs in it
+ * can't be resolved. Make them absolute against the file they come from, and
+ * inline imports, which aren't allowed within @media anyway */
+static void
+append_resolved_css (GString    *css,
+                     GFile      *file,
+                     const char *contents,
+                     int         depth)
+{
+  const char *p = contents;
+
+  while (*p) {
+    const char *next;
+    char *url = NULL;
+
+    if (p[0] == '/' && p[1] == '*') {
+      const char *end = strstr (p + 2, "*/");
+
+      next = end ? end + 2 : p + strlen (p);
+      g_string_append_len (css, p, next - p);
+      p = next;
+      continue;
+    }
+
+    if (*p == '"' || *p == '\'') {
+      next = skip_string (p);
+      g_string_append_len (css, p, next - p);
+      p = next;
+      continue;
+    }
+
+    if (p > contents && is_ident_char (p[-1])) {
+      g_string_append_c (css, *p++);
+      continue;
+    }
+
+    if (g_ascii_strncasecmp (p, "@import", 7) == 0 &&
+        (next = parse_url (p + 7, &url))) {
+      append_import (css, file, url, depth);
+      g_free (url);
+
+      next = strchr (next, ';');
+      p = next ? next + 1 : p + strlen (p);
+      continue;
+    }
+
+    if (g_ascii_strncasecmp (p, "url(", 4) == 0 &&
+        (next = parse_url (p, &url))) {
+      GFile *resolved = resolve_url (file, url);
+      char *uri = g_file_get_uri (resolved);
+
+      g_string_append_printf (css, "url(\"%s\")", uri);
+
+      g_free (uri);
+      g_object_unref (resolved);
+      g_free (url);
+      p = next;
+      continue;
+    }
+
+    g_string_append_c (css, *p++);
+  }
+}
+
+static gboolean
+append_legacy_stylesheet (GString    *css,
+                          GFile      *base_file,
+                          const char *name,
+                          const char *media_query)
+{
+  GFile *file = g_file_get_child (base_file, name);
+  GError *error = NULL;
+  char *contents;
+
+  if (!g_file_load_contents (file, NULL, &contents, NULL, NULL, &error)) {
+    if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND))
+      g_critical ("Failed to load %s: %s", name, error->message);
+
+    g_error_free (error);
+    g_object_unref (file);
+    return FALSE;
   }
 
+  g_warning ("The resource %s is deprecated and shouldn't be used anymore. "
+             "Use style.css with media queries instead.",
+             name);
+
+  g_string_append_printf (css, "@media %s {\n", media_query);
+  append_resolved_css (css, file, contents, 0);
+  g_string_append (css, "\n}\n");
+
+  g_free (contents);
   g_object_unref (file);
+
+  return TRUE;
+}
+
+/* The deprecated variant stylesheets are combined into a single provider
+ * wrapping each of them into the corresponding media query, so that switching
+ * between them doesn't need adding and removing providers */
+static void
+init_legacy_provider (AdwApplication *self,
+                      GFile          *base_file)
+{
+  AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
+  GString *css = g_string_new (NULL);
+  gboolean found = FALSE;
+
+  found |= append_legacy_stylesheet (css, base_file, "style-dark.css",
+                                     "(prefers-color-scheme: dark)");
+  found |= append_legacy_stylesheet (css, base_file, "style-hc.css",
+                                     "(prefers-contrast: more)");
+  found |= append_legacy_stylesheet (css, base_file, "style-hc-dark.css",
+                                     "(prefers-color-scheme: dark) and (prefers-contrast: more)");
+
+  if (found) {
+    priv->legacy_style_provider = GTK_STYLE_PROVIDER (gtk_css_provider_new ());
+
+    update_css_provider (self, priv->legacy_style_provider);
+
+    gtk_css_provider_load_from_string (GTK_CSS_PROVIDER (priv->legacy_style_provider),
+                                       css->str);
+  }
+
+  g_string_free (css, TRUE);
 }
 
 static void
@@ -254,12 +556,8 @@ init_providers (AdwApplication *self)
     return;
 
   if (!adw_is_granite_present ()) {
-    init_provider_from_file (self, &priv->base_style_provider,    base_file, "style.css",         FALSE);
-    init_provider_from_file (self, &priv->dark_style_provider,    base_file, "style-dark.css",    TRUE);
-    init_provider_from_file (self, &priv->hc_style_provider,      base_file, "style-hc.css",      TRUE);
-    init_provider_from_file (self, &priv->hc_dark_style_provider, base_file, "style-hc-dark.css", TRUE);
-
-    update_stylesheet (self);
+    init_provider_from_file (self, &priv->base_style_provider, base_file, "style.css");
+    init_legacy_provider (self, base_file);
   }
 
   g_object_unref (base_file);
@@ -280,15 +578,20 @@ init_styling (AdwApplication *self)
                                                 priv->base_style_provider,
                                                 GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
 
-  /* If gdk_display_get_default() worked, it means that
-   * gtk_settings adw_style_manager_get_default() won't return NULL, so we don't
-   * need to check it separately */
-  g_signal_connect_object (adw_style_manager_get_default (),
+  if (priv->legacy_style_provider != NULL)
+    gtk_style_context_add_provider_for_display (display,
+                                                priv->legacy_style_provider,
+                                                GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+
+  /* If gdk_display_get_default() worked, it means that the display has a style
+   * manager and gtk_settings_get_default() won't return NULL, so we don't need
+   * to check them separately */
+  g_signal_connect_object (adw_style_manager_get_for_display (display),
                            "notify::dark",
                            G_CALLBACK (update_stylesheet),
                            self,
                            G_CONNECT_SWAPPED);
-  g_signal_connect_object (adw_style_manager_get_default (),
+  g_signal_connect_object (adw_style_manager_get_for_display (display),
                            "notify::high-contrast",
                            G_CALLBACK (update_stylesheet),
                            self,
@@ -343,6 +646,8 @@ init_shortcuts_dialog (AdwApplication *self)
 
   gtk_application_set_accels_for_action (GTK_APPLICATION (self), "app.shortcuts", accels);
 
+  schedule_preload_shortcuts_dialog (self);
+
   g_free (uri);
   g_object_unref (base_file);
   g_object_unref (ui_file);
@@ -370,9 +675,10 @@ adw_application_dispose (GObject *object)
   AdwApplicationPrivate *priv = adw_application_get_instance_private (self);
 
   g_clear_object (&priv->base_style_provider);
-  g_clear_object (&priv->dark_style_provider);
-  g_clear_object (&priv->hc_style_provider);
-  g_clear_object (&priv->hc_dark_style_provider);
+  g_clear_object (&priv->legacy_style_provider);
+
+  g_clear_handle_id (&priv->preload_shortcuts_dialog_id, g_source_remove);
+  g_clear_object (&priv->shortcuts_dialog);
 
   G_OBJECT_CLASS (adw_application_parent_class)->dispose (object);
 }
@@ -401,6 +707,28 @@ adw_application_get_property (GObject    *object,
     g_value_set_object (value, adw_application_get_style_manager (self));
     break;
 
+  case PROP_CACHE_SHORTCUTS_DIALOG:
+    g_value_set_boolean (value, adw_application_get_cache_shortcuts_dialog (self));
+    break;
+
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  }
+}
+
+static void
+adw_application_set_property (GObject      *object,
+                              guint         prop_id,
+                              const GValue *value,
+                              GParamSpec   *pspec)
+{
+  AdwApplication *self = ADW_APPLICATION (object);
+
+  switch (prop_id) {
+  case PROP_CACHE_SHORTCUTS_DIALOG:
+    adw_application_set_cache_shortcuts_dialog (self, g_value_get_boolean (value));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -415,6 +743,7 @@ adw_application_class_init (AdwApplicationClass *klass)
   object_class->dispose = adw_application_dispose;
   object_class->finalize = adw_application_finalize;
   object_class->get_property = adw_application_get_property;
+  object_class->set_property = adw_application_set_property;
 
   application_class->startup = adw_application_startup;
 
@@ -431,6 +760,28 @@ adw_application_class_init (AdwApplicationClass *klass)
                          ADW_TYPE_STYLE_MANAGER,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdwApplication:cache-shortcuts-dialog:
+   *
+   * Whether to keep the shortcuts dialog around between presentations.
+   *
+   * If set to `TRUE`, the dialog defined in `shortcuts-dialog.ui` is created
+   * once, in an idle callback after startup, and the `app.shortcuts` action
+   * presents the same dialog every time. This avoids parsing the UI file each
+   * time the dialog is opened, at the cost of keeping it in memory, and the
+   * dialog keeps its state, such as the search text, after it's closed.
+   *
+   * Accelerators shown in the dialog are still updated when they change.
+   *
+   * If set to `FALSE`, a new dialog is created every time.
+   *
+   * Since: 1.10
+   */
+  props[PROP_CACHE_SHORTCUTS_DIALOG] =
+    g_param_spec_boolean ("cache-shortcuts-dialog", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 }
 
@@ -482,3 +833,71 @@ adw_application_get_style_manager (AdwApplication *self)
 
   return adw_style_manager_get_default ();
 }
+
+/**
+ * adw_application_get_cache_shortcuts_dialog:
+ * @self: an application
+ *
+ * Gets whether to keep the shortcuts dialog around between presentations.
+ *
+ * Returns: whether to cache the shortcuts dialog
+ *
+ * Since: 1.10
+ */
+gboolean
+adw_application_get_cache_shortcuts_dialog (AdwApplication *self)
+{
+  AdwApplicationPrivate *priv;
+
+  g_return_val_if_fail (ADW_IS_APPLICATION (self), FALSE);
+
+  priv = adw_application_get_instance_private (self);
+
+  return priv->cache_shortcuts_dialog;
+}
+
+/**
+ * adw_application_set_cache_shortcuts_dialog:
+ * @self: an application
+ * @cache: whether to cache the shortcuts dialog
+ *
+ * Sets whether to keep the shortcuts dialog around between presentations.
+ *
+ * If set to `TRUE`, the dialog defined in `shortcuts-dialog.ui` is created
+ * once, in an idle callback after startup, and the `app.shortcuts` action
+ * presents the same dialog every time. This avoids parsing the UI file each
+ * time the dialog is opened, at the cost of keeping it in memory, and the
+ * dialog keeps its state, such as the search text, after it's closed.
+ *
+ * Accelerators shown in the dialog are still updated when they change.
+ *
+ * If set to `FALSE`, a new dialog is created every time.
+ *
+ * Since: 1.10
+ */
+void
+adw_application_set_cache_shortcuts_dialog (AdwApplication *self,
+                                            gboolean        cache)
+{
+  AdwApplicationPrivate *priv;
+
+  g_return_if_fail (ADW_IS_APPLICATION (self));
+
+  priv = adw_application_get_instance_private (self);
+
+  cache = !!cache;
+
+  if (priv->cache_shortcuts_dialog == cache)
+    return;
+
+  priv->cache_shortcuts_dialog = cache;
+
+  if (cache) {
+    schedule_preload_shortcuts_dialog (self);
+  } else {
+    g_clear_handle_id (&priv->preload_shortcuts_dialog_id, g_source_remove);
+    g_clear_object (&priv->shortcuts_dialog);
+  }
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CACHE_SHORTCUTS_DIALOG]);
+}
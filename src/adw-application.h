@@ -42,4 +42,10 @@ AdwApplication *adw_application_new (const char        *application_id,
 ADW_AVAILABLE_IN_ALL
 AdwStyleManager *adw_application_get_style_manager (AdwApplication *self);
 
+ADW_AVAILABLE_IN_1_10
+gboolean adw_application_get_cache_shortcuts_dialog (AdwApplication *self);
+ADW_AVAILABLE_IN_1_10
+void     adw_application_set_cache_shortcuts_dialog (AdwApplication *self,
+                                                     gboolean        cache);
+
 G_END_DECLS
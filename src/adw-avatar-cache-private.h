@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_AVATAR_CACHE (adw_avatar_cache_get_type())
+
+G_DECLARE_FINAL_TYPE (AdwAvatarCache, adw_avatar_cache, ADW, AVATAR_CACHE, GObject)
+
+AdwAvatarCache *adw_avatar_cache_get_for_display (GdkDisplay *display);
+
+GskRenderNode *adw_avatar_cache_lookup (AdwAvatarCache *self,
+                                        const char     *text,
+                                        gboolean        show_initials,
+                                        const char     *icon_name,
+                                        GdkPaintable   *custom_image,
+                                        guint           color_class,
+                                        int             size,
+                                        int             scale_factor) G_GNUC_WARN_UNUSED_RESULT;
+
+void  adw_avatar_cache_clear         (AdwAvatarCache *self);
+guint adw_avatar_cache_get_n_entries (AdwAvatarCache *self);
+
+G_END_DECLS
@@ -0,0 +1,601 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-avatar-cache-private.h"
+
+#include "adw-avatar-palette-private.h"
+#include "adw-avatar-private.h"
+#include "adw-gizmo-private.h"
+#include "adw-marshalers.h"
+#include "adw-style-manager.h"
+#include "adw-widget-utils-private.h"
+
+#define MAX_ENTRIES 256
+#define DEFAULT_ICON_NAME "adw-avatar-default-symbolic"
+
+/*
+ * AdwAvatarCache:
+ *
+ * A per-display cache of rendered avatars.
+ *
+ * Each entry is a render node for an avatar with a given content, color, size
+ * and scale factor. Avatars with initials are keyed by the initials rather
+ * than the whole text, so different names with the same initials and color
+ * share an entry.
+ *
+ * Custom images are not cached: an avatar with a custom image is only the
+ * clipped image, so there's nothing to save, and the cache would otherwise
+ * keep the images alive.
+ *
+ * The cache holds at most `MAX_ENTRIES` entries, dropping the least recently
+ * used ones first. It's cleared when the font, icon theme, accent color or
+ * style changes, and the ::changed signal is emitted so that users can redraw.
+ *
+ * Text colors and fonts are taken from a style prototype with the `avatar` CSS
+ * name that is never shown. A second node with a fixed style is used to notice
+ * stylesheet changes that aren't announced otherwise, e.g. from application
+ * CSS. The prototypes have no parent, so they use the style of the default
+ * display. The CSS background can't be drawn without showing the node, so the
+ * gradients are drawn from `adw_avatar_palette`, which is generated from the
+ * list in `_avatar.scss`.
+ */
+
+typedef enum {
+  ENTRY_INITIALS,
+  ENTRY_ICON,
+} EntryType;
+
+typedef struct {
+  EntryType type;
+  const char *name;
+  guint color_class;
+  int size;
+  int scale_factor;
+} EntryKey;
+
+typedef struct {
+  EntryKey key;
+  GskRenderNode *node;
+  GList link;
+} Entry;
+
+struct _AdwAvatarCache
+{
+  GObject parent_instance;
+
+  GdkDisplay *display;
+  GtkWidget *style;
+  GtkWidget *sentinel;
+  GdkRGBA sentinel_color;
+  gboolean style_changed;
+
+  GHashTable *entries;
+  GQueue lru;
+};
+
+G_DEFINE_FINAL_TYPE (AdwAvatarCache, adw_avatar_cache, G_TYPE_OBJECT)
+
+enum {
+  SIGNAL_CHANGED,
+  SIGNAL_LAST_SIGNAL,
+};
+
+static guint signals[SIGNAL_LAST_SIGNAL];
+
+static guint
+entry_key_hash (const EntryKey *key)
+{
+  guint hash = g_str_hash (key->name);
+
+  hash = hash * 31 + key->type;
+  hash = hash * 31 + key->color_class;
+  hash = hash * 31 + key->size;
+  hash = hash * 31 + key->scale_factor;
+
+  return hash;
+}
+
+static gboolean
+entry_key_equal (const EntryKey *a,
+                 const EntryKey *b)
+{
+  return a->type == b->type &&
+         a->color_class == b->color_class &&
+         a->size == b->size &&
+         a->scale_factor == b->scale_factor &&
+         g_str_equal (a->name, b->name);
+}
+
+static void
+entry_free (Entry *entry)
+{
+  g_free ((char *) entry->key.name);
+  g_clear_pointer (&entry->node, gsk_render_node_unref);
+  g_free (entry);
+}
+
+static void
+remove_entry (AdwAvatarCache *self,
+              Entry          *entry)
+{
+  g_queue_unlink (&self->lru, &entry->link);
+  g_hash_table_remove (self->entries, &entry->key);
+}
+
+static void
+style_changed_cb (AdwAvatarCache *self)
+{
+  adw_avatar_cache_clear (self);
+
+  g_signal_emit (self, signals[SIGNAL_CHANGED], 0);
+}
+
+static void
+sentinel_measure (AdwGizmo       *widget,
+                  GtkOrientation  orientation,
+                  int             for_size,
+                  int            *minimum,
+                  int            *natural,
+                  int            *minimum_baseline,
+                  int            *natural_baseline)
+{
+  AdwAvatarCache *self = g_object_get_data (G_OBJECT (widget), "cache");
+
+  /* Only called again after a style change affecting the size, e.g. fonts */
+  self->style_changed = TRUE;
+
+  *minimum = *natural = 0;
+}
+
+static void
+check_style (AdwAvatarCache *self)
+{
+  GdkRGBA color;
+
+  gtk_widget_measure (self->sentinel, GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, NULL, NULL, NULL);
+
+  gtk_widget_get_color (self->sentinel, &color);
+
+  if (!gdk_rgba_equal (&color, &self->sentinel_color)) {
+    self->sentinel_color = color;
+    self->style_changed = TRUE;
+  }
+
+  if (!self->style_changed)
+    return;
+
+  self->style_changed = FALSE;
+
+  if (g_hash_table_size (self->entries) == 0)
+    return;
+
+  style_changed_cb (self);
+}
+
+static void
+update_style (AdwAvatarCache *self,
+              guint           color_class,
+              int             size)
+{
+  const char *classes[3] = { NULL, };
+  char *color = g_strdup_printf ("color%d", color_class);
+  int i = 0;
+
+  classes[i++] = color;
+
+  if (size < 25)
+    classes[i++] = "contrasted";
+
+  gtk_widget_set_css_classes (self->style, classes);
+
+  g_free (color);
+}
+
+static void
+snapshot_custom_image (GtkSnapshot  *snapshot,
+                       GdkPaintable *image,
+                       int           size,
+                       int           scale_factor)
+{
+  int width = gdk_paintable_get_intrinsic_width (image);
+  int height = gdk_paintable_get_intrinsic_height (image);
+  float device_size = size * scale_factor;
+  float scaled_width, scaled_height;
+
+  if (width <= 0 || height <= 0 || width == height) {
+    scaled_width = scaled_height = device_size;
+  } else if (width > height) {
+    scaled_height = device_size;
+    scaled_width = (float) width * scaled_height / (float) height;
+  } else {
+    scaled_width = device_size;
+    scaled_height = (float) height * scaled_width / (float) width;
+  }
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_scale (snapshot, 1.0f / scale_factor, 1.0f / scale_factor);
+  gtk_snapshot_translate (snapshot,
+                          &GRAPHENE_POINT_INIT ((device_size - scaled_width) / 2.f,
+                                                (device_size - scaled_height) / 2.f));
+
+  if (GDK_IS_TEXTURE (image)) {
+    GskScalingFilter filter;
+
+    if (scaled_width > width || scaled_height > height)
+      filter = GSK_SCALING_FILTER_NEAREST;
+    else
+      filter = GSK_SCALING_FILTER_TRILINEAR;
+
+    gtk_snapshot_append_scaled_texture (snapshot,
+                                        GDK_TEXTURE (image),
+                                        filter,
+                                        &GRAPHENE_RECT_INIT (0, 0, scaled_width, scaled_height));
+  } else {
+    gdk_paintable_snapshot (image, snapshot, scaled_width, scaled_height);
+  }
+
+  gtk_snapshot_restore (snapshot);
+}
+
+static void
+snapshot_initials (AdwAvatarCache *self,
+                   GtkSnapshot    *snapshot,
+                   const char     *initials,
+                   int             size)
+{
+  PangoLayout *layout = gtk_widget_create_pango_layout (self->style, initials);
+  PangoAttrList *attributes;
+  GdkRGBA color;
+  int width, height;
+
+  pango_layout_get_pixel_size (layout, &width, &height);
+
+  attributes = pango_attr_list_new ();
+  pango_attr_list_change (attributes,
+                          pango_attr_size_new_absolute (adw_avatar_get_font_size (size, width, height) * PANGO_SCALE));
+  pango_layout_set_attributes (layout, attributes);
+  pango_attr_list_unref (attributes);
+
+  pango_layout_get_pixel_size (layout, &width, &height);
+
+  gtk_widget_get_color (self->style, &color);
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot,
+                          &GRAPHENE_POINT_INIT ((size - width) / 2, (size - height) / 2));
+  gtk_snapshot_append_layout (snapshot, layout, &color);
+  gtk_snapshot_restore (snapshot);
+
+  g_object_unref (layout);
+}
+
+static void
+snapshot_icon (AdwAvatarCache *self,
+               GtkSnapshot    *snapshot,
+               const char     *icon_name,
+               int             size,
+               int             scale_factor)
+{
+  GtkIconTheme *icon_theme = gtk_icon_theme_get_for_display (self->display);
+  GtkIconPaintable *icon;
+  GdkRGBA colors[4];
+  int icon_size = size / 2;
+
+  icon = gtk_icon_theme_lookup_icon (icon_theme,
+                                     icon_name ? icon_name : DEFAULT_ICON_NAME,
+                                     NULL,
+                                     icon_size,
+                                     scale_factor,
+                                     GTK_TEXT_DIR_NONE,
+                                     0);
+
+  gtk_widget_get_color (self->style, &colors[GTK_SYMBOLIC_COLOR_FOREGROUND]);
+  adw_widget_lookup_color (self->style, "error-color", &colors[GTK_SYMBOLIC_COLOR_ERROR]);
+  adw_widget_lookup_color (self->style, "warning-color", &colors[GTK_SYMBOLIC_COLOR_WARNING]);
+  adw_widget_lookup_color (self->style, "success-color", &colors[GTK_SYMBOLIC_COLOR_SUCCESS]);
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot,
+                          &GRAPHENE_POINT_INIT ((size - icon_size) / 2, (size - icon_size) / 2));
+  gtk_symbolic_paintable_snapshot_symbolic (GTK_SYMBOLIC_PAINTABLE (icon),
+                                            snapshot,
+                                            icon_size,
+                                            icon_size,
+                                            colors,
+                                            4);
+  gtk_snapshot_restore (snapshot);
+
+  g_object_unref (icon);
+}
+
+static void
+rgb_to_rgba (guint32  rgb,
+             GdkRGBA *rgba)
+{
+  rgba->red = ((rgb >> 16) & 0xff) / 255.0f;
+  rgba->green = ((rgb >> 8) & 0xff) / 255.0f;
+  rgba->blue = (rgb & 0xff) / 255.0f;
+  rgba->alpha = 1;
+}
+
+static void
+snapshot_background (GtkSnapshot *snapshot,
+                     guint        color_class,
+                     int          size)
+{
+  GskColorStop stops[2];
+
+  g_assert (color_class >= 1 && color_class <= G_N_ELEMENTS (adw_avatar_palette));
+
+  stops[0].offset = 0;
+  rgb_to_rgba (adw_avatar_palette[color_class - 1][0], &stops[0].color);
+  stops[1].offset = 1;
+  rgb_to_rgba (adw_avatar_palette[color_class - 1][1], &stops[1].color);
+
+  gtk_snapshot_append_linear_gradient (snapshot,
+                                       &GRAPHENE_RECT_INIT (0, 0, size, size),
+                                       &GRAPHENE_POINT_INIT (0, 0),
+                                       &GRAPHENE_POINT_INIT (0, size),
+                                       stops,
+                                       G_N_ELEMENTS (stops));
+}
+
+static GskRenderNode *
+render_avatar (AdwAvatarCache *self,
+               const char     *initials,
+               const char     *icon_name,
+               GdkPaintable   *custom_image,
+               guint           color_class,
+               int             size,
+               int             scale_factor)
+{
+  GtkSnapshot *snapshot = gtk_snapshot_new ();
+  GskRoundedRect clip;
+
+  gsk_rounded_rect_init_from_rect (&clip, &GRAPHENE_RECT_INIT (0, 0, size, size), size / 2.0f);
+  gtk_snapshot_push_rounded_clip (snapshot, &clip);
+
+  if (custom_image) {
+    snapshot_custom_image (snapshot, custom_image, size, scale_factor);
+  } else {
+    update_style (self, color_class, size);
+    snapshot_background (snapshot, color_class, size);
+
+    if (initials)
+      snapshot_initials (self, snapshot, initials, size);
+    else
+      snapshot_icon (self, snapshot, icon_name, size, scale_factor);
+  }
+
+  gtk_snapshot_pop (snapshot);
+
+  return gtk_snapshot_free_to_node (snapshot);
+}
+
+static void
+adw_avatar_cache_dispose (GObject *object)
+{
+  AdwAvatarCache *self = ADW_AVATAR_CACHE (object);
+
+  adw_avatar_cache_clear (self);
+
+  g_clear_object (&self->style);
+  g_clear_object (&self->sentinel);
+
+  G_OBJECT_CLASS (adw_avatar_cache_parent_class)->dispose (object);
+}
+
+static void
+adw_avatar_cache_finalize (GObject *object)
+{
+  AdwAvatarCache *self = ADW_AVATAR_CACHE (object);
+
+  g_hash_table_unref (self->entries);
+
+  G_OBJECT_CLASS (adw_avatar_cache_parent_class)->finalize (object);
+}
+
+static void
+adw_avatar_cache_class_init (AdwAvatarCacheClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = adw_avatar_cache_dispose;
+  object_class->finalize = adw_avatar_cache_finalize;
+
+  signals[SIGNAL_CHANGED] =
+    g_signal_new ("changed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__VOID,
+                  G_TYPE_NONE,
+                  0);
+  g_signal_set_va_marshaller (signals[SIGNAL_CHANGED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__VOIDv);
+}
+
+static void
+adw_avatar_cache_init (AdwAvatarCache *self)
+{
+  self->entries = g_hash_table_new_full ((GHashFunc) entry_key_hash,
+                                         (GEqualFunc) entry_key_equal,
+                                         NULL, (GDestroyNotify) entry_free);
+  g_queue_init (&self->lru);
+}
+
+/*
+ * adw_avatar_cache_get_for_display:
+ * @display: a display
+ *
+ * Gets the avatar cache for @display, creating it if needed.
+ *
+ * Returns: (transfer none): the cache
+ */
+AdwAvatarCache *
+adw_avatar_cache_get_for_display (GdkDisplay *display)
+{
+  AdwAvatarCache *self;
+
+  g_return_val_if_fail (GDK_IS_DISPLAY (display), NULL);
+
+  self = g_object_get_data (G_OBJECT (display), "-adw-avatar-cache");
+
+  if (self)
+    return self;
+
+  self = g_object_new (ADW_TYPE_AVATAR_CACHE, NULL);
+  self->display = display;
+
+  self->style = g_object_ref_sink (adw_gizmo_new ("avatar", NULL, NULL, NULL, NULL, NULL, NULL));
+
+  self->sentinel = g_object_ref_sink (adw_gizmo_new ("avatar", sentinel_measure,
+                                                     NULL, NULL, NULL, NULL, NULL));
+  gtk_widget_add_css_class (self->sentinel, "color1");
+  g_object_set_data (G_OBJECT (self->sentinel), "cache", self);
+
+  check_style (self);
+
+  g_object_set_data_full (G_OBJECT (display), "-adw-avatar-cache",
+                          self, g_object_unref);
+
+  g_signal_connect_object (gtk_settings_get_for_display (display),
+                           "notify::gtk-font-name",
+                           G_CALLBACK (style_changed_cb), self,
+                           G_CONNECT_SWAPPED);
+  g_signal_connect_object (gtk_settings_get_for_display (display),
+                           "notify::gtk-xft-dpi",
+                           G_CALLBACK (style_changed_cb), self,
+                           G_CONNECT_SWAPPED);
+  g_signal_connect_object (gtk_icon_theme_get_for_display (display),
+                           "changed",
+                           G_CALLBACK (style_changed_cb), self,
+                           G_CONNECT_SWAPPED);
+  g_signal_connect_object (adw_style_manager_get_for_display (display),
+                           "notify::dark",
+                           G_CALLBACK (style_changed_cb), self,
+                           G_CONNECT_SWAPPED);
+  g_signal_connect_object (adw_style_manager_get_for_display (display),
+                           "notify::high-contrast",
+                           G_CALLBACK (style_changed_cb), self,
+                           G_CONNECT_SWAPPED);
+  g_signal_connect_object (adw_style_manager_get_for_display (display),
+                           "notify::accent-color",
+                           G_CALLBACK (style_changed_cb), self,
+                           G_CONNECT_SWAPPED);
+
+  return self;
+}
+
+/*
+ * adw_avatar_cache_lookup:
+ * @self: an avatar cache
+ * @text: (nullable): the text used for the initials
+ * @show_initials: whether to show initials instead of an icon
+ * @icon_name: (nullable): the fallback icon name
+ * @custom_image: (nullable): the custom image
+ * @color_class: the color, as returned by adw_avatar_get_color_class()
+ * @size: the avatar size
+ * @scale_factor: the scale factor
+ *
+ * Gets the render node for an avatar, rendering it if it's not in the cache.
+ *
+ * Returns: (transfer full) (nullable): the render node
+ */
+GskRenderNode *
+adw_avatar_cache_lookup (AdwAvatarCache *self,
+                         const char     *text,
+                         gboolean        show_initials,
+                         const char     *icon_name,
+                         GdkPaintable   *custom_image,
+                         guint           color_class,
+                         int             size,
+                         int             scale_factor)
+{
+  char *initials = NULL;
+  EntryKey key;
+  Entry *entry;
+
+  g_return_val_if_fail (ADW_IS_AVATAR_CACHE (self), NULL);
+  g_return_val_if_fail (custom_image == NULL || GDK_IS_PAINTABLE (custom_image), NULL);
+  g_return_val_if_fail (size > 0, NULL);
+  g_return_val_if_fail (scale_factor > 0, NULL);
+
+  check_style (self);
+
+  if (custom_image)
+    return render_avatar (self, NULL, NULL, custom_image, color_class, size, scale_factor);
+
+  if (show_initials && text && *text &&
+      (initials = adw_avatar_extract_initials (text))) {
+    key.type = ENTRY_INITIALS;
+    key.name = initials;
+  } else {
+    key.type = ENTRY_ICON;
+    key.name = icon_name ? icon_name : DEFAULT_ICON_NAME;
+  }
+
+  key.color_class = color_class;
+  key.size = size;
+  key.scale_factor = scale_factor;
+
+  entry = g_hash_table_lookup (self->entries, &key);
+
+  if (entry) {
+    g_queue_unlink (&self->lru, &entry->link);
+    g_queue_push_head_link (&self->lru, &entry->link);
+
+    g_free (initials);
+
+    return entry->node ? gsk_render_node_ref (entry->node) : NULL;
+  }
+
+  entry = g_new0 (Entry, 1);
+  entry->key = key;
+  entry->key.name = g_strdup (key.name);
+  entry->node = render_avatar (self, initials, icon_name, NULL,
+                               color_class, size, scale_factor);
+  entry->link.data = entry;
+
+  g_hash_table_insert (self->entries, &entry->key, entry);
+  g_queue_push_head_link (&self->lru, &entry->link);
+
+  while (self->lru.length > MAX_ENTRIES)
+    remove_entry (self, g_queue_peek_tail (&self->lru));
+
+  g_free (initials);
+
+  return entry->node ? gsk_render_node_ref (entry->node) : NULL;
+}
+
+/*
+ * adw_avatar_cache_clear:
+ * @self: an avatar cache
+ *
+ * Drops all entries from @self.
+ */
+void
+adw_avatar_cache_clear (AdwAvatarCache *self)
+{
+  g_return_if_fail (ADW_IS_AVATAR_CACHE (self));
+
+  /* The links are owned by the entries */
+  g_queue_init (&self->lru);
+  g_hash_table_remove_all (self->entries);
+}
+
+guint
+adw_avatar_cache_get_n_entries (AdwAvatarCache *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_CACHE (self), 0);
+
+  return g_hash_table_size (self->entries);
+}
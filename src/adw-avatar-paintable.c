@@ -0,0 +1,705 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-avatar-paintable.h"
+
+#include "adw-avatar-cache-private.h"
+#include "adw-avatar-private.h"
+
+#define DEFAULT_SIZE 32
+
+/**
+ * AdwAvatarPaintable:
+ *
+ * A paintable showing an avatar.
+ *
+ * `AdwAvatarPaintable` looks the same as [class@Avatar], but it's not a
+ * widget. This makes it suitable for list views with many rows, such as
+ * contact lists, where an `AdwAvatar` in each row would be too expensive:
+ *
+ * ```c
+ * static void
+ * setup_cb (GtkSignalListItemFactory *factory,
+ *           GtkListItem              *item)
+ * {
+ *   GtkWidget *image = gtk_image_new ();
+ *   AdwAvatarPaintable *avatar = adw_avatar_paintable_new (32, NULL, TRUE);
+ *
+ *   adw_avatar_paintable_set_widget (avatar, image);
+ *   gtk_image_set_from_paintable (GTK_IMAGE (image), GDK_PAINTABLE (avatar));
+ *   gtk_image_set_pixel_size (GTK_IMAGE (image), 32);
+ *
+ *   gtk_list_item_set_child (item, image);
+ *
+ *   g_object_unref (avatar);
+ * }
+ * ```
+ *
+ * Rendered avatars are shared between all avatar paintables on the same
+ * display, so paintables with the same initials or icon, color and size are
+ * only drawn once.
+ *
+ * [property@AvatarPaintable:widget] is used to get the display and the scale
+ * factor. If it's not set, the default display and the scale factor of 1 are
+ * used.
+ *
+ * Unlike `AdwAvatar`, the paintable doesn't have an accessible label. Set one
+ * on the widget displaying it instead.
+ *
+ * Since: 1.10
+ */
+
+struct _AdwAvatarPaintable
+{
+  GObject parent_instance;
+
+  GtkWidget *widget;
+  AdwAvatarCache *cache;
+  gulong cache_changed_id;
+
+  char *icon_name;
+  char *text;
+  gboolean show_initials;
+  GdkPaintable *custom_image;
+  guint color_class;
+  int size;
+};
+
+static void adw_avatar_paintable_iface_init (GdkPaintableInterface *iface);
+
+G_DEFINE_FINAL_TYPE_WITH_CODE (AdwAvatarPaintable, adw_avatar_paintable, G_TYPE_OBJECT,
+                               G_IMPLEMENT_INTERFACE (GDK_TYPE_PAINTABLE,
+                                                      adw_avatar_paintable_iface_init))
+
+enum {
+  PROP_0,
+  PROP_WIDGET,
+  PROP_ICON_NAME,
+  PROP_TEXT,
+  PROP_SHOW_INITIALS,
+  PROP_CUSTOM_IMAGE,
+  PROP_SIZE,
+  LAST_PROP,
+};
+
+static GParamSpec *props[LAST_PROP];
+
+static void
+invalidate_contents (AdwAvatarPaintable *self)
+{
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+static void
+set_cache (AdwAvatarPaintable *self,
+           AdwAvatarCache     *cache)
+{
+  if (self->cache == cache)
+    return;
+
+  if (self->cache)
+    g_clear_signal_handler (&self->cache_changed_id, self->cache);
+
+  g_set_object (&self->cache, cache);
+
+  if (self->cache)
+    self->cache_changed_id =
+      g_signal_connect_swapped (self->cache, "changed",
+                                G_CALLBACK (invalidate_contents), self);
+}
+
+static void
+widget_notify_cb (AdwAvatarPaintable *self)
+{
+  self->widget = NULL;
+
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_WIDGET]);
+}
+
+static void
+adw_avatar_paintable_snapshot (GdkPaintable *paintable,
+                               GdkSnapshot  *snapshot,
+                               double        width,
+                               double        height)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (paintable);
+  GdkDisplay *display;
+  GskRenderNode *node;
+  int scale_factor;
+
+  if (self->widget) {
+    display = gtk_widget_get_display (self->widget);
+    scale_factor = gtk_widget_get_scale_factor (self->widget);
+  } else {
+    display = gdk_display_get_default ();
+    scale_factor = 1;
+  }
+
+  if (!display)
+    return;
+
+  set_cache (self, adw_avatar_cache_get_for_display (display));
+
+  node = adw_avatar_cache_lookup (self->cache,
+                                  self->text,
+                                  self->show_initials,
+                                  self->icon_name,
+                                  self->custom_image,
+                                  self->color_class,
+                                  self->size,
+                                  scale_factor);
+
+  if (!node)
+    return;
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_scale (snapshot, width / self->size, height / self->size);
+  gtk_snapshot_append_node (snapshot, node);
+  gtk_snapshot_restore (snapshot);
+
+  gsk_render_node_unref (node);
+}
+
+static int
+adw_avatar_paintable_get_intrinsic_width (GdkPaintable *paintable)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (paintable);
+
+  return self->size;
+}
+
+static int
+adw_avatar_paintable_get_intrinsic_height (GdkPaintable *paintable)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (paintable);
+
+  return self->size;
+}
+
+static void
+adw_avatar_paintable_iface_init (GdkPaintableInterface *iface)
+{
+  iface->snapshot = adw_avatar_paintable_snapshot;
+  iface->get_intrinsic_width = adw_avatar_paintable_get_intrinsic_width;
+  iface->get_intrinsic_height = adw_avatar_paintable_get_intrinsic_height;
+}
+
+static void
+adw_avatar_paintable_dispose (GObject *object)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (object);
+
+  adw_avatar_paintable_set_widget (self, NULL);
+  adw_avatar_paintable_set_custom_image (self, NULL);
+  set_cache (self, NULL);
+
+  G_OBJECT_CLASS (adw_avatar_paintable_parent_class)->dispose (object);
+}
+
+static void
+adw_avatar_paintable_finalize (GObject *object)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (object);
+
+  g_free (self->icon_name);
+  g_free (self->text);
+
+  G_OBJECT_CLASS (adw_avatar_paintable_parent_class)->finalize (object);
+}
+
+static void
+adw_avatar_paintable_get_property (GObject    *object,
+                                   guint       prop_id,
+                                   GValue     *value,
+                                   GParamSpec *pspec)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (object);
+
+  switch (prop_id) {
+  case PROP_WIDGET:
+    g_value_set_object (value, adw_avatar_paintable_get_widget (self));
+    break;
+  case PROP_ICON_NAME:
+    g_value_set_string (value, adw_avatar_paintable_get_icon_name (self));
+    break;
+  case PROP_TEXT:
+    g_value_set_string (value, adw_avatar_paintable_get_text (self));
+    break;
+  case PROP_SHOW_INITIALS:
+    g_value_set_boolean (value, adw_avatar_paintable_get_show_initials (self));
+    break;
+  case PROP_CUSTOM_IMAGE:
+    g_value_set_object (value, adw_avatar_paintable_get_custom_image (self));
+    break;
+  case PROP_SIZE:
+    g_value_set_int (value, adw_avatar_paintable_get_size (self));
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  }
+}
+
+static void
+adw_avatar_paintable_set_property (GObject      *object,
+                                   guint         prop_id,
+                                   const GValue *value,
+                                   GParamSpec   *pspec)
+{
+  AdwAvatarPaintable *self = ADW_AVATAR_PAINTABLE (object);
+
+  switch (prop_id) {
+  case PROP_WIDGET:
+    adw_avatar_paintable_set_widget (self, g_value_get_object (value));
+    break;
+  case PROP_ICON_NAME:
+    adw_avatar_paintable_set_icon_name (self, g_value_get_string (value));
+    break;
+  case PROP_TEXT:
+    adw_avatar_paintable_set_text (self, g_value_get_string (value));
+    break;
+  case PROP_SHOW_INITIALS:
+    adw_avatar_paintable_set_show_initials (self, g_value_get_boolean (value));
+    break;
+  case PROP_CUSTOM_IMAGE:
+    adw_avatar_paintable_set_custom_image (self, g_value_get_object (value));
+    break;
+  case PROP_SIZE:
+    adw_avatar_paintable_set_size (self, g_value_get_int (value));
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  }
+}
+
+static void
+adw_avatar_paintable_class_init (AdwAvatarPaintableClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = adw_avatar_paintable_dispose;
+  object_class->finalize = adw_avatar_paintable_finalize;
+  object_class->get_property = adw_avatar_paintable_get_property;
+  object_class->set_property = adw_avatar_paintable_set_property;
+
+  /**
+   * AdwAvatarPaintable:widget:
+   *
+   * The widget used for the display and the scale factor.
+   *
+   * Since: 1.10
+   */
+  props[PROP_WIDGET] =
+    g_param_spec_object ("widget", NULL, NULL,
+                         GTK_TYPE_WIDGET,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAvatarPaintable:icon-name:
+   *
+   * The name of an icon to use as a fallback.
+   *
+   * If no name is set, `adw-avatar-default-symbolic` will be used.
+   *
+   * Since: 1.10
+   */
+  props[PROP_ICON_NAME] =
+    g_param_spec_string ("icon-name", NULL, NULL,
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAvatarPaintable:text:
+   *
+   * The text used to generate the fallback initials and color.
+   *
+   * It's only used to generate the color if
+   * [property@AvatarPaintable:show-initials] is `FALSE`.
+   *
+   * Since: 1.10
+   */
+  props[PROP_TEXT] =
+    g_param_spec_string ("text", NULL, NULL,
+                         "",
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAvatarPaintable:show-initials:
+   *
+   * Whether initials are used instead of an icon on the fallback avatar.
+   *
+   * Since: 1.10
+   */
+  props[PROP_SHOW_INITIALS] =
+    g_param_spec_boolean ("show-initials", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAvatarPaintable:custom-image:
+   *
+   * A custom image paintable.
+   *
+   * Custom image is displayed instead of initials or icon.
+   *
+   * Only textures and paintables with static contents are shared between
+   * avatar paintables, other paintables are drawn every time.
+   *
+   * Since: 1.10
+   */
+  props[PROP_CUSTOM_IMAGE] =
+    g_param_spec_object ("custom-image", NULL, NULL,
+                         GDK_TYPE_PAINTABLE,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwAvatarPaintable:size:
+   *
+   * The size of the avatar.
+   *
+   * This is also the intrinsic size of the paintable.
+   *
+   * Since: 1.10
+   */
+  props[PROP_SIZE] =
+    g_param_spec_int ("size", NULL, NULL,
+                      1, INT_MAX, DEFAULT_SIZE,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  g_object_class_install_properties (object_class, LAST_PROP, props);
+}
+
+static void
+adw_avatar_paintable_init (AdwAvatarPaintable *self)
+{
+  self->text = g_strdup ("");
+  self->size = DEFAULT_SIZE;
+  self->color_class = adw_avatar_get_color_class (self->text);
+}
+
+/**
+ * adw_avatar_paintable_new:
+ * @size: the size of the avatar
+ * @text: (nullable): the text used to get the initials and color
+ * @show_initials: whether to use initials instead of an icon as fallback
+ *
+ * Creates a new `AdwAvatarPaintable`.
+ *
+ * Returns: the newly created `AdwAvatarPaintable`
+ *
+ * Since: 1.10
+ */
+AdwAvatarPaintable *
+adw_avatar_paintable_new (int         size,
+                          const char *text,
+                          gboolean    show_initials)
+{
+  return g_object_new (ADW_TYPE_AVATAR_PAINTABLE,
+                       "size", size,
+                       "text", text,
+                       "show-initials", show_initials,
+                       NULL);
+}
+
+/**
+ * adw_avatar_paintable_get_widget:
+ * @self: an avatar paintable
+ *
+ * Gets the widget used for the display and the scale factor.
+ *
+ * Returns: (transfer none) (nullable): the widget
+ *
+ * Since: 1.10
+ */
+GtkWidget *
+adw_avatar_paintable_get_widget (AdwAvatarPaintable *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_PAINTABLE (self), NULL);
+
+  return self->widget;
+}
+
+/**
+ * adw_avatar_paintable_set_widget:
+ * @self: an avatar paintable
+ * @widget: (nullable): the widget
+ *
+ * Sets the widget used for the display and the scale factor.
+ *
+ * Ideally it should be the widget the paintable is displayed in.
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_paintable_set_widget (AdwAvatarPaintable *self,
+                                 GtkWidget          *widget)
+{
+  g_return_if_fail (ADW_IS_AVATAR_PAINTABLE (self));
+  g_return_if_fail (widget == NULL || GTK_IS_WIDGET (widget));
+
+  if (self->widget == widget)
+    return;
+
+  if (self->widget) {
+    g_signal_handlers_disconnect_by_func (self->widget, invalidate_contents, self);
+
+    g_object_weak_unref (G_OBJECT (self->widget),
+                         (GWeakNotify) widget_notify_cb,
+                         self);
+  }
+
+  self->widget = widget;
+
+  if (self->widget) {
+    g_object_weak_ref (G_OBJECT (self->widget),
+                       (GWeakNotify) widget_notify_cb,
+                       self);
+
+    g_signal_connect_swapped (self->widget, "notify::scale-factor",
+                              G_CALLBACK (invalidate_contents), self);
+  }
+
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_WIDGET]);
+}
+
+/**
+ * adw_avatar_paintable_get_icon_name:
+ * @self: an avatar paintable
+ *
+ * Gets the name of an icon to use as a fallback.
+ *
+ * Returns: (nullable): the icon name
+ *
+ * Since: 1.10
+ */
+const char *
+adw_avatar_paintable_get_icon_name (AdwAvatarPaintable *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_PAINTABLE (self), NULL);
+
+  return self->icon_name;
+}
+
+/**
+ * adw_avatar_paintable_set_icon_name:
+ * @self: an avatar paintable
+ * @icon_name: (nullable): the icon name
+ *
+ * Sets the name of an icon to use as a fallback.
+ *
+ * If no name is set, `adw-avatar-default-symbolic` will be used.
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_paintable_set_icon_name (AdwAvatarPaintable *self,
+                                    const char         *icon_name)
+{
+  g_return_if_fail (ADW_IS_AVATAR_PAINTABLE (self));
+
+  if (!g_set_str (&self->icon_name, icon_name))
+    return;
+
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ICON_NAME]);
+}
+
+/**
+ * adw_avatar_paintable_get_text:
+ * @self: an avatar paintable
+ *
+ * Gets the text used to generate the fallback initials and color.
+ *
+ * Returns: (nullable): the text used to generate the fallback initials and
+ *   color
+ *
+ * Since: 1.10
+ */
+const char *
+adw_avatar_paintable_get_text (AdwAvatarPaintable *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_PAINTABLE (self), NULL);
+
+  return self->text;
+}
+
+/**
+ * adw_avatar_paintable_set_text:
+ * @self: an avatar paintable
+ * @text: (nullable): the text used to get the initials and color
+ *
+ * Sets the text used to generate the fallback initials and color.
+ *
+ * It's only used to generate the color if
+ * [property@AvatarPaintable:show-initials] is `FALSE`.
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_paintable_set_text (AdwAvatarPaintable *self,
+                               const char         *text)
+{
+  g_return_if_fail (ADW_IS_AVATAR_PAINTABLE (self));
+
+  if (!g_set_str (&self->text, text ? text : ""))
+    return;
+
+  self->color_class = adw_avatar_get_color_class (self->text);
+
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_TEXT]);
+}
+
+/**
+ * adw_avatar_paintable_get_show_initials:
+ * @self: an avatar paintable
+ *
+ * Gets whether initials are used instead of an icon on the fallback avatar.
+ *
+ * Returns: whether initials are used instead of an icon as fallback
+ *
+ * Since: 1.10
+ */
+gboolean
+adw_avatar_paintable_get_show_initials (AdwAvatarPaintable *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_PAINTABLE (self), FALSE);
+
+  return self->show_initials;
+}
+
+/**
+ * adw_avatar_paintable_set_show_initials:
+ * @self: an avatar paintable
+ * @show_initials: whether to use initials instead of an icon as fallback
+ *
+ * Sets whether to use initials instead of an icon on the fallback avatar.
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_paintable_set_show_initials (AdwAvatarPaintable *self,
+                                        gboolean            show_initials)
+{
+  g_return_if_fail (ADW_IS_AVATAR_PAINTABLE (self));
+
+  show_initials = !!show_initials;
+
+  if (self->show_initials == show_initials)
+    return;
+
+  self->show_initials = show_initials;
+
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SHOW_INITIALS]);
+}
+
+/**
+ * adw_avatar_paintable_get_custom_image:
+ * @self: an avatar paintable
+ *
+ * Gets the custom image paintable.
+ *
+ * Returns: (nullable) (transfer none): the custom image
+ *
+ * Since: 1.10
+ */
+GdkPaintable *
+adw_avatar_paintable_get_custom_image (AdwAvatarPaintable *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_PAINTABLE (self), NULL);
+
+  return self->custom_image;
+}
+
+/**
+ * adw_avatar_paintable_set_custom_image:
+ * @self: an avatar paintable
+ * @custom_image: (nullable) (transfer none): a custom image
+ *
+ * Sets the custom image paintable.
+ *
+ * Custom image is displayed instead of initials or icon.
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_paintable_set_custom_image (AdwAvatarPaintable *self,
+                                       GdkPaintable       *custom_image)
+{
+  g_return_if_fail (ADW_IS_AVATAR_PAINTABLE (self));
+  g_return_if_fail (custom_image == NULL || GDK_IS_PAINTABLE (custom_image));
+
+  if (self->custom_image == custom_image)
+    return;
+
+  if (self->custom_image)
+    g_signal_handlers_disconnect_by_func (self->custom_image,
+                                          invalidate_contents, self);
+
+  g_set_object (&self->custom_image, custom_image);
+
+  if (self->custom_image)
+    g_signal_connect_swapped (self->custom_image, "invalidate-contents",
+                              G_CALLBACK (invalidate_contents), self);
+
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CUSTOM_IMAGE]);
+}
+
+/**
+ * adw_avatar_paintable_get_size:
+ * @self: an avatar paintable
+ *
+ * Gets the size of the avatar.
+ *
+ * Returns: the size of the avatar
+ *
+ * Since: 1.10
+ */
+int
+adw_avatar_paintable_get_size (AdwAvatarPaintable *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR_PAINTABLE (self), 0);
+
+  return self->size;
+}
+
+/**
+ * adw_avatar_paintable_set_size:
+ * @self: an avatar paintable
+ * @size: the size of the avatar
+ *
+ * Sets the size of the avatar.
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_paintable_set_size (AdwAvatarPaintable *self,
+                               int                 size)
+{
+  g_return_if_fail (ADW_IS_AVATAR_PAINTABLE (self));
+  g_return_if_fail (size > 0);
+
+  if (self->size == size)
+    return;
+
+  self->size = size;
+
+  gdk_paintable_invalidate_size (GDK_PAINTABLE (self));
+  invalidate_contents (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SIZE]);
+}
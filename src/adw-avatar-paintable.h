@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-version.h"
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_AVATAR_PAINTABLE (adw_avatar_paintable_get_type ())
+
+ADW_AVAILABLE_IN_1_10
+G_DECLARE_FINAL_TYPE (AdwAvatarPaintable, adw_avatar_paintable, ADW, AVATAR_PAINTABLE, GObject)
+
+ADW_AVAILABLE_IN_1_10
+AdwAvatarPaintable *adw_avatar_paintable_new (int         size,
+                                              const char *text,
+                                              gboolean    show_initials) G_GNUC_WARN_UNUSED_RESULT;
+
+ADW_AVAILABLE_IN_1_10
+GtkWidget *adw_avatar_paintable_get_widget (AdwAvatarPaintable *self);
+ADW_AVAILABLE_IN_1_10
+void       adw_avatar_paintable_set_widget (AdwAvatarPaintable *self,
+                                            GtkWidget          *widget);
+
+ADW_AVAILABLE_IN_1_10
+const char *adw_avatar_paintable_get_icon_name (AdwAvatarPaintable *self);
+ADW_AVAILABLE_IN_1_10
+void        adw_avatar_paintable_set_icon_name (AdwAvatarPaintable *self,
+                                                const char         *icon_name);
+
+ADW_AVAILABLE_IN_1_10
+const char *adw_avatar_paintable_get_text (AdwAvatarPaintable *self);
+ADW_AVAILABLE_IN_1_10
+void        adw_avatar_paintable_set_text (AdwAvatarPaintable *self,
+                                           const char         *text);
+
+ADW_AVAILABLE_IN_1_10
+gboolean adw_avatar_paintable_get_show_initials (AdwAvatarPaintable *self);
+ADW_AVAILABLE_IN_1_10
+void     adw_avatar_paintable_set_show_initials (AdwAvatarPaintable *self,
+                                                 gboolean            show_initials);
+
+ADW_AVAILABLE_IN_1_10
+GdkPaintable *adw_avatar_paintable_get_custom_image (AdwAvatarPaintable *self);
+ADW_AVAILABLE_IN_1_10
+void          adw_avatar_paintable_set_custom_image (AdwAvatarPaintable *self,
+                                                     GdkPaintable       *custom_image);
+
+ADW_AVAILABLE_IN_1_10
+int  adw_avatar_paintable_get_size (AdwAvatarPaintable *self);
+ADW_AVAILABLE_IN_1_10
+void adw_avatar_paintable_set_size (AdwAvatarPaintable *self,
+                                    int                 size);
+
+G_END_DECLS
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-avatar.h"
+
+G_BEGIN_DECLS
+
+char  *adw_avatar_extract_initials (const char *text) G_GNUC_WARN_UNUSED_RESULT;
+guint  adw_avatar_get_color_class  (const char *text);
+double adw_avatar_get_font_size    (int         size,
+                                    int         text_width,
+                                    int         text_height);
+
+G_END_DECLS
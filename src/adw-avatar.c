@@ -14,7 +14,8 @@
 #include <math.h>
 #include <glib/gi18n.h>
 
-#include "adw-avatar.h"
+#include "adw-avatar-private.h"
+#include "adw-alloc-counters-private.h"
 #include "adw-gizmo-private.h"
 
 #define NUMBER_OF_COLORS 14
@@ -42,6 +43,23 @@
  *
  * Use [property@Avatar:custom-image] to set a custom image.
  *
+ * ## Downscaling Custom Images
+ *
+ * By default, `AdwAvatar` keeps the custom image as is and scales it down
+ * every time it's drawn. When the custom image is a large [class@Gdk.Texture],
+ * such as a camera photo, this means the whole texture stays in memory even
+ * though only a small part of it is ever visible.
+ *
+ * If [property@Avatar:downscale-custom-image] is set to `TRUE`, the avatar
+ * downscales the texture to its size in device pixels on a worker thread
+ * instead, and replaces the custom image with the result, dropping its
+ * reference to the original texture. [property@Avatar:custom-image] is notified
+ * when that happens, and from then on returns the downscaled texture.
+ *
+ * When the size or the scale factor changes, the downscaled texture is
+ * downscaled further if needed. It's never scaled back up, so set the custom
+ * image again to show it at a larger size.
+ *
  * ## CSS nodes
  *
  * `AdwAvatar` has a single CSS node with name `avatar`.
@@ -60,6 +78,8 @@ struct _AdwAvatar
   GtkImage *icon;
   GtkImage *custom_image;
   GdkPaintable *custom_image_source;
+  gboolean downscale_custom_image;
+  GCancellable *downscale_cancellable;
 
   char *icon_name;
   char *text;
@@ -77,12 +97,21 @@ enum {
   PROP_SHOW_INITIALS,
   PROP_CUSTOM_IMAGE,
   PROP_SIZE,
+  PROP_DOWNSCALE_CUSTOM_IMAGE,
   PROP_LAST_PROP,
 };
 static GParamSpec *props[PROP_LAST_PROP];
 
-static char *
-extract_initials_from_text (const char *text)
+/*
+ * adw_avatar_extract_initials:
+ * @text: the avatar text
+ *
+ * Extracts the initials of the first and the last word of @text.
+ *
+ * Returns: (nullable): the initials
+ */
+char *
+adw_avatar_extract_initials (const char *text)
 {
   GString *initials;
   char *p = g_utf8_strup (text, -1);
@@ -124,28 +153,83 @@ update_visibility (AdwAvatar *self)
   gtk_widget_set_visible (GTK_WIDGET (self->custom_image), has_custom_image);
 }
 
-static void
-set_class_color (AdwAvatar *self)
+/*
+ * adw_avatar_get_color_class:
+ * @text: (nullable): the avatar text
+ *
+ * Picks the color for an avatar with @text.
+ *
+ * The color is random if @text is empty.
+ *
+ * Returns: the color index, from 1 to the number of colors
+ */
+guint
+adw_avatar_get_color_class (const char *text)
 {
-  char *old_class, *new_class;
-
-  old_class = g_strdup_printf ("color%d", self->color_class);
-  gtk_widget_remove_css_class (self->gizmo, old_class);
+  guint color_class;
 
-  if (self->text == NULL || strlen (self->text) == 0) {
+  if (text == NULL || strlen (text) == 0) {
     /* Use a random color if we don't have a text */
     GRand *rand = g_rand_new ();
 
-    self->color_class = g_rand_int_range (rand, 1, NUMBER_OF_COLORS);
+    color_class = g_rand_int_range (rand, 1, NUMBER_OF_COLORS);
 
     g_rand_free (rand);
   } else {
-    self->color_class = (g_str_hash (self->text) % NUMBER_OF_COLORS) + 1;
+    color_class = (g_str_hash (text) % NUMBER_OF_COLORS) + 1;
   }
 
+  return color_class;
+}
+
+/*
+ * adw_avatar_get_font_size:
+ * @size: the avatar size
+ * @text_width: the width of the initials at the default font size
+ * @text_height: the height of the initials at the default font size
+ *
+ * Computes the font size for initials fitting into an avatar of @size.
+ *
+ * Returns: the font size, in pixels
+ */
+double
+adw_avatar_get_font_size (int size,
+                          int text_width,
+                          int text_height)
+{
+  double padding;
+  double sqr_size;
+  double max_size;
+  double new_font_size;
+
+  /* This is the size of the biggest square fitting inside the circle */
+  sqr_size = (double) size / 1.4142;
+  /* The padding has to be a function of the overall size.
+   * The 0.4 is how steep the linear function grows and the -5 is just
+   * an adjustment for smaller sizes which doesn't have a big impact on bigger sizes.
+   * Make also sure we don't have a negative padding */
+  padding = MAX (size * 0.4 - 5, 0);
+  max_size = sqr_size - padding;
+  new_font_size = (double) text_height * (max_size / (double) text_width);
+
+  return CLAMP (new_font_size, 0, max_size);
+}
+
+static void
+set_class_color (AdwAvatar *self)
+{
+  char *old_class, *new_class;
+
+  old_class = g_strdup_printf ("color%d", self->color_class);
+  gtk_widget_remove_css_class (self->gizmo, old_class);
+
+  self->color_class = adw_avatar_get_color_class (self->text);
+
   new_class = g_strdup_printf ("color%d", self->color_class);
   gtk_widget_add_css_class (self->gizmo, new_class);
 
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_AVATAR_COLOR, 2);
+
   g_free (old_class);
   g_free (new_class);
 }
@@ -179,7 +263,7 @@ update_initials (AdwAvatar *self)
       !*self->text)
     return;
 
-  initials = extract_initials_from_text (self->text);
+  initials = adw_avatar_extract_initials (self->text);
 
   gtk_label_set_label (self->label, initials);
 
@@ -199,10 +283,6 @@ static void
 update_font_size (AdwAvatar *self)
 {
   int width, height;
-  double padding;
-  double sqr_size;
-  double max_size;
-  double new_font_size;
   PangoAttrList *attributes;
 
   if (gtk_image_get_paintable (self->custom_image) != NULL ||
@@ -217,17 +297,8 @@ update_font_size (AdwAvatar *self)
 
   pango_layout_get_pixel_size (gtk_label_get_layout (self->label), &width, &height);
 
-  /* This is the size of the biggest square fitting inside the circle */
-  sqr_size = (double) self->size / 1.4142;
-  /* The padding has to be a function of the overall size.
-   * The 0.4 is how steep the linear function grows and the -5 is just
-   * an adjustment for smaller sizes which doesn't have a big impact on bigger sizes.
-   * Make also sure we don't have a negative padding */
-  padding = MAX (self->size * 0.4 - 5, 0);
-  max_size = sqr_size - padding;
-  new_font_size = (double) height * (max_size / (double) width);
-
-  pango_attr_list_change (attributes, pango_attr_size_new_absolute (CLAMP (new_font_size, 0, max_size) * PANGO_SCALE));
+  pango_attr_list_change (attributes,
+                          pango_attr_size_new_absolute (adw_avatar_get_font_size (self->size, width, height) * PANGO_SCALE));
   gtk_label_set_attributes (self->label, attributes);
 
   pango_attr_list_unref (attributes);
@@ -291,6 +362,163 @@ update_custom_image_snapshot (AdwAvatar *self)
   g_object_unref (square_image);
 }
 
+typedef struct {
+  GdkTexture *texture;
+  int size;
+} DownscaleData;
+
+static void
+downscale_data_free (DownscaleData *data)
+{
+  g_clear_object (&data->texture);
+  g_free (data);
+}
+
+static void
+downscale_thread (GTask         *task,
+                  gpointer       source_object,
+                  DownscaleData *data,
+                  GCancellable  *cancellable)
+{
+  GdkTextureDownloader *downloader;
+  GBytes *src_bytes;
+  const guchar *src;
+  gsize src_stride;
+  int width = gdk_texture_get_width (data->texture);
+  int height = gdk_texture_get_height (data->texture);
+  int crop = MIN (width, height);
+  int offset_x = (width - crop) / 2;
+  int offset_y = (height - crop) / 2;
+  gsize dest_stride = data->size * 4;
+  guchar *dest;
+  GBytes *bytes;
+  int x, y;
+
+  /* Textures can be downloaded from any thread, GL textures take care of
+   * doing it with their context themselves */
+  downloader = gdk_texture_downloader_new (data->texture);
+  gdk_texture_downloader_set_format (downloader, GDK_MEMORY_DEFAULT);
+  src_bytes = gdk_texture_downloader_download_bytes (downloader, &src_stride);
+  gdk_texture_downloader_free (downloader);
+
+  /* Don't hold the original past this point, the avatar drops it on the main
+   * thread once the downscaled texture is ready */
+  g_clear_object (&data->texture);
+
+  src = g_bytes_get_data (src_bytes, NULL);
+  dest = g_malloc (dest_stride * data->size);
+
+  /* Crop the middle square and average the source pixels covered by each
+   * destination pixel. The data is premultiplied, so averaging is fine */
+  for (y = 0; y < data->size; y++) {
+    int y0 = offset_y + y * crop / data->size;
+    int y1 = offset_y + (y + 1) * crop / data->size;
+
+    if (g_task_return_error_if_cancelled (task)) {
+      g_bytes_unref (src_bytes);
+      g_free (dest);
+      return;
+    }
+
+    for (x = 0; x < data->size; x++) {
+      int x0 = offset_x + x * crop / data->size;
+      int x1 = offset_x + (x + 1) * crop / data->size;
+      guint n = (x1 - x0) * (y1 - y0);
+      guint sum[4] = { 0, };
+      int i, j, c;
+
+      for (j = y0; j < y1; j++) {
+        const guchar *p = src + j * src_stride + x0 * 4;
+
+        for (i = x0; i < x1; i++, p += 4)
+          for (c = 0; c < 4; c++)
+            sum[c] += p[c];
+      }
+
+      for (c = 0; c < 4; c++)
+        dest[y * dest_stride + x * 4 + c] = (sum[c] + n / 2) / n;
+    }
+  }
+
+  g_bytes_unref (src_bytes);
+
+  bytes = g_bytes_new_take (dest, dest_stride * data->size);
+
+  g_task_return_pointer (task,
+                         gdk_memory_texture_new (data->size, data->size,
+                                                 GDK_MEMORY_DEFAULT,
+                                                 bytes, dest_stride),
+                         g_object_unref);
+
+  g_bytes_unref (bytes);
+}
+
+static void
+downscale_done_cb (AdwAvatar    *self,
+                   GAsyncResult *result,
+                   gpointer      user_data)
+{
+  GdkTexture *texture = g_task_propagate_pointer (G_TASK (result), NULL);
+
+  /* Cancelled, another downscale may be in progress already */
+  if (!texture)
+    return;
+
+  g_clear_object (&self->downscale_cancellable);
+
+  g_set_object (&self->custom_image_source, GDK_PAINTABLE (texture));
+  g_object_unref (texture);
+
+  update_custom_image_snapshot (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CUSTOM_IMAGE]);
+}
+
+static void
+cancel_downscale (AdwAvatar *self)
+{
+  g_cancellable_cancel (self->downscale_cancellable);
+  g_clear_object (&self->downscale_cancellable);
+}
+
+static void
+update_downscaled_custom_image (AdwAvatar *self)
+{
+  GdkTexture *source;
+  DownscaleData *data;
+  GTask *task;
+  int size, width, height;
+
+  cancel_downscale (self);
+
+  if (!self->downscale_custom_image || self->size <= 0 ||
+      !GDK_IS_TEXTURE (self->custom_image_source))
+    return;
+
+  source = GDK_TEXTURE (self->custom_image_source);
+  size = self->size * gtk_widget_get_scale_factor (GTK_WIDGET (self));
+  width = gdk_texture_get_width (source);
+  height = gdk_texture_get_height (source);
+
+  /* Nothing to gain from downscaling */
+  if (MIN (width, height) <= size)
+    return;
+
+  data = g_new0 (DownscaleData, 1);
+  data->texture = g_object_ref (source);
+  data->size = size;
+
+  self->downscale_cancellable = g_cancellable_new ();
+
+  task = g_task_new (self, self->downscale_cancellable,
+                     (GAsyncReadyCallback) downscale_done_cb, NULL);
+  g_task_set_source_tag (task, update_downscaled_custom_image);
+  g_task_set_task_data (task, data, (GDestroyNotify) downscale_data_free);
+  g_task_run_in_thread (task, (GTaskThreadFunc) downscale_thread);
+
+  g_object_unref (task);
+}
+
 static void
 adw_avatar_get_property (GObject    *object,
                          guint       property_id,
@@ -320,6 +548,10 @@ adw_avatar_get_property (GObject    *object,
     g_value_set_int (value, adw_avatar_get_size (self));
     break;
 
+  case PROP_DOWNSCALE_CUSTOM_IMAGE:
+    g_value_set_boolean (value, adw_avatar_get_downscale_custom_image (self));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     break;
@@ -355,6 +587,10 @@ adw_avatar_set_property (GObject      *object,
     adw_avatar_set_size (self, g_value_get_int (value));
     break;
 
+  case PROP_DOWNSCALE_CUSTOM_IMAGE:
+    adw_avatar_set_downscale_custom_image (self, g_value_get_boolean (value));
+    break;
+
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     break;
@@ -366,6 +602,8 @@ adw_avatar_dispose (GObject *object)
 {
   AdwAvatar *self = ADW_AVATAR (object);
 
+  cancel_downscale (self);
+
   g_clear_pointer (&self->gizmo, gtk_widget_unparent);
 
   self->label = NULL;
@@ -441,6 +679,10 @@ adw_avatar_class_init (AdwAvatarClass *klass)
    * A custom image paintable.
    *
    * Custom image is displayed instead of initials or icon.
+   *
+   * If [property@Avatar:downscale-custom-image] is `TRUE`, textures are
+   * replaced with a downscaled copy once it's ready, and the property is
+   * notified.
    */
   props[PROP_CUSTOM_IMAGE] =
     g_param_spec_object ("custom-image", NULL, NULL,
@@ -457,6 +699,20 @@ adw_avatar_class_init (AdwAvatarClass *klass)
                       -1, INT_MAX, -1,
                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwAvatar:downscale-custom-image:
+   *
+   * Whether to downscale custom image textures to the avatar size.
+   *
+   * See [Downscaling Custom Images](class.Avatar.html#downscaling-custom-images).
+   *
+   * Since: 1.10
+   */
+  props[PROP_DOWNSCALE_CUSTOM_IMAGE] =
+    g_param_spec_boolean ("downscale-custom-image", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
 
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
@@ -500,6 +756,7 @@ adw_avatar_init (AdwAvatar *self)
 
   g_signal_connect (self, "notify::root", G_CALLBACK (update_font_size), NULL);
   g_signal_connect (self, "notify::scale-factor", G_CALLBACK (update_custom_image_snapshot), NULL);
+  g_signal_connect (self, "notify::scale-factor", G_CALLBACK (update_downscaled_custom_image), NULL);
 }
 
 /**
@@ -657,6 +914,9 @@ adw_avatar_set_show_initials (AdwAvatar *self,
  *
  * Gets the custom image paintable.
  *
+ * If [property@Avatar:downscale-custom-image] is `TRUE` and the image has been
+ * downscaled, this returns the downscaled texture.
+ *
  * Returns: (nullable) (transfer none): the custom image
  */
 GdkPaintable *
@@ -691,6 +951,8 @@ adw_avatar_set_custom_image (AdwAvatar    *self,
                                           update_custom_image_snapshot, self);
   }
 
+  cancel_downscale (self);
+
   g_set_object (&self->custom_image_source, custom_image);
 
   if (custom_image) {
@@ -713,6 +975,7 @@ adw_avatar_set_custom_image (AdwAvatar    *self,
 
   update_initials (self);
   update_visibility (self);
+  update_downscaled_custom_image (self);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CUSTOM_IMAGE]);
 }
@@ -763,11 +1026,62 @@ adw_avatar_set_size (AdwAvatar *self,
 
   update_font_size (self);
   update_custom_image_snapshot (self);
+  update_downscaled_custom_image (self);
 
   gtk_widget_queue_resize (GTK_WIDGET (self));
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SIZE]);
 }
 
+/**
+ * adw_avatar_get_downscale_custom_image:
+ * @self: an avatar
+ *
+ * Gets whether to downscale custom image textures to the avatar size.
+ *
+ * Returns: whether to downscale custom images
+ *
+ * Since: 1.10
+ */
+gboolean
+adw_avatar_get_downscale_custom_image (AdwAvatar *self)
+{
+  g_return_val_if_fail (ADW_IS_AVATAR (self), FALSE);
+
+  return self->downscale_custom_image;
+}
+
+/**
+ * adw_avatar_set_downscale_custom_image:
+ * @self: an avatar
+ * @downscale_custom_image: whether to downscale custom images
+ *
+ * Sets whether to downscale custom image textures to the avatar size.
+ *
+ * See [Downscaling Custom Images](class.Avatar.html#downscaling-custom-images).
+ *
+ * Since: 1.10
+ */
+void
+adw_avatar_set_downscale_custom_image (AdwAvatar *self,
+                                       gboolean   downscale_custom_image)
+{
+  g_return_if_fail (ADW_IS_AVATAR (self));
+
+  downscale_custom_image = !!downscale_custom_image;
+
+  if (self->downscale_custom_image == downscale_custom_image)
+    return;
+
+  self->downscale_custom_image = downscale_custom_image;
+
+  if (downscale_custom_image)
+    update_downscaled_custom_image (self);
+  else
+    cancel_downscale (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_DOWNSCALE_CUSTOM_IMAGE]);
+}
+
 /**
  * adw_avatar_draw_to_texture:
  * @self: an avatar
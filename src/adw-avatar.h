@@ -56,6 +56,12 @@ ADW_AVAILABLE_IN_ALL
 void adw_avatar_set_size (AdwAvatar *self,
                           int        size);
 
+ADW_AVAILABLE_IN_1_10
+gboolean adw_avatar_get_downscale_custom_image (AdwAvatar *self);
+ADW_AVAILABLE_IN_1_10
+void     adw_avatar_set_downscale_custom_image (AdwAvatar *self,
+                                                gboolean   downscale_custom_image);
+
 ADW_AVAILABLE_IN_ALL
 GdkTexture *adw_avatar_draw_to_texture (AdwAvatar *self,
                                         int        scale_factor) G_GNUC_WARN_UNUSED_RESULT;
@@ -12,6 +12,7 @@
 
 #include <math.h>
 
+#include "adw-adaptive-context-private.h"
 #include "adw-animation-target.h"
 #include "adw-animation-util-private.h"
 #include "adw-bin.h"
@@ -125,6 +126,8 @@ struct _AdwBottomSheet
   GtkWidget *sheet_stack;
   GtkWidget *sheet_bin;
   GtkWidget *dimming;
+
+  AdwAdaptiveContext *sheet_context;
   GtkWidget *bottom_bar_bin;
 
   GtkWidget *drag_handle;
@@ -654,6 +657,16 @@ adw_bottom_sheet_size_allocate (GtkWidget *widget,
   gtk_widget_allocate (self->sheet_bin, sheet_width, sheet_height, baseline, transform);
 }
 
+static void
+adw_bottom_sheet_unroot (GtkWidget *widget)
+{
+  AdwBottomSheet *self = ADW_BOTTOM_SHEET (widget);
+
+  adw_adaptive_context_invalidate (self->sheet_context);
+
+  GTK_WIDGET_CLASS (adw_bottom_sheet_parent_class)->unroot (widget);
+}
+
 static void
 adw_bottom_sheet_dispose (GObject *object)
 {
@@ -667,6 +680,7 @@ adw_bottom_sheet_dispose (GObject *object)
   g_clear_pointer (&self->dimming, gtk_widget_unparent);
   g_clear_pointer (&self->sheet_bin, gtk_widget_unparent);
   g_clear_object (&self->open_animation);
+  g_clear_object (&self->sheet_context);
   self->content = NULL;
   self->sheet = NULL;
   self->sheet_stack = NULL;
@@ -788,6 +802,7 @@ adw_bottom_sheet_class_init (AdwBottomSheetClass *klass)
   object_class->get_property = adw_bottom_sheet_get_property;
   object_class->set_property = adw_bottom_sheet_set_property;
 
+  widget_class->unroot = adw_bottom_sheet_unroot;
   widget_class->contains = adw_widget_contains_passthrough;
   widget_class->measure = adw_bottom_sheet_measure;
   widget_class->size_allocate = adw_bottom_sheet_size_allocate;
@@ -1167,6 +1182,10 @@ adw_bottom_sheet_init (AdwBottomSheet *self)
   gtk_widget_set_child_visible (self->sheet_bin, FALSE);
   gtk_widget_set_parent (self->sheet_bin, GTK_WIDGET (self));
 
+  self->sheet_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_SHEET);
+  adw_adaptive_context_attach (self->sheet_context, self->sheet_bin);
+
   self->sheet_stack = gtk_stack_new ();
   gtk_stack_set_hhomogeneous (GTK_STACK (self->sheet_stack), TRUE);
   gtk_stack_set_transition_type (GTK_STACK (self->sheet_stack),
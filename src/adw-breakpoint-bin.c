@@ -12,6 +12,7 @@
 
 #include "adw-breakpoint-private.h"
 #include "adw-gtkbuilder-utils-private.h"
+#include "adw-layout-profiler-private.h"
 #include "adw-widget-utils-private.h"
 
 /**
@@ -380,6 +381,7 @@ adw_breakpoint_bin_measure (GtkWidget      *widget,
   AdwBreakpointBin *self = ADW_BREAKPOINT_BIN (widget);
   AdwBreakpointBinPrivate *priv = adw_breakpoint_bin_get_instance_private (self);
   int min = 0, nat = 0;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   if (priv->child) {
     gtk_widget_measure (priv->child, orientation, for_size,
@@ -409,6 +411,8 @@ adw_breakpoint_bin_measure (GtkWidget      *widget,
     *minimum_baseline = -1;
   if (natural_baseline)
     *natural_baseline = -1;
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static void
@@ -423,9 +427,12 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
   AdwBreakpoint *new_breakpoint = NULL;
   GtkSettings *settings;
   int i;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
-  if (!priv->child)
+  if (!priv->child) {
+    ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
     return;
+  }
 
   settings = gtk_widget_get_settings (widget);
 
@@ -443,6 +450,7 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
     allocate_child (self, width, height, baseline);
     priv->first_allocation = FALSE;
 
+    ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
     return;
   }
 
@@ -490,6 +498,8 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
                                                      (GtkTickCallback) breakpoint_changed_tick_cb,
                                                      self, NULL);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static void
@@ -20,6 +20,7 @@
 #define DOTS_OPACITY_SELECTED 0.9
 #define DOTS_SPACING 7
 #define DOTS_MARGIN 6
+#define N_EDGE_DOTS 2
 
 /**
  * AdwCarouselIndicatorDots:
@@ -36,6 +37,9 @@
  * larger and more opaque than the others, the transition to the active and
  * inactive state is gradual to match the carousel's position.
  *
+ * For carousels with many pages, set [property@CarouselIndicatorDots:max-dots]
+ * to only show the dots around the current position.
+ *
  * See also [class@CarouselIndicatorLines].
  *
  * ## CSS nodes
@@ -53,6 +57,17 @@ struct _AdwCarouselIndicatorDots
 
   AdwAnimation *animation;
   GBinding *duration_binding;
+
+  guint max_dots;
+
+  /* The dots that don't change while moving between two pages */
+  GskRenderNode *static_node;
+  int static_node_length;
+  int static_node_thickness;
+  int static_node_n_pages;
+  int static_node_active;
+  double static_node_window_start;
+  GdkRGBA static_node_color;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdwCarouselIndicatorDots, adw_carousel_indicator_dots, GTK_TYPE_WIDGET,
@@ -61,36 +76,91 @@ G_DEFINE_FINAL_TYPE_WITH_CODE (AdwCarouselIndicatorDots, adw_carousel_indicator_
 enum {
   PROP_0,
   PROP_CAROUSEL,
+  PROP_MAX_DOTS,
 
   /* GtkOrientable */
   PROP_ORIENTATION,
-  LAST_PROP = PROP_CAROUSEL + 1,
+  LAST_PROP = PROP_MAX_DOTS + 1,
 };
 
 static GParamSpec *props[LAST_PROP];
 
 static void
-snapshot_dots (GtkWidget      *widget,
-               GtkSnapshot    *snapshot,
-               GtkOrientation  orientation,
-               double          position,
-               double         *sizes,
-               guint           n_pages)
+snapshot_dot (GtkSnapshot   *snapshot,
+              const GdkRGBA *color,
+              double         x,
+              double         y,
+              double         radius,
+              double         opacity)
+{
+  GdkRGBA dot_color = *color;
+  graphene_rect_t rect;
+  GskRoundedRect clip;
+
+  if (radius <= 0 || opacity <= 0)
+    return;
+
+  dot_color.alpha *= opacity;
+
+  graphene_rect_init (&rect, x - radius, y - radius, radius * 2, radius * 2);
+  gsk_rounded_rect_init_from_rect (&clip, &rect, radius);
+
+  gtk_snapshot_push_rounded_clip (snapshot, &clip);
+  gtk_snapshot_append_color (snapshot, &dot_color, &rect);
+  gtk_snapshot_pop (snapshot);
+}
+
+static inline double
+get_total_size (double *sizes,
+                guint   n_pages)
+{
+  double total = 0;
+  guint i;
+
+  for (i = 0; i < n_pages; i++)
+    total += sizes[i];
+
+  return total;
+}
+
+static void
+snapshot_dots (AdwCarouselIndicatorDots *self,
+               GtkSnapshot              *snapshot,
+               double                    position,
+               double                   *sizes,
+               guint                     n_pages)
 {
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkSnapshot *static_snapshot = NULL;
   GdkRGBA color;
-  int i, widget_length, widget_thickness;
+  int i, widget_length, widget_thickness, active;
   double x, y, indicator_length, dot_size, full_size;
   double current_position, remaining_progress;
-  graphene_rect_t rect;
+  double total_size, window_start, hidden_before, hidden_after;
+  gboolean windowed, can_cache, use_cache;
 
   gtk_widget_get_color (widget, &color);
   dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
 
-  indicator_length = -DOTS_SPACING;
-  for (i = 0; i < n_pages; i++)
-    indicator_length += dot_size * sizes[i];
+  total_size = get_total_size (sizes, n_pages);
+  windowed = self->max_dots > 0 && total_size > self->max_dots;
+
+  /* Only show the dots within [window_start, window_start + max_dots), keeping
+   * the current one in the middle until reaching either end */
+  if (windowed) {
+    window_start = CLAMP (position - (self->max_dots - 1) / 2.0,
+                          0, total_size - self->max_dots);
+    hidden_before = MIN (window_start, 1);
+    hidden_after = MIN (total_size - self->max_dots - window_start, 1);
+    indicator_length = dot_size * self->max_dots - DOTS_SPACING;
+  } else {
+    window_start = 0;
+    hidden_before = 0;
+    hidden_after = 0;
+    indicator_length = dot_size * total_size - DOTS_SPACING;
+  }
 
-  if (orientation == GTK_ORIENTATION_HORIZONTAL) {
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
     widget_length = gtk_widget_get_width (widget);
     widget_thickness = gtk_widget_get_height (widget);
   } else {
@@ -103,7 +173,7 @@ snapshot_dots (GtkWidget      *widget,
   if ((widget_length - (int) full_size) % 2 == 0)
     widget_length--;
 
-  if (orientation == GTK_ORIENTATION_HORIZONTAL) {
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
     x = (widget_length - indicator_length) / 2.0;
     y = widget_thickness / 2;
   } else {
@@ -111,48 +181,94 @@ snapshot_dots (GtkWidget      *widget,
     y = (widget_length - indicator_length) / 2.0;
   }
 
+  /* When no pages are being added or removed, only the dots of the two pages
+   * around the current position change between frames, so the rest can be
+   * reused until the position crosses to another pair of pages */
+  can_cache = TRUE;
+  for (i = 0; i < n_pages; i++) {
+    if (!G_APPROX_VALUE (sizes[i], 1, DBL_EPSILON)) {
+      can_cache = FALSE;
+      break;
+    }
+  }
+
+  /* The window moves along with the position, so there's nothing to reuse
+   * unless it's at either end */
+  if (windowed && window_start > 0 && window_start < total_size - self->max_dots)
+    can_cache = FALSE;
+
+  active = (int) floor (position);
+
+  use_cache = can_cache &&
+              self->static_node &&
+              self->static_node_length == widget_length &&
+              self->static_node_thickness == widget_thickness &&
+              self->static_node_n_pages == n_pages &&
+              self->static_node_active == active &&
+              G_APPROX_VALUE (self->static_node_window_start, window_start, DBL_EPSILON) &&
+              gdk_rgba_equal (&self->static_node_color, &color);
+
+  if (use_cache)
+    gtk_snapshot_append_node (snapshot, self->static_node);
+  else if (can_cache)
+    static_snapshot = gtk_snapshot_new ();
+
   current_position = 0;
   remaining_progress = 1;
 
-  graphene_rect_init (&rect, -DOTS_RADIUS, -DOTS_RADIUS, DOTS_RADIUS * 2, DOTS_RADIUS * 2);
-
   for (i = 0; i < n_pages; i++) {
-    double progress, radius, opacity;
-    GskRoundedRect clip;
+    double progress, radius, opacity, scale, offset, center;
+    gboolean is_static;
 
-    if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      x += dot_size * sizes[i] / 2.0;
-    else
-      y += dot_size * sizes[i] / 2.0;
+    offset = current_position - window_start;
+    center = offset + sizes[i] / 2.0;
 
     current_position += sizes[i];
 
     progress = CLAMP (current_position - position, 0, remaining_progress);
     remaining_progress -= progress;
 
-    radius = adw_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress) * sizes[i];
-    opacity = adw_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress) * sizes[i];
+    if (windowed && (offset <= -1 || offset >= self->max_dots))
+      continue;
+
+    is_static = can_cache && i != active && i != active + 1;
 
-    gsk_rounded_rect_init_from_rect (&clip, &rect, radius);
+    if (is_static && use_cache)
+      continue;
 
-    gtk_snapshot_save (snapshot);
-    gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (x, y));
-    gtk_snapshot_scale (snapshot, radius / DOTS_RADIUS, radius / DOTS_RADIUS);
+    /* Shrink the dots at the edges when there are more pages past them */
+    scale = 1;
+    if (hidden_before > 0)
+      scale *= adw_lerp (1, CLAMP ((offset + 1) / (N_EDGE_DOTS + 1), 0, 1),
+                         hidden_before);
+    if (hidden_after > 0)
+      scale *= adw_lerp (1, CLAMP ((self->max_dots - offset) / (N_EDGE_DOTS + 1), 0, 1),
+                         hidden_after);
 
-    gtk_snapshot_push_rounded_clip (snapshot, &clip);
-    gtk_snapshot_push_opacity (snapshot, opacity);
+    radius = adw_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress) * sizes[i] * scale;
+    opacity = adw_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress) * sizes[i];
 
-    gtk_snapshot_append_color (snapshot, &color, &rect);
+    if (self->orientation == GTK_ORIENTATION_HORIZONTAL)
+      snapshot_dot (is_static ? static_snapshot : snapshot, &color,
+                    x + dot_size * center, y, radius, opacity);
+    else
+      snapshot_dot (is_static ? static_snapshot : snapshot, &color,
+                    x, y + dot_size * center, radius, opacity);
+  }
 
-    gtk_snapshot_pop (snapshot);
-    gtk_snapshot_pop (snapshot);
+  if (static_snapshot) {
+    g_clear_pointer (&self->static_node, gsk_render_node_unref);
 
-    gtk_snapshot_restore (snapshot);
+    self->static_node = gtk_snapshot_free_to_node (static_snapshot);
+    self->static_node_length = widget_length;
+    self->static_node_thickness = widget_thickness;
+    self->static_node_n_pages = n_pages;
+    self->static_node_active = active;
+    self->static_node_window_start = window_start;
+    self->static_node_color = color;
 
-    if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      x += dot_size * sizes[i] / 2.0;
-    else
-      y += dot_size * sizes[i] / 2.0;
+    if (self->static_node)
+      gtk_snapshot_append_node (snapshot, self->static_node);
   }
 }
 
@@ -191,9 +307,10 @@ adw_carousel_indicator_dots_measure (GtkWidget      *widget,
       sizes[i] = points[i] - points[i - 1];
 
     dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
-    indicator_length = 0;
-    for (i = 0; i < n_points; i++)
-      indicator_length += dot_size * sizes[i];
+    indicator_length = dot_size * get_total_size (sizes, n_points);
+
+    if (self->max_dots > 0)
+      indicator_length = MIN (indicator_length, dot_size * self->max_dots);
 
     size = ceil (indicator_length);
 
@@ -249,7 +366,7 @@ adw_carousel_indicator_dots_snapshot (GtkWidget   *widget,
   for (i = 1; i < n_points; i++)
     sizes[i] = points[i] - points[i - 1];
 
-  snapshot_dots (widget, snapshot, self->orientation, position, sizes, n_points);
+  snapshot_dots (self, snapshot, position, sizes, n_points);
 
   g_free (sizes);
   g_free (points);
@@ -263,6 +380,7 @@ adw_carousel_dispose (GObject *object)
   adw_carousel_indicator_dots_set_carousel (self, NULL);
 
   g_clear_object (&self->animation);
+  g_clear_pointer (&self->static_node, gsk_render_node_unref);
 
   G_OBJECT_CLASS (adw_carousel_indicator_dots_parent_class)->dispose (object);
 }
@@ -280,6 +398,10 @@ adw_carousel_indicator_dots_get_property (GObject    *object,
     g_value_set_object (value, adw_carousel_indicator_dots_get_carousel (self));
     break;
 
+  case PROP_MAX_DOTS:
+    g_value_set_uint (value, adw_carousel_indicator_dots_get_max_dots (self));
+    break;
+
   case PROP_ORIENTATION:
     g_value_set_enum (value, self->orientation);
     break;
@@ -302,11 +424,16 @@ adw_carousel_indicator_dots_set_property (GObject      *object,
     adw_carousel_indicator_dots_set_carousel (self, g_value_get_object (value));
     break;
 
+  case PROP_MAX_DOTS:
+    adw_carousel_indicator_dots_set_max_dots (self, g_value_get_uint (value));
+    break;
+
   case PROP_ORIENTATION:
     {
       GtkOrientation orientation = g_value_get_enum (value);
       if (orientation != self->orientation) {
         self->orientation = orientation;
+        g_clear_pointer (&self->static_node, gsk_render_node_unref);
         gtk_widget_queue_resize (GTK_WIDGET (self));
         g_object_notify (G_OBJECT (self), "orientation");
       }
@@ -341,6 +468,24 @@ adw_carousel_indicator_dots_class_init (AdwCarouselIndicatorDotsClass *klass)
                          ADW_TYPE_CAROUSEL,
                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwCarouselIndicatorDots:max-dots:
+   *
+   * The maximum number of dots to show.
+   *
+   * If the carousel has more pages than that, only the dots around the current
+   * position are shown, and the dots at the edges shrink to indicate that
+   * there are more pages past them.
+   *
+   * If set to 0, a dot is shown for every page.
+   *
+   * Since: 1.10
+   */
+  props[PROP_MAX_DOTS] =
+    g_param_spec_uint ("max-dots", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_override_property (object_class,
                                     PROP_ORIENTATION,
                                     "orientation");
@@ -438,3 +583,55 @@ adw_carousel_indicator_dots_set_carousel (AdwCarouselIndicatorDots *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CAROUSEL]);
 }
+
+/**
+ * adw_carousel_indicator_dots_get_max_dots:
+ * @self: an indicator
+ *
+ * Gets the maximum number of dots to show.
+ *
+ * Returns: the maximum number of dots
+ *
+ * Since: 1.10
+ */
+guint
+adw_carousel_indicator_dots_get_max_dots (AdwCarouselIndicatorDots *self)
+{
+  g_return_val_if_fail (ADW_IS_CAROUSEL_INDICATOR_DOTS (self), 0);
+
+  return self->max_dots;
+}
+
+/**
+ * adw_carousel_indicator_dots_set_max_dots:
+ * @self: an indicator
+ * @max_dots: the maximum number of dots
+ *
+ * Sets the maximum number of dots to show.
+ *
+ * If the carousel has more pages than that, only the dots around the current
+ * position are shown, and the dots at the edges shrink to indicate that there
+ * are more pages past them.
+ *
+ * If set to 0, a dot is shown for every page.
+ *
+ * Since: 1.10
+ */
+void
+adw_carousel_indicator_dots_set_max_dots (AdwCarouselIndicatorDots *self,
+                                          guint                     max_dots)
+{
+  g_return_if_fail (ADW_IS_CAROUSEL_INDICATOR_DOTS (self));
+
+  if (self->max_dots == max_dots)
+    return;
+
+  self->max_dots = max_dots;
+
+  /* The cached dots depend on which of them are shown */
+  g_clear_pointer (&self->static_node, gsk_render_node_unref);
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_DOTS]);
+}
@@ -31,4 +31,10 @@ ADW_AVAILABLE_IN_ALL
 void         adw_carousel_indicator_dots_set_carousel (AdwCarouselIndicatorDots *self,
                                                        AdwCarousel              *carousel);
 
+ADW_AVAILABLE_IN_1_10
+guint adw_carousel_indicator_dots_get_max_dots (AdwCarouselIndicatorDots *self);
+ADW_AVAILABLE_IN_1_10
+void  adw_carousel_indicator_dots_set_max_dots (AdwCarouselIndicatorDots *self,
+                                                guint                     max_dots);
+
 G_END_DECLS
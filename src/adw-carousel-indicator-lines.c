@@ -51,6 +51,13 @@ struct _AdwCarouselIndicatorLines
 
   AdwAnimation *animation;
   GBinding *duration_binding;
+
+  /* The inactive lines, which only change when pages are added or removed */
+  GskRenderNode *lines_node;
+  int lines_node_length;
+  int lines_node_thickness;
+  int lines_node_n_pages;
+  GdkRGBA lines_node_color;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdwCarouselIndicatorLines, adw_carousel_indicator_lines, GTK_TYPE_WIDGET,
@@ -68,27 +75,30 @@ enum {
 static GParamSpec *props[LAST_PROP];
 
 static void
-snapshot_lines (GtkWidget      *widget,
-                GtkSnapshot    *snapshot,
-                GtkOrientation  orientation,
-                double          position,
-                double         *sizes,
-                guint           n_pages)
+snapshot_lines (AdwCarouselIndicatorLines *self,
+                GtkSnapshot               *snapshot,
+                double                     position,
+                double                    *sizes,
+                guint                      n_pages)
 {
-  GdkRGBA color;
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkSnapshot *lines_snapshot;
+  GdkRGBA color, inactive_color;
   int i, widget_length, widget_thickness;
   double indicator_length, full_size, line_size;
   double x = 0, y = 0, pos;
+  gboolean can_cache;
 
   gtk_widget_get_color (widget, &color);
-  color.alpha *= LINE_OPACITY;
+  inactive_color = color;
+  inactive_color.alpha *= LINE_OPACITY;
 
   line_size = LINE_LENGTH + LINE_SPACING;
   indicator_length = -LINE_SPACING;
   for (i = 0; i < n_pages; i++)
     indicator_length += line_size * sizes[i];
 
-  if (orientation == GTK_ORIENTATION_HORIZONTAL) {
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
     widget_length = gtk_widget_get_width (widget);
     widget_thickness = gtk_widget_get_height (widget);
   } else {
@@ -101,7 +111,7 @@ snapshot_lines (GtkWidget      *widget,
   if ((widget_length - (int) full_size) % 2 == 0)
     widget_length--;
 
-  if (orientation == GTK_ORIENTATION_HORIZONTAL) {
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
     x = (widget_length - indicator_length) / 2.0;
     y = (widget_thickness - LINE_WIDTH) / 2;
   } else {
@@ -109,31 +119,70 @@ snapshot_lines (GtkWidget      *widget,
     y = (widget_length - indicator_length) / 2.0;
   }
 
-  pos = 0;
+  /* Only the active line moves with the position, the rest can be reused as
+   * long as no pages are being added or removed */
+  can_cache = TRUE;
   for (i = 0; i < n_pages; i++) {
-    double length;
-    graphene_rect_t rectangle;
+    if (!G_APPROX_VALUE (sizes[i], 1, DBL_EPSILON)) {
+      can_cache = FALSE;
+      break;
+    }
+  }
+
+  if (can_cache &&
+      self->lines_node &&
+      self->lines_node_length == widget_length &&
+      self->lines_node_thickness == widget_thickness &&
+      self->lines_node_n_pages == n_pages &&
+      gdk_rgba_equal (&self->lines_node_color, &color)) {
+    gtk_snapshot_append_node (snapshot, self->lines_node);
+  } else {
+    GskRenderNode *node;
+
+    lines_snapshot = gtk_snapshot_new ();
+
+    pos = 0;
+    for (i = 0; i < n_pages; i++) {
+      double length;
+      graphene_rect_t rectangle;
+
+      length = (LINE_LENGTH + LINE_SPACING) * sizes[i] - LINE_SPACING;
 
-    length = (LINE_LENGTH + LINE_SPACING) * sizes[i] - LINE_SPACING;
+      if (length > 0) {
+        if (self->orientation == GTK_ORIENTATION_HORIZONTAL)
+          graphene_rect_init (&rectangle, x + pos, y, length, LINE_WIDTH);
+        else
+          graphene_rect_init (&rectangle, x, y + pos, LINE_WIDTH, length);
 
-    if (length > 0) {
-      if (orientation == GTK_ORIENTATION_HORIZONTAL)
-        graphene_rect_init (&rectangle, x + pos, y, length, LINE_WIDTH);
-      else
-        graphene_rect_init (&rectangle, x, y + pos, LINE_WIDTH, length);
+        gtk_snapshot_append_color (lines_snapshot, &inactive_color, &rectangle);
+      }
+
+      pos += (LINE_LENGTH + LINE_SPACING) * sizes[i];
     }
 
-    gtk_snapshot_append_color (snapshot, &color, &rectangle);
+    node = gtk_snapshot_free_to_node (lines_snapshot);
+
+    if (node)
+      gtk_snapshot_append_node (snapshot, node);
+
+    g_clear_pointer (&self->lines_node, gsk_render_node_unref);
 
-    pos += (LINE_LENGTH + LINE_SPACING) * sizes[i];
+    if (can_cache) {
+      self->lines_node = g_steal_pointer (&node);
+      self->lines_node_length = widget_length;
+      self->lines_node_thickness = widget_thickness;
+      self->lines_node_n_pages = n_pages;
+      self->lines_node_color = color;
+    }
+
+    g_clear_pointer (&node, gsk_render_node_unref);
   }
 
-  gtk_widget_get_color (widget, &color);
   color.alpha *= LINE_OPACITY_ACTIVE;
 
   pos = position * (LINE_LENGTH + LINE_SPACING);
 
-  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL)
     gtk_snapshot_append_color (snapshot, &color,
                                &GRAPHENE_RECT_INIT (x + pos, y, LINE_LENGTH, LINE_WIDTH));
   else
@@ -234,7 +283,7 @@ adw_carousel_indicator_lines_snapshot (GtkWidget   *widget,
   for (i = 1; i < n_points; i++)
     sizes[i] = points[i] - points[i - 1];
 
-  snapshot_lines (widget, snapshot, self->orientation, position, sizes, n_points);
+  snapshot_lines (self, snapshot, position, sizes, n_points);
 
   g_free (sizes);
   g_free (points);
@@ -248,6 +297,7 @@ adw_carousel_dispose (GObject *object)
   adw_carousel_indicator_lines_set_carousel (self, NULL);
 
   g_clear_object (&self->animation);
+  g_clear_pointer (&self->lines_node, gsk_render_node_unref);
 
   G_OBJECT_CLASS (adw_carousel_indicator_lines_parent_class)->dispose (object);
 }
@@ -292,6 +342,7 @@ adw_carousel_indicator_lines_set_property (GObject      *object,
       GtkOrientation orientation = g_value_get_enum (value);
       if (orientation != self->orientation) {
         self->orientation = orientation;
+        g_clear_pointer (&self->lines_node, gsk_render_node_unref);
         gtk_widget_queue_resize (GTK_WIDGET (self));
         g_object_notify (G_OBJECT (self), "orientation");
       }
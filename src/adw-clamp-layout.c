@@ -12,6 +12,7 @@
 #include "adw-animation-util.h"
 #include "adw-easing.h"
 #include "adw-enums.h"
+#include "adw-layout-profiler-private.h"
 #include "adw-length-unit.h"
 
 /**
@@ -247,6 +248,7 @@ adw_clamp_layout_measure (GtkLayoutManager *manager,
   AdwClampLayout *self = ADW_CLAMP_LAYOUT (manager);
   GtkSettings *settings = gtk_widget_get_settings (widget);
   GtkWidget *child;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   for (child = gtk_widget_get_first_child (widget);
        child != NULL;
@@ -313,6 +315,8 @@ adw_clamp_layout_measure (GtkLayoutManager *manager,
     if (nat_baseline > -1)
       *natural_baseline = MAX (*natural_baseline, nat_baseline);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static void
@@ -325,6 +329,7 @@ adw_clamp_layout_allocate (GtkLayoutManager *manager,
   AdwClampLayout *self = ADW_CLAMP_LAYOUT (manager);
   GtkSettings *settings = gtk_widget_get_settings (widget);
   GtkWidget *child;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   for (child = gtk_widget_get_first_child (widget);
        child != NULL;
@@ -384,6 +389,8 @@ adw_clamp_layout_allocate (GtkLayoutManager *manager,
 
     gtk_widget_size_allocate (child, &child_allocation, baseline);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static void
@@ -49,4 +49,18 @@ void adw_oklch_to_rgb (float  L,   float  c,     float  h,
 void adw_rgb_to_oklch (float  red, float  green, float  blue,
                        float *L,   float *c,     float *h);
 
+void adw_rgb_to_oklab_n (const float *rgb,
+                         float       *lab,
+                         gsize        n_colors);
+void adw_oklab_to_rgb_n (const float *lab,
+                         float       *rgb,
+                         gsize        n_colors);
+
+void adw_rgb_to_oklch_n (const float *rgb,
+                         float       *lch,
+                         gsize        n_colors);
+void adw_oklch_to_rgb_n (const float *lch,
+                         float       *rgb,
+                         gsize        n_colors);
+
 G_END_DECLS
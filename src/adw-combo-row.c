@@ -11,6 +11,8 @@
  */
 
 #include "config.h"
+#include <glib/gi18n-lib.h>
+
 #include "adw-combo-row.h"
 
 /**
@@ -719,18 +721,6 @@ adw_combo_row_class_init (AdwComboRowClass *klass)
 
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
-  gtk_widget_class_set_template_from_resource (widget_class,
-                                               "/org/gnome/Adwaita/ui/adw-combo-row.ui");
-  gtk_widget_class_bind_template_child_private (widget_class, AdwComboRow, current);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwComboRow, arrow_box);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwComboRow, list);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwComboRow, popover);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwComboRow, search_entry);
-  gtk_widget_class_bind_template_callback (widget_class, row_activated_cb);
-  gtk_widget_class_bind_template_callback (widget_class, notify_popover_visible_cb);
-  gtk_widget_class_bind_template_callback (widget_class, search_changed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, search_stop_cb);
-
   gtk_widget_class_set_accessible_role (widget_class, GTK_ACCESSIBLE_ROLE_COMBO_BOX);
 }
 
@@ -738,10 +728,68 @@ static void
 adw_combo_row_init (AdwComboRow *self)
 {
   AdwComboRowPrivate *priv = adw_combo_row_get_instance_private (self);
+  GtkWidget *arrow, *box, *scrolled_window;
 
   priv->search_match_mode = GTK_STRING_FILTER_MATCH_MODE_PREFIX;
 
-  gtk_widget_init_template (GTK_WIDGET (self));
+  gtk_widget_add_css_class (GTK_WIDGET (self), "combo");
+
+  priv->current = GTK_LIST_VIEW (gtk_list_view_new (NULL, NULL));
+  gtk_widget_set_valign (GTK_WIDGET (priv->current), GTK_ALIGN_CENTER);
+  gtk_widget_set_can_focus (GTK_WIDGET (priv->current), FALSE);
+  gtk_widget_set_can_target (GTK_WIDGET (priv->current), FALSE);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->current), "inline");
+  adw_action_row_add_suffix (ADW_ACTION_ROW (self), GTK_WIDGET (priv->current));
+
+  priv->arrow_box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0);
+  gtk_widget_set_valign (priv->arrow_box, GTK_ALIGN_CENTER);
+  adw_action_row_add_suffix (ADW_ACTION_ROW (self), priv->arrow_box);
+
+  arrow = g_object_new (GTK_TYPE_IMAGE,
+                        "accessible-role", GTK_ACCESSIBLE_ROLE_PRESENTATION,
+                        "icon-name", "pan-down-symbolic",
+                        NULL);
+  gtk_widget_add_css_class (arrow, "dropdown-arrow");
+  gtk_box_append (GTK_BOX (priv->arrow_box), arrow);
+
+  priv->popover = GTK_POPOVER (gtk_popover_new ());
+  gtk_widget_add_css_class (GTK_WIDGET (priv->popover), "menu");
+  gtk_box_append (GTK_BOX (priv->arrow_box), GTK_WIDGET (priv->popover));
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  gtk_popover_set_child (priv->popover, box);
+
+  priv->search_entry = GTK_SEARCH_ENTRY (gtk_search_entry_new ());
+  gtk_widget_set_visible (GTK_WIDGET (priv->search_entry), FALSE);
+  gtk_editable_set_max_width_chars (GTK_EDITABLE (priv->search_entry), 6);
+  gtk_editable_set_width_chars (GTK_EDITABLE (priv->search_entry), 6);
+  /* Translators: placeholder text of the search entry from AdwComboRow.
+     It should be phrased as a verb */
+  gtk_search_entry_set_placeholder_text (priv->search_entry, _("Search"));
+  gtk_widget_add_css_class (GTK_WIDGET (priv->search_entry), "combo-searchbar");
+  gtk_box_append (GTK_BOX (box), GTK_WIDGET (priv->search_entry));
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (scrolled_window),
+                                  GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_scrolled_window_set_max_content_height (GTK_SCROLLED_WINDOW (scrolled_window), 400);
+  gtk_scrolled_window_set_propagate_natural_width (GTK_SCROLLED_WINDOW (scrolled_window), TRUE);
+  gtk_scrolled_window_set_propagate_natural_height (GTK_SCROLLED_WINDOW (scrolled_window), TRUE);
+  gtk_box_append (GTK_BOX (box), scrolled_window);
+
+  priv->list = GTK_LIST_VIEW (gtk_list_view_new (NULL, NULL));
+  gtk_list_view_set_single_click_activate (priv->list, TRUE);
+  gtk_list_view_set_tab_behavior (priv->list, GTK_LIST_TAB_ITEM);
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), GTK_WIDGET (priv->list));
+
+  g_signal_connect_swapped (priv->popover, "notify::visible",
+                            G_CALLBACK (notify_popover_visible_cb), self);
+  g_signal_connect (priv->search_entry, "search-changed",
+                    G_CALLBACK (search_changed_cb), self);
+  g_signal_connect (priv->search_entry, "stop-search",
+                    G_CALLBACK (search_stop_cb), self);
+  g_signal_connect_swapped (priv->list, "activate",
+                            G_CALLBACK (row_activated_cb), self);
 
   adw_preferences_row_set_use_markup (ADW_PREFERENCES_ROW (self), FALSE);
   set_default_factory (self);
@@ -1185,6 +1233,7 @@ adw_combo_row_set_use_subtitle (AdwComboRow *self,
     return;
 
   priv->use_subtitle = use_subtitle;
+  gtk_widget_set_visible (GTK_WIDGET (priv->current), !use_subtitle);
   selection_changed (self);
   if (!use_subtitle)
     adw_action_row_set_subtitle (ADW_ACTION_ROW (self), NULL);
@@ -10,6 +10,7 @@
 
 #include "adw-dialog-host-private.h"
 
+#include "adw-adaptive-context-private.h"
 #include "adw-bin.h"
 #include "adw-dialog-private.h"
 #include "adw-gtkbuilder-utils-private.h"
@@ -30,6 +31,8 @@ struct _AdwDialogHost
   GtkWidget *last_focus;
 
   GtkWidget *proxy;
+
+  AdwAdaptiveContext *adaptive_context;
 };
 
 static void adw_dialog_host_buildable_init (GtkBuildableIface *iface);
@@ -283,6 +286,8 @@ adw_dialog_host_unroot (GtkWidget *widget)
   AdwDialogHost *self = ADW_DIALOG_HOST (widget);
   GtkRoot *root = gtk_widget_get_root (GTK_WIDGET (widget));
 
+  adw_adaptive_context_invalidate (self->adaptive_context);
+
   g_signal_handlers_disconnect_by_func (root, close_request_cb, self);
 
   GTK_WIDGET_CLASS (adw_dialog_host_parent_class)->unroot (widget);
@@ -383,6 +388,7 @@ adw_dialog_host_dispose (GObject *object)
   g_clear_pointer (&self->dialogs_closed_during_unmap, g_ptr_array_unref);
 
   g_clear_pointer (&self->bin, gtk_widget_unparent);
+  g_clear_object (&self->adaptive_context);
 
   G_OBJECT_CLASS (adw_dialog_host_parent_class)->dispose (object);
 }
@@ -483,6 +489,10 @@ adw_dialog_host_init (AdwDialogHost *self)
 
   self->dialogs_closed_during_unmap = g_ptr_array_new ();
 
+  self->adaptive_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_DIALOG_HOST);
+  adw_adaptive_context_attach (self->adaptive_context, GTK_WIDGET (self));
+
   self->bin = adw_bin_new ();
   gtk_widget_set_parent (self->bin, GTK_WIDGET (self));
 }
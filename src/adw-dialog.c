@@ -10,6 +10,7 @@
 
 #include "adw-dialog-private.h"
 
+#include "adw-adaptive-context-private.h"
 #include "adw-bottom-sheet-private.h"
 #include "adw-breakpoint-bin-private.h"
 #include "adw-dialog-host-private.h"
@@ -139,6 +140,8 @@ typedef struct
   GtkWidget *focus_widget;
   GtkWidget *default_widget;
 
+  AdwAdaptiveContext *adaptive_context;
+
   GtkWidget *last_focus;
 
   GFunc closing_callback;
@@ -825,8 +828,12 @@ adw_dialog_root (GtkWidget *widget)
 static void
 adw_dialog_unroot (GtkWidget *widget)
 {
+  AdwDialog *self = ADW_DIALOG (widget);
+  AdwDialogPrivate *priv = adw_dialog_get_instance_private (self);
   GtkRoot *root = gtk_widget_get_root (widget);
 
+  adw_adaptive_context_invalidate (priv->adaptive_context);
+
   if (GTK_IS_WINDOW (root))
     g_signal_handlers_disconnect_by_func (root, window_notify_focus_cb, widget);
 
@@ -923,6 +930,8 @@ adw_dialog_dispose (GObject *object)
     priv->child = NULL;
   }
 
+  g_clear_object (&priv->adaptive_context);
+
   G_OBJECT_CLASS (adw_dialog_parent_class)->dispose (object);
 }
 
@@ -1305,6 +1314,10 @@ adw_dialog_init (AdwDialog *self)
 
   gtk_widget_set_limit_events (GTK_WIDGET (self), TRUE);
 
+  priv->adaptive_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_DIALOG);
+  adw_adaptive_context_attach (priv->adaptive_context, GTK_WIDGET (self));
+
   priv->child_breakpoint_bin = adw_breakpoint_bin_new ();
   gtk_widget_set_overflow (priv->child_breakpoint_bin, GTK_OVERFLOW_VISIBLE);
   adw_breakpoint_bin_set_warning_widget (ADW_BREAKPOINT_BIN (priv->child_breakpoint_bin),
@@ -6,6 +6,8 @@
  */
 
 #include "config.h"
+#include <glib/gi18n-lib.h>
+
 #include "adw-entry-row-private.h"
 
 #include "adw-animation-private.h"
@@ -547,6 +549,8 @@ adw_entry_row_dispose (GObject *object)
   if (priv->text)
     gtk_editable_finish_delegate (GTK_EDITABLE (self));
 
+  g_clear_object (&priv->buffer_signals);
+
   G_OBJECT_CLASS (adw_entry_row_parent_class)->dispose (object);
 }
 
@@ -726,39 +730,142 @@ adw_entry_row_class_init (AdwEntryRowClass *klass)
   g_signal_set_va_marshaller (signals[SIGNAL_ENTRY_ACTIVATED],
                               G_TYPE_FROM_CLASS (klass),
                               adw_marshal_VOID__VOIDv);
+}
+
+static GtkWidget *
+create_title_label (AdwEntryRow *self)
+{
+  GtkWidget *label = gtk_label_new (NULL);
 
-  gtk_widget_class_set_template_from_resource (widget_class,
-                                               "/org/gnome/Adwaita/ui/adw-entry-row.ui");
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, header);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, prefixes);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, suffixes);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, editable_area);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, text);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, empty_title);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, title);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, edit_icon);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, apply_button);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, indicator);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwEntryRow, buffer_signals);
-
-  gtk_widget_class_bind_template_callback (widget_class, pressed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, text_state_flags_changed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, text_keynav_failed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, text_changed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, update_empty);
-  gtk_widget_class_bind_template_callback (widget_class, text_activated_cb);
-  gtk_widget_class_bind_template_callback (widget_class, apply_button_clicked_cb);
-
-  g_type_ensure (ADW_TYPE_GIZMO);
+  gtk_label_set_ellipsize (GTK_LABEL (label), PANGO_ELLIPSIZE_END);
+  gtk_label_set_xalign (GTK_LABEL (label), 0);
+  gtk_label_set_mnemonic_widget (GTK_LABEL (label), GTK_WIDGET (self));
+  gtk_widget_set_halign (label, GTK_ALIGN_START);
+  gtk_widget_set_can_target (label, FALSE);
+
+  return label;
 }
 
+static void
+sync_title (AdwEntryRow *self)
+{
+  AdwEntryRowPrivate *priv = adw_entry_row_get_instance_private (self);
+  AdwPreferencesRow *row = ADW_PREFERENCES_ROW (self);
+  const char *title = adw_preferences_row_get_title (row);
+  gboolean use_markup = adw_preferences_row_get_use_markup (row);
+  gboolean use_underline = adw_preferences_row_get_use_underline (row);
+
+  gtk_label_set_label (GTK_LABEL (priv->empty_title), title);
+  gtk_label_set_use_markup (GTK_LABEL (priv->empty_title), use_markup);
+  gtk_label_set_use_underline (GTK_LABEL (priv->empty_title), use_underline);
+
+  gtk_label_set_label (GTK_LABEL (priv->title), title);
+  gtk_label_set_use_markup (GTK_LABEL (priv->title), use_markup);
+  gtk_label_set_use_underline (GTK_LABEL (priv->title), use_underline);
+}
+
+static void
+notify_cb (AdwEntryRow *self,
+           GParamSpec  *pspec)
+{
+  const char *name = g_param_spec_get_name (pspec);
+
+  if (!g_strcmp0 (name, "title") ||
+      !g_strcmp0 (name, "use-markup") ||
+      !g_strcmp0 (name, "use-underline"))
+    sync_title (self);
+}
+
+/* Entry rows are often created by the hundreds, so the widgets are created
+ * directly instead of going through GtkBuilder */
 static void
 adw_entry_row_init (AdwEntryRow *self)
 {
   AdwEntryRowPrivate *priv = adw_entry_row_get_instance_private (self);
   AdwAnimationTarget *target;
+  GtkEventController *gesture;
+
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (self), TRUE);
+  gtk_widget_add_css_class (GTK_WIDGET (self), "entry");
+
+  gesture = GTK_EVENT_CONTROLLER (gtk_gesture_click_new ());
+  g_signal_connect (gesture, "pressed", G_CALLBACK (pressed_cb), self);
+  gtk_widget_add_controller (GTK_WIDGET (self), gesture);
+
+  priv->header = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0);
+  gtk_widget_set_valign (priv->header, GTK_ALIGN_CENTER);
+  gtk_widget_add_css_class (priv->header, "header");
+  gtk_list_box_row_set_child (GTK_LIST_BOX_ROW (self), priv->header);
+
+  priv->prefixes = GTK_BOX (gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0));
+  gtk_widget_set_visible (GTK_WIDGET (priv->prefixes), FALSE);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->prefixes), "prefixes");
+  gtk_box_append (GTK_BOX (priv->header), GTK_WIDGET (priv->prefixes));
+
+  priv->editable_area = g_object_new (ADW_TYPE_GIZMO,
+                                      "hexpand", TRUE,
+                                      "overflow", GTK_OVERFLOW_HIDDEN,
+                                      NULL);
+  gtk_widget_add_css_class (priv->editable_area, "editable-area");
+  gtk_box_append (GTK_BOX (priv->header), priv->editable_area);
+
+  priv->empty_title = create_title_label (self);
+  gtk_label_set_lines (GTK_LABEL (priv->empty_title), 0);
+  gtk_widget_add_css_class (priv->empty_title, "title");
+  gtk_widget_add_css_class (priv->empty_title, "dimmed");
+  gtk_widget_set_parent (priv->empty_title, priv->editable_area);
+
+  priv->title = create_title_label (self);
+  gtk_widget_add_css_class (priv->title, "subtitle");
+  gtk_widget_set_parent (priv->title, priv->editable_area);
+
+  priv->text = g_object_new (GTK_TYPE_TEXT,
+                             "accessible-role", GTK_ACCESSIBLE_ROLE_TEXT_BOX,
+                             "enable-undo", TRUE,
+                             "hexpand", TRUE,
+                             "vexpand", TRUE,
+                             "valign", GTK_ALIGN_BASELINE_FILL,
+                             NULL);
+  gtk_accessible_update_relation (GTK_ACCESSIBLE (priv->text),
+                                  GTK_ACCESSIBLE_RELATION_LABELLED_BY, priv->title, NULL,
+                                  -1);
+  gtk_widget_set_parent (priv->text, priv->editable_area);
+
+  priv->indicator = gtk_image_new ();
+  gtk_widget_set_valign (priv->indicator, GTK_ALIGN_CENTER);
+  gtk_widget_add_css_class (priv->indicator, "indicator");
+  gtk_widget_set_parent (priv->indicator, priv->editable_area);
+
+  priv->apply_button = gtk_button_new_from_icon_name ("adw-entry-apply-symbolic");
+  gtk_widget_set_valign (priv->apply_button, GTK_ALIGN_CENTER);
+  /* Translators: tooltip of the apply button in entry row */
+  gtk_widget_set_tooltip_text (priv->apply_button, _("Apply"));
+  gtk_widget_set_focus_on_click (priv->apply_button, FALSE);
+  gtk_widget_add_css_class (priv->apply_button, "suggested-action");
+  gtk_widget_add_css_class (priv->apply_button, "circular");
+  gtk_widget_add_css_class (priv->apply_button, "apply-button");
+  g_signal_connect_swapped (priv->apply_button, "clicked", G_CALLBACK (apply_button_clicked_cb), self);
+  gtk_widget_set_parent (priv->apply_button, priv->editable_area);
+
+  priv->edit_icon = g_object_new (GTK_TYPE_IMAGE,
+                                  "accessible-role", GTK_ACCESSIBLE_ROLE_PRESENTATION,
+                                  "icon-name", "adw-entry-edit-symbolic",
+                                  "valign", GTK_ALIGN_CENTER,
+                                  "can-target", FALSE,
+                                  NULL);
+  gtk_widget_add_css_class (priv->edit_icon, "edit-icon");
+  gtk_widget_set_parent (priv->edit_icon, priv->editable_area);
+
+  priv->suffixes = GTK_BOX (gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0));
+  gtk_widget_set_visible (GTK_WIDGET (priv->suffixes), FALSE);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->suffixes), "suffixes");
+  gtk_box_append (GTK_BOX (priv->header), GTK_WIDGET (priv->suffixes));
+
+  priv->buffer_signals = g_signal_group_new (GTK_TYPE_ENTRY_BUFFER);
+
+  sync_title (self);
+  g_signal_connect (self, "notify", G_CALLBACK (notify_cb), NULL);
 
-  gtk_widget_init_template (GTK_WIDGET (self));
   gtk_editable_init_delegate (GTK_EDITABLE (self));
 
   gtk_widget_set_child_visible (priv->indicator, FALSE);
@@ -790,6 +897,12 @@ adw_entry_row_init (AdwEntryRow *self)
                           priv->buffer_signals, "target",
                           G_BINDING_SYNC_CREATE);
 
+  g_signal_connect_swapped (priv->text, "activate", G_CALLBACK (text_activated_cb), self);
+  g_signal_connect_swapped (priv->text, "state-flags-changed", G_CALLBACK (text_state_flags_changed_cb), self);
+  g_signal_connect_swapped (priv->text, "keynav-failed", G_CALLBACK (text_keynav_failed_cb), self);
+  g_signal_connect_swapped (priv->text, "changed", G_CALLBACK (text_changed_cb), self);
+  g_signal_connect_swapped (priv->text, "notify::editable", G_CALLBACK (update_empty), self);
+
   update_empty (self);
 }
 
@@ -58,6 +58,7 @@ typedef struct
   GtkBox *suffixes;
   GtkBox *prefixes;
   GtkListBox *list;
+  GtkRevealer *revealer;
   AdwActionRow *action_row;
   GtkSwitch *enable_switch;
   GtkImage *image;
@@ -292,17 +293,6 @@ adw_expander_row_class_init (AdwExpanderRowClass *klass)
                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
   g_object_class_install_properties (object_class, LAST_PROP, props);
-
-  gtk_widget_class_set_template_from_resource (widget_class,
-                                               "/org/gnome/Adwaita/ui/adw-expander-row.ui");
-  gtk_widget_class_bind_template_child_private (widget_class, AdwExpanderRow, action_row);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwExpanderRow, box);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwExpanderRow, suffixes);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwExpanderRow, list);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwExpanderRow, image);
-  gtk_widget_class_bind_template_child_private (widget_class, AdwExpanderRow, enable_switch);
-  gtk_widget_class_bind_template_callback (widget_class, activate_cb);
-  gtk_widget_class_bind_template_callback (widget_class, keynav_failed_cb);
 }
 
 #define NOTIFY(func, prop) \
@@ -316,14 +306,122 @@ NOTIFY (notify_icon_name_cb, PROP_ICON_NAME);
 NOTIFY (notify_title_lines_cb, PROP_TITLE_LINES);
 NOTIFY (notify_subtitle_lines_cb, PROP_SUBTITLE_LINES);
 
+static void
+notify_cb (AdwExpanderRow *self,
+           GParamSpec     *pspec)
+{
+  AdwExpanderRowPrivate *priv = adw_expander_row_get_instance_private (self);
+  AdwPreferencesRow *row = ADW_PREFERENCES_ROW (self);
+  const char *name = g_param_spec_get_name (pspec);
+
+  if (!g_strcmp0 (name, "title"))
+    adw_preferences_row_set_title (ADW_PREFERENCES_ROW (priv->action_row),
+                                   adw_preferences_row_get_title (row));
+  else if (!g_strcmp0 (name, "use-underline"))
+    adw_preferences_row_set_use_underline (ADW_PREFERENCES_ROW (priv->action_row),
+                                           adw_preferences_row_get_use_underline (row));
+  else if (!g_strcmp0 (name, "title-selectable"))
+    gtk_list_box_row_set_selectable (GTK_LIST_BOX_ROW (priv->action_row),
+                                     adw_preferences_row_get_title_selectable (row));
+  else if (!g_strcmp0 (name, "use-markup"))
+    adw_preferences_row_set_use_markup (ADW_PREFERENCES_ROW (priv->action_row),
+                                        adw_preferences_row_get_use_markup (row));
+}
+
+static void
+enable_switch_notify_cb (AdwExpanderRow *self,
+                         GParamSpec     *pspec)
+{
+  AdwExpanderRowPrivate *priv = adw_expander_row_get_instance_private (self);
+  const char *name = g_param_spec_get_name (pspec);
+
+  if (!g_strcmp0 (name, "active"))
+    adw_expander_row_set_enable_expansion (self, gtk_switch_get_active (priv->enable_switch));
+  else if (!g_strcmp0 (name, "visible"))
+    adw_expander_row_set_show_enable_switch (self, gtk_widget_get_visible (GTK_WIDGET (priv->enable_switch)));
+}
+
+/* Expander rows are often created by the hundreds, so the widgets are created
+ * directly instead of going through GtkBuilder */
 static void
 adw_expander_row_init (AdwExpanderRow *self)
 {
   AdwExpanderRowPrivate *priv = adw_expander_row_get_instance_private (self);
+  AdwPreferencesRow *row = ADW_PREFERENCES_ROW (self);
+  GtkWidget *header_list;
 
   priv->prefixes = NULL;
 
-  gtk_widget_init_template (GTK_WIDGET (self));
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (self), FALSE);
+  gtk_widget_add_css_class (GTK_WIDGET (self), "empty");
+  gtk_widget_add_css_class (GTK_WIDGET (self), "expander");
+
+  priv->box = GTK_BOX (gtk_box_new (GTK_ORIENTATION_VERTICAL, 0));
+  gtk_list_box_row_set_child (GTK_LIST_BOX_ROW (self), GTK_WIDGET (priv->box));
+
+  header_list = g_object_new (GTK_TYPE_LIST_BOX,
+                              "accessible-role", GTK_ACCESSIBLE_ROLE_GENERIC,
+                              "selection-mode", GTK_SELECTION_NONE,
+                              NULL);
+  gtk_box_append (priv->box, header_list);
+
+  /* The header row must be activatable and focusable to toggle expansion by
+   * clicking it or via keyboard activation */
+  priv->action_row = ADW_ACTION_ROW (adw_action_row_new ());
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (priv->action_row), TRUE);
+  gtk_widget_set_can_focus (GTK_WIDGET (priv->action_row), TRUE);
+  adw_preferences_row_set_title (ADW_PREFERENCES_ROW (priv->action_row),
+                                 adw_preferences_row_get_title (row));
+  adw_preferences_row_set_use_underline (ADW_PREFERENCES_ROW (priv->action_row),
+                                         adw_preferences_row_get_use_underline (row));
+  adw_preferences_row_set_use_markup (ADW_PREFERENCES_ROW (priv->action_row),
+                                      adw_preferences_row_get_use_markup (row));
+  gtk_list_box_row_set_selectable (GTK_LIST_BOX_ROW (priv->action_row),
+                                   adw_preferences_row_get_title_selectable (row));
+  gtk_accessible_update_state (GTK_ACCESSIBLE (priv->action_row),
+                               GTK_ACCESSIBLE_STATE_EXPANDED, FALSE,
+                               -1);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->action_row), "header");
+  gtk_list_box_append (GTK_LIST_BOX (header_list), GTK_WIDGET (priv->action_row));
+
+  priv->suffixes = GTK_BOX (gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0));
+  gtk_widget_set_visible (GTK_WIDGET (priv->suffixes), FALSE);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->suffixes), "suffixes");
+  adw_action_row_add_suffix (priv->action_row, GTK_WIDGET (priv->suffixes));
+
+  priv->enable_switch = GTK_SWITCH (gtk_switch_new ());
+  gtk_widget_set_valign (GTK_WIDGET (priv->enable_switch), GTK_ALIGN_CENTER);
+  gtk_widget_set_visible (GTK_WIDGET (priv->enable_switch), FALSE);
+  gtk_accessible_update_relation (GTK_ACCESSIBLE (priv->enable_switch),
+                                  GTK_ACCESSIBLE_RELATION_LABELLED_BY, self, NULL,
+                                  GTK_ACCESSIBLE_RELATION_DESCRIBED_BY, self, NULL,
+                                  -1);
+  adw_action_row_add_suffix (priv->action_row, GTK_WIDGET (priv->enable_switch));
+
+  priv->image = g_object_new (GTK_TYPE_IMAGE,
+                              "accessible-role", GTK_ACCESSIBLE_ROLE_PRESENTATION,
+                              "icon-name", "adw-expander-arrow-symbolic",
+                              "sensitive", FALSE,
+                              NULL);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->image), "expander-row-arrow");
+  adw_action_row_add_suffix (priv->action_row, GTK_WIDGET (priv->image));
+
+  priv->revealer = GTK_REVEALER (gtk_revealer_new ());
+  gtk_revealer_set_transition_type (priv->revealer, GTK_REVEALER_TRANSITION_TYPE_SLIDE_UP);
+  gtk_box_append (priv->box, GTK_WIDGET (priv->revealer));
+
+  priv->list = GTK_LIST_BOX (gtk_list_box_new ());
+  gtk_list_box_set_selection_mode (priv->list, GTK_SELECTION_NONE);
+  gtk_widget_add_css_class (GTK_WIDGET (priv->list), "nested");
+  gtk_revealer_set_child (priv->revealer, GTK_WIDGET (priv->list));
+
+  g_signal_connect_after (self, "activate", G_CALLBACK (activate_cb), NULL);
+  g_signal_connect (self, "notify", G_CALLBACK (notify_cb), NULL);
+  g_signal_connect_object (header_list, "row-activated", G_CALLBACK (activate_cb), self,
+                           G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+  g_signal_connect_swapped (header_list, "keynav-failed", G_CALLBACK (keynav_failed_cb), self);
+  g_signal_connect_swapped (priv->list, "keynav-failed", G_CALLBACK (keynav_failed_cb), self);
+  g_signal_connect_swapped (priv->enable_switch, "notify", G_CALLBACK (enable_switch_notify_cb), self);
 
   adw_expander_row_set_enable_expansion (self, TRUE);
   adw_expander_row_set_expanded (self, FALSE);
@@ -648,6 +746,8 @@ adw_expander_row_set_expanded (AdwExpanderRow *self,
 
   priv->expanded = expanded;
 
+  gtk_revealer_set_reveal_child (priv->revealer, expanded);
+
   if (expanded)
     gtk_widget_set_state_flags (GTK_WIDGET (self), GTK_STATE_FLAG_CHECKED, FALSE);
   else
@@ -704,6 +804,9 @@ adw_expander_row_set_enable_expansion (AdwExpanderRow *self,
 
   priv->enable_expansion = enable_expansion;
 
+  gtk_switch_set_active (priv->enable_switch, enable_expansion);
+  gtk_widget_set_sensitive (GTK_WIDGET (priv->image), enable_expansion);
+
   adw_expander_row_set_expanded (self, priv->enable_expansion);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ENABLE_EXPANSION]);
@@ -753,6 +856,8 @@ adw_expander_row_set_show_enable_switch (AdwExpanderRow *self,
 
   priv->show_enable_switch = show_enable_switch;
 
+  gtk_widget_set_visible (GTK_WIDGET (priv->enable_switch), show_enable_switch);
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SHOW_ENABLE_SWITCH]);
 }
 
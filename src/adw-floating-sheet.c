@@ -10,6 +10,7 @@
 
 #include "adw-floating-sheet-private.h"
 
+#include "adw-adaptive-context-private.h"
 #include "adw-animation-target.h"
 #include "adw-animation-util-private.h"
 #include "adw-gizmo-private.h"
@@ -42,6 +43,8 @@ struct _AdwFloatingSheet
   GtkWidget *sheet_bin;
   GtkWidget *dimming;
 
+  AdwAdaptiveContext *sheet_context;
+
   gboolean open;
   gboolean can_close;
 
@@ -229,6 +232,16 @@ adw_floating_sheet_size_allocate (GtkWidget *widget,
   gtk_widget_allocate (self->sheet_bin, sheet_width, sheet_height, baseline, transform);
 }
 
+static void
+adw_floating_sheet_unroot (GtkWidget *widget)
+{
+  AdwFloatingSheet *self = ADW_FLOATING_SHEET (widget);
+
+  adw_adaptive_context_invalidate (self->sheet_context);
+
+  GTK_WIDGET_CLASS (adw_floating_sheet_parent_class)->unroot (widget);
+}
+
 static void
 adw_floating_sheet_dispose (GObject *object)
 {
@@ -237,6 +250,7 @@ adw_floating_sheet_dispose (GObject *object)
   g_clear_pointer (&self->dimming, gtk_widget_unparent);
   g_clear_pointer (&self->sheet_bin, gtk_widget_unparent);
   g_clear_object (&self->open_animation);
+  g_clear_object (&self->sheet_context);
   self->child = NULL;
 
   G_OBJECT_CLASS (adw_floating_sheet_parent_class)->dispose (object);
@@ -298,6 +312,7 @@ adw_floating_sheet_class_init (AdwFloatingSheetClass *klass)
   object_class->get_property = adw_floating_sheet_get_property;
   object_class->set_property = adw_floating_sheet_set_property;
 
+  widget_class->unroot = adw_floating_sheet_unroot;
   widget_class->contains = adw_widget_contains_passthrough;
   widget_class->measure = adw_floating_sheet_measure;
   widget_class->size_allocate = adw_floating_sheet_size_allocate;
@@ -371,6 +386,10 @@ adw_floating_sheet_init (AdwFloatingSheet *self)
   gtk_widget_set_child_visible (self->sheet_bin, FALSE);
   gtk_widget_set_parent (self->sheet_bin, GTK_WIDGET (self));
 
+  self->sheet_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_SHEET);
+  adw_adaptive_context_attach (self->sheet_context, self->sheet_bin);
+
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc) open_animation_cb,
                                               self,
                                               NULL);
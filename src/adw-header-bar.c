@@ -23,6 +23,7 @@
 
 #include "adw-header-bar.h"
 
+#include "adw-adaptive-context-private.h"
 #include "adw-adaptive-preview-private.h"
 #include "adw-back-button-private.h"
 #include "adw-bin.h"
@@ -30,7 +31,6 @@
 #include "adw-dialog.h"
 #include "adw-dialog-host-private.h"
 #include "adw-enums.h"
-#include "adw-floating-sheet-private.h"
 #include "adw-gizmo-private.h"
 #include "adw-gtkbuilder-utils-private.h"
 #include "adw-navigation-split-view.h"
@@ -155,11 +155,6 @@
 #define MOBILE_WINDOW_WIDTH  480
 #define MOBILE_WINDOW_HEIGHT 800
 
-typedef struct {
-  GtkWidget *split_view;
-  gboolean is_sidebar;
-} SplitViewData;
-
 struct _AdwHeaderBar {
   GtkWidget parent_instance;
 
@@ -196,7 +191,7 @@ struct _AdwHeaderBar {
   GtkWidget *adaptive_preview;
   GtkWidget *dialog_host;
 
-  GSList *split_views;
+  AdwAdaptiveContext *context;
 };
 
 enum {
@@ -364,34 +359,40 @@ static void
 update_start_title_buttons (AdwHeaderBar *self)
 {
   gboolean show = self->show_start_title_buttons;
-  GSList *l;
+  GSList *split_views = NULL, *l;
 
   if (self->adaptive_preview &&
       !adw_adaptive_preview_get_window_controls (ADW_ADAPTIVE_PREVIEW (self->adaptive_preview))) {
     show = FALSE;
   }
 
-  for (l = self->split_views; l; l = l->next) {
-    SplitViewData *data = l->data;
+  if (self->context)
+    split_views = adw_adaptive_context_get_split_views (self->context);
+
+  for (l = split_views; l; l = l->next) {
+    AdwAdaptiveContext *context = l->data;
+    GtkWidget *owner = adw_adaptive_context_get_owner (context);
+    gboolean is_sidebar =
+      adw_adaptive_context_get_kind (context) == ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR;
 
-    if (ADW_IS_NAVIGATION_SPLIT_VIEW (data->split_view)) {
-      AdwNavigationSplitView *split_view = ADW_NAVIGATION_SPLIT_VIEW (data->split_view);
+    if (ADW_IS_NAVIGATION_SPLIT_VIEW (owner)) {
+      AdwNavigationSplitView *split_view = ADW_NAVIGATION_SPLIT_VIEW (owner);
       gboolean collapsed = adw_navigation_split_view_get_collapsed (split_view);
       GtkPackType sidebar_pos = adw_navigation_split_view_get_sidebar_position (split_view);
 
-      if (data->is_sidebar)
+      if (is_sidebar)
         show &= collapsed || sidebar_pos == GTK_PACK_START;
       else
         show &= collapsed || sidebar_pos == GTK_PACK_END;
     }
 
-    if (ADW_IS_OVERLAY_SPLIT_VIEW (data->split_view)) {
-      AdwOverlaySplitView *split_view = ADW_OVERLAY_SPLIT_VIEW (data->split_view);
+    if (ADW_IS_OVERLAY_SPLIT_VIEW (owner)) {
+      AdwOverlaySplitView *split_view = ADW_OVERLAY_SPLIT_VIEW (owner);
       gboolean collapsed = adw_overlay_split_view_get_collapsed (split_view);
       gboolean show_sidebar = adw_overlay_split_view_get_show_sidebar (split_view);
       GtkPackType sidebar_pos = adw_overlay_split_view_get_sidebar_position (split_view);
 
-      if (data->is_sidebar)
+      if (is_sidebar)
         show &= sidebar_pos == GTK_PACK_START;
       else
         show &= collapsed || !show_sidebar || sidebar_pos == GTK_PACK_END;
@@ -412,34 +413,40 @@ static void
 update_end_title_buttons (AdwHeaderBar *self)
 {
   gboolean show = self->show_end_title_buttons;
-  GSList *l;
+  GSList *split_views = NULL, *l;
 
   if (self->adaptive_preview &&
       !adw_adaptive_preview_get_window_controls (ADW_ADAPTIVE_PREVIEW (self->adaptive_preview))) {
     show = FALSE;
   }
 
-  for (l = self->split_views; l; l = l->next) {
-    SplitViewData *data = l->data;
+  if (self->context)
+    split_views = adw_adaptive_context_get_split_views (self->context);
 
-    if (ADW_IS_NAVIGATION_SPLIT_VIEW (data->split_view)) {
-      AdwNavigationSplitView *split_view = ADW_NAVIGATION_SPLIT_VIEW (data->split_view);
+  for (l = split_views; l; l = l->next) {
+    AdwAdaptiveContext *context = l->data;
+    GtkWidget *owner = adw_adaptive_context_get_owner (context);
+    gboolean is_sidebar =
+      adw_adaptive_context_get_kind (context) == ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR;
+
+    if (ADW_IS_NAVIGATION_SPLIT_VIEW (owner)) {
+      AdwNavigationSplitView *split_view = ADW_NAVIGATION_SPLIT_VIEW (owner);
       gboolean collapsed = adw_navigation_split_view_get_collapsed (split_view);
       GtkPackType sidebar_pos = adw_navigation_split_view_get_sidebar_position (split_view);
 
-      if (data->is_sidebar)
+      if (is_sidebar)
         show &= collapsed || sidebar_pos == GTK_PACK_END;
       else
         show &= collapsed || sidebar_pos == GTK_PACK_START;
     }
 
-    if (ADW_IS_OVERLAY_SPLIT_VIEW (data->split_view)) {
-      AdwOverlaySplitView *split_view = ADW_OVERLAY_SPLIT_VIEW (data->split_view);
+    if (ADW_IS_OVERLAY_SPLIT_VIEW (owner)) {
+      AdwOverlaySplitView *split_view = ADW_OVERLAY_SPLIT_VIEW (owner);
       gboolean collapsed = adw_overlay_split_view_get_collapsed (split_view);
       gboolean show_sidebar = adw_overlay_split_view_get_show_sidebar (split_view);
       GtkPackType sidebar_pos = adw_overlay_split_view_get_sidebar_position (split_view);
 
-      if (data->is_sidebar)
+      if (is_sidebar)
         show &= sidebar_pos == GTK_PACK_END;
       else
         show &= collapsed || !show_sidebar || sidebar_pos == GTK_PACK_START;
@@ -529,69 +536,30 @@ construct_title_label (AdwHeaderBar *self)
   update_title (self);
 }
 
-static GtkWidget *
-find_sheet (GtkWidget *widget)
-{
-  GtkWidget *sheet, *bin, *parent;
-
-  sheet = adw_widget_get_ancestor (widget, ADW_TYPE_BOTTOM_SHEET, TRUE, FALSE);
-
-  if (!sheet)
-    sheet = adw_widget_get_ancestor (widget, ADW_TYPE_FLOATING_SHEET, TRUE, FALSE);
-
-  if (ADW_IS_BOTTOM_SHEET (sheet))
-    bin = adw_bottom_sheet_get_sheet_bin (ADW_BOTTOM_SHEET (sheet));
-  else if (ADW_IS_FLOATING_SHEET (sheet))
-    bin = adw_floating_sheet_get_sheet_bin (ADW_FLOATING_SHEET (sheet));
-  else
-    return NULL;
-
-  if (bin && (widget == bin || gtk_widget_is_ancestor (widget, bin)))
-    return sheet;
-
-  parent = gtk_widget_get_parent (sheet);
-  if (parent)
-    return find_sheet (parent);
-
-  return NULL;
-}
-
-static GtkWidget *
-find_adaptive_preview (GtkWidget *widget, GtkWidget **screen_view)
-{
-  GtkWidget *preview, *screen;
-
-  preview = adw_widget_get_ancestor (widget, ADW_TYPE_ADAPTIVE_PREVIEW, TRUE, TRUE);
-  if (!preview)
-    return NULL;
-
-  screen = adw_adaptive_preview_get_screen (ADW_ADAPTIVE_PREVIEW (preview));
-
-  if (gtk_widget_is_ancestor (widget, screen)) {
-    *screen_view = screen;
-    return preview;
-  }
-
-  return NULL;
-}
-
 static void
 adw_header_bar_root (GtkWidget *widget)
 {
   AdwHeaderBar *self = ADW_HEADER_BAR (widget);
-  GtkWidget *parent, *screen_view = NULL;
+  AdwAdaptiveContext *context;
 
   GTK_WIDGET_CLASS (adw_header_bar_parent_class)->root (widget);
 
-  self->title_navigation_page =
-    adw_widget_get_ancestor (widget, ADW_TYPE_NAVIGATION_PAGE, TRUE, TRUE);
+  context = adw_adaptive_context_lookup (widget);
+
+  if (context) {
+    self->context = g_object_ref (context);
 
-  self->dialog = adw_widget_get_ancestor (widget, ADW_TYPE_DIALOG, TRUE, FALSE);
-  self->adaptive_preview = find_adaptive_preview (widget, &screen_view);
-  self->sheet = find_sheet (widget);
+    self->title_navigation_page = adw_adaptive_context_get_navigation_page (context);
+    self->dialog = adw_adaptive_context_get_dialog (context);
+    self->adaptive_preview = adw_adaptive_context_get_adaptive_preview (context);
+    self->sheet = adw_adaptive_context_get_sheet (context);
 
-  if (!self->dialog && !self->adaptive_preview && !self->sheet)
-    self->dialog_host = adw_widget_get_ancestor (widget, ADW_TYPE_DIALOG_HOST, TRUE, FALSE);
+    if (!self->dialog && !self->adaptive_preview && !self->sheet)
+      self->dialog_host = adw_adaptive_context_get_dialog_host (context);
+
+    g_signal_connect_swapped (context, "changed",
+                              G_CALLBACK (update_title_buttons), widget);
+  }
 
   if (ADW_IS_DIALOG_HOST (self->dialog_host)) {
       g_signal_connect_swapped (self->dialog_host, "notify::visible-dialog",
@@ -603,11 +571,6 @@ adw_header_bar_root (GtkWidget *widget)
                               G_CALLBACK (update_title), widget);
   }
 
-  if (self->adaptive_preview) {
-    g_signal_connect_swapped (self->adaptive_preview, "notify::window-controls",
-                              G_CALLBACK (update_title_buttons), widget);
-  }
-
   if (self->title_navigation_page) {
     g_signal_connect_swapped (self->title_navigation_page, "notify::title",
                               G_CALLBACK (update_title), widget);
@@ -622,64 +585,6 @@ adw_header_bar_root (GtkWidget *widget)
                                 G_CALLBACK (update_title), widget);
   }
 
-  parent = gtk_widget_get_parent (widget);
-
-  while (parent != NULL) {
-    GtkWidget *split_view = NULL;
-    gboolean is_sidebar = FALSE;
-
-    if (GTK_IS_NATIVE (parent) ||
-        parent == self->sheet ||
-        parent == screen_view) {
-      break;
-    }
-
-    if (ADW_IS_NAVIGATION_SPLIT_VIEW (parent)) {
-      AdwNavigationPage *sidebar;
-
-      split_view = parent;
-
-      g_signal_connect_swapped (split_view, "notify::collapsed",
-                                G_CALLBACK (update_title_buttons), widget);
-      g_signal_connect_swapped (split_view, "notify::sidebar-position",
-                                G_CALLBACK (update_title_buttons), widget);
-
-      sidebar = adw_navigation_split_view_get_sidebar (ADW_NAVIGATION_SPLIT_VIEW (split_view));
-
-      if (sidebar) {
-        is_sidebar = widget == GTK_WIDGET (sidebar) ||
-                     (sidebar && gtk_widget_is_ancestor (widget, GTK_WIDGET (sidebar)));
-      }
-    } else if (ADW_IS_OVERLAY_SPLIT_VIEW (parent)) {
-      GtkWidget *sidebar;
-
-      split_view = parent;
-
-      g_signal_connect_swapped (split_view, "notify::collapsed",
-                                G_CALLBACK (update_title_buttons), widget);
-      g_signal_connect_swapped (split_view, "notify::sidebar-position",
-                                G_CALLBACK (update_title_buttons), widget);
-      g_signal_connect_swapped (split_view, "notify::show-sidebar",
-                                G_CALLBACK (update_title_buttons), widget);
-
-      sidebar = adw_overlay_split_view_get_sidebar (ADW_OVERLAY_SPLIT_VIEW (split_view));
-
-      is_sidebar = widget == sidebar ||
-                   (sidebar && gtk_widget_is_ancestor (widget, sidebar));
-    }
-
-    if (split_view) {
-      SplitViewData *data = g_new0 (SplitViewData, 1);
-
-      data->split_view = split_view;
-      data->is_sidebar = is_sidebar;
-
-      self->split_views = g_slist_prepend (self->split_views, data);
-    }
-
-    parent = gtk_widget_get_parent (parent);
-  }
-
   update_title (self);
   update_title_buttons (self);
   update_decoration_layout (self, TRUE, TRUE);
@@ -689,7 +594,6 @@ static void
 adw_header_bar_unroot (GtkWidget *widget)
 {
   AdwHeaderBar *self = ADW_HEADER_BAR (widget);
-  GSList *l;
 
   if (self->title_navigation_page) {
     g_signal_handlers_disconnect_by_func (self->title_navigation_page,
@@ -707,32 +611,23 @@ adw_header_bar_unroot (GtkWidget *widget)
                                           update_title, widget);
   }
 
-  if (self->adaptive_preview) {
-    g_signal_handlers_disconnect_by_func (self->adaptive_preview,
-                                          update_title_buttons, widget);
-  }
-
   if (self->dialog_host) {
     g_signal_handlers_disconnect_by_func (self->dialog_host,
                                           update_visible_dialog, widget);
   }
 
+  if (self->context) {
+    g_signal_handlers_disconnect_by_func (self->context,
+                                          update_title_buttons, widget);
+    g_clear_object (&self->context);
+  }
+
   self->title_navigation_page = NULL;
   self->dialog = NULL;
   self->sheet = NULL;
+  self->adaptive_preview = NULL;
   self->dialog_host = NULL;
 
-  for (l = self->split_views; l; l = l->next) {
-    SplitViewData *data = l->data;
-
-    g_signal_handlers_disconnect_by_func (data->split_view,
-                                          update_title_buttons, widget);
-
-    g_free (data);
-  }
-
-  g_clear_pointer (&self->split_views, g_slist_free);
-
   GTK_WIDGET_CLASS (adw_header_bar_parent_class)->unroot (widget);
 }
 
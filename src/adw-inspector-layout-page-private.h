@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include "adw-bin.h"
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_INSPECTOR_LAYOUT_PAGE (adw_inspector_layout_page_get_type())
+
+G_DECLARE_FINAL_TYPE (AdwInspectorLayoutPage, adw_inspector_layout_page, ADW, INSPECTOR_LAYOUT_PAGE, AdwBin)
+
+G_END_DECLS
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+#include <glib/gi18n-lib.h>
+
+#include "adw-inspector-layout-page-private.h"
+
+#include <adwaita.h>
+#include "adw-layout-profiler-private.h"
+
+#define MAX_ROWS 20
+#define REFRESH_INTERVAL 1
+
+/*
+ * AdwInspectorLayoutPage:
+ *
+ * An inspector page listing the adaptive containers that took the most time
+ * to measure and allocate in the inspected window, as recorded by the layout
+ * profiler.
+ *
+ * The list is refreshed every second while the page is visible.
+ */
+
+struct _AdwInspectorLayoutPage
+{
+  AdwBin parent_instance;
+
+  AdwPreferencesGroup *group;
+  AdwActionRow *rows[MAX_ROWS];
+  GtkWidget *placeholder;
+
+  GObject *object;
+
+  guint refresh_id;
+};
+
+G_DEFINE_FINAL_TYPE (AdwInspectorLayoutPage, adw_inspector_layout_page, ADW_TYPE_BIN)
+
+enum {
+  PROP_0,
+  PROP_TITLE,
+  PROP_OBJECT,
+  LAST_PROP,
+};
+
+static GParamSpec *props[LAST_PROP];
+
+typedef struct {
+  GtkWidget *widget;
+  AdwLayoutStats stats;
+} Entry;
+
+static inline gint64
+get_total_time (Entry *entry)
+{
+  return entry->stats.measure_time + entry->stats.allocate_time;
+}
+
+static int
+compare_entries (gconstpointer a,
+                 gconstpointer b)
+{
+  gint64 time_a = get_total_time ((Entry *) a);
+  gint64 time_b = get_total_time ((Entry *) b);
+
+  return (time_a < time_b) - (time_a > time_b);
+}
+
+static void
+collect_entries (GtkWidget *widget,
+                 GArray    *entries)
+{
+  GtkWidget *child;
+  Entry entry;
+
+  if (adw_layout_profiler_get_stats (widget, &entry.stats)) {
+    entry.widget = widget;
+    g_array_append_val (entries, entry);
+  }
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child))
+    collect_entries (child, entries);
+}
+
+static void
+update_row (AdwActionRow *row,
+            Entry        *entry)
+{
+  const char *title = G_OBJECT_TYPE_NAME (entry->widget);
+  char *subtitle;
+
+  /* This runs every second, avoid relayouting the inspector each time */
+  if (g_strcmp0 (adw_preferences_row_get_title (ADW_PREFERENCES_ROW (row)), title))
+    adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), title);
+
+  /* Translators: the subtitle of each row in the layout inspector page */
+  subtitle = g_strdup_printf (_("Measured %u times in %.2f ms, allocated %u times in %.2f ms"),
+                              entry->stats.n_measures,
+                              entry->stats.measure_time / 1000000.0,
+                              entry->stats.n_allocations,
+                              entry->stats.allocate_time / 1000000.0);
+
+  if (g_strcmp0 (adw_action_row_get_subtitle (row), subtitle))
+    adw_action_row_set_subtitle (row, subtitle);
+
+  g_free (subtitle);
+
+  gtk_widget_set_visible (GTK_WIDGET (row), TRUE);
+}
+
+static void
+refresh (AdwInspectorLayoutPage *self)
+{
+  GtkRoot *own_root = gtk_widget_get_root (GTK_WIDGET (self));
+  GArray *entries = g_array_new (FALSE, FALSE, sizeof (Entry));
+  guint i;
+
+  if (GTK_IS_WIDGET (self->object)) {
+    GtkRoot *root = gtk_widget_get_root (GTK_WIDGET (self->object));
+
+    if (root)
+      collect_entries (GTK_WIDGET (root), entries);
+  } else {
+    GListModel *toplevels = gtk_window_get_toplevels ();
+    guint n = g_list_model_get_n_items (toplevels);
+
+    for (i = 0; i < n; i++) {
+      GtkWidget *window = g_list_model_get_item (toplevels, i);
+
+      if (window != GTK_WIDGET (own_root))
+        collect_entries (window, entries);
+
+      g_object_unref (window);
+    }
+  }
+
+  g_array_sort (entries, compare_entries);
+
+  for (i = 0; i < MAX_ROWS; i++) {
+    if (i < entries->len)
+      update_row (self->rows[i], &g_array_index (entries, Entry, i));
+    else
+      gtk_widget_set_visible (GTK_WIDGET (self->rows[i]), FALSE);
+  }
+
+  gtk_widget_set_visible (self->placeholder, entries->len == 0);
+
+  g_array_unref (entries);
+}
+
+static gboolean
+refresh_cb (AdwInspectorLayoutPage *self)
+{
+  refresh (self);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+reset_cb (AdwInspectorLayoutPage *self)
+{
+  adw_layout_profiler_reset ();
+
+  refresh (self);
+}
+
+static void
+adw_inspector_layout_page_get_property (GObject    *object,
+                                        guint       prop_id,
+                                        GValue     *value,
+                                        GParamSpec *pspec)
+{
+  AdwInspectorLayoutPage *self = ADW_INSPECTOR_LAYOUT_PAGE (object);
+
+  switch (prop_id) {
+  case PROP_TITLE:
+    /* Translators: the title of the layout profiler page in inspector */
+    g_value_set_string (value, _("Adwaita Layout"));
+    break;
+  case PROP_OBJECT:
+    g_value_set_object (value, self->object);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  }
+}
+
+static void
+adw_inspector_layout_page_set_property (GObject      *object,
+                                        guint         prop_id,
+                                        const GValue *value,
+                                        GParamSpec   *pspec)
+{
+  AdwInspectorLayoutPage *self = ADW_INSPECTOR_LAYOUT_PAGE (object);
+
+  switch (prop_id) {
+  case PROP_OBJECT:
+    if (g_set_object (&self->object, g_value_get_object (value)) &&
+        gtk_widget_get_mapped (GTK_WIDGET (self)))
+      refresh (self);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  }
+}
+
+static void
+adw_inspector_layout_page_dispose (GObject *object)
+{
+  AdwInspectorLayoutPage *self = ADW_INSPECTOR_LAYOUT_PAGE (object);
+
+  g_clear_handle_id (&self->refresh_id, g_source_remove);
+  g_clear_object (&self->object);
+
+  G_OBJECT_CLASS (adw_inspector_layout_page_parent_class)->dispose (object);
+}
+
+static void
+adw_inspector_layout_page_map (GtkWidget *widget)
+{
+  AdwInspectorLayoutPage *self = ADW_INSPECTOR_LAYOUT_PAGE (widget);
+
+  GTK_WIDGET_CLASS (adw_inspector_layout_page_parent_class)->map (widget);
+
+  refresh (self);
+
+  self->refresh_id = g_timeout_add_seconds (REFRESH_INTERVAL,
+                                            (GSourceFunc) refresh_cb,
+                                            self);
+}
+
+static void
+adw_inspector_layout_page_unmap (GtkWidget *widget)
+{
+  AdwInspectorLayoutPage *self = ADW_INSPECTOR_LAYOUT_PAGE (widget);
+
+  g_clear_handle_id (&self->refresh_id, g_source_remove);
+
+  GTK_WIDGET_CLASS (adw_inspector_layout_page_parent_class)->unmap (widget);
+}
+
+static void
+adw_inspector_layout_page_class_init (AdwInspectorLayoutPageClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
+
+  object_class->get_property = adw_inspector_layout_page_get_property;
+  object_class->set_property = adw_inspector_layout_page_set_property;
+  object_class->dispose = adw_inspector_layout_page_dispose;
+
+  widget_class->map = adw_inspector_layout_page_map;
+  widget_class->unmap = adw_inspector_layout_page_unmap;
+
+  props[PROP_TITLE] =
+    /* Translators: the title of the layout profiler page in inspector */
+    g_param_spec_string ("title", NULL, NULL,
+                         _("Adwaita Layout"),
+                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  props[PROP_OBJECT] =
+    g_param_spec_object ("object", NULL, NULL,
+                         G_TYPE_OBJECT,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, LAST_PROP, props);
+}
+
+static void
+adw_inspector_layout_page_init (AdwInspectorLayoutPage *self)
+{
+  GtkWidget *page, *button;
+  int i;
+
+  page = adw_preferences_page_new ();
+  adw_bin_set_child (ADW_BIN (self), page);
+
+  self->group = ADW_PREFERENCES_GROUP (adw_preferences_group_new ());
+  /* Translators: title of the group in the layout profiler page in inspector */
+  adw_preferences_group_set_title (self->group, _("Hottest Containers"));
+  /* Translators: description of the group in the layout profiler page in inspector */
+  adw_preferences_group_set_description (self->group, _("Time spent measuring and allocating adaptive containers in the inspected window, excluding other containers inside them."));
+  adw_preferences_page_add (ADW_PREFERENCES_PAGE (page), self->group);
+
+  button = gtk_button_new_from_icon_name ("edit-clear-all-symbolic");
+  /* Translators: tooltip of the button that clears the recorded layout stats */
+  gtk_widget_set_tooltip_text (button, _("Reset"));
+  gtk_widget_set_valign (button, GTK_ALIGN_CENTER);
+  gtk_widget_add_css_class (button, "flat");
+  g_signal_connect_swapped (button, "clicked", G_CALLBACK (reset_cb), self);
+  adw_preferences_group_set_header_suffix (self->group, button);
+
+  /* Translators: shown in the layout profiler page in inspector when nothing
+     has been recorded yet */
+  self->placeholder = gtk_label_new (_("No layout passes recorded"));
+  gtk_widget_add_css_class (self->placeholder, "dimmed");
+  adw_preferences_group_add (self->group, self->placeholder);
+
+  for (i = 0; i < MAX_ROWS; i++) {
+    GtkWidget *row = adw_action_row_new ();
+
+    adw_preferences_row_set_use_markup (ADW_PREFERENCES_ROW (row), FALSE);
+    gtk_widget_set_visible (row, FALSE);
+    adw_preferences_group_add (self->group, row);
+
+    self->rows[i] = ADW_ACTION_ROW (row);
+  }
+}
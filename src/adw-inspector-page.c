@@ -12,6 +12,7 @@
 #include "adw-inspector-page-private.h"
 
 #include <adwaita.h>
+#include "adw-alloc-counters-private.h"
 #include "adw-gizmo-private.h"
 #include "adw-preferences-group.h"
 #include "adw-settings-private.h"
@@ -28,9 +29,15 @@ struct _AdwInspectorPage
   AdwSwitchRow *support_accent_colors_row;
   AdwComboRow *accent_color_row;
   AdwPreferencesGroup *adaptive_preview_group;
+  AdwPreferencesGroup *alloc_counters_group;
+  AdwActionRow *clean_frames_row;
+  AdwActionRow *alloc_counter_rows[ADW_N_ALLOC_COUNTERS];
 
   GObject *object;
 
+  GdkFrameClock *frame_clock;
+  gulong after_paint_id;
+
   gboolean realized;
 };
 
@@ -306,6 +313,125 @@ accent_color_item_unbind_cb (GtkSignalListItemFactory *factory,
   g_signal_handlers_disconnect_by_func (row, selected_item_changed, item);
 }
 
+static void
+set_row_subtitle (AdwActionRow *row,
+                  const char   *subtitle)
+{
+  /* This runs every frame, avoid relayouting the inspector each time */
+  if (!g_strcmp0 (adw_action_row_get_subtitle (row), subtitle))
+    return;
+
+  adw_action_row_set_subtitle (row, subtitle);
+}
+
+static void
+update_alloc_counters (AdwInspectorPage *self)
+{
+  char *subtitle;
+  int i;
+
+  for (i = 0; i < ADW_N_ALLOC_COUNTERS; i++) {
+    AdwAllocCounterStats stats;
+
+    adw_alloc_counters_get_stats (i, &stats);
+
+    /* Translators: subtitle of each allocation counter row in inspector */
+    subtitle = g_strdup_printf (_("Last frame: %u, peak: %u, total: %" G_GUINT64_FORMAT),
+                                stats.last_frame, stats.peak, stats.total);
+    set_row_subtitle (self->alloc_counter_rows[i], subtitle);
+    g_free (subtitle);
+  }
+
+  /* Translators: subtitle of the allocation-free frames row in inspector,
+     e.g. "58 of 60" */
+  subtitle = g_strdup_printf (_("%u of %u"),
+                              adw_alloc_counters_get_n_clean_frames (),
+                              adw_alloc_counters_get_n_frames ());
+  set_row_subtitle (self->clean_frames_row, subtitle);
+  g_free (subtitle);
+}
+
+static void
+after_paint_cb (AdwInspectorPage *self)
+{
+  adw_alloc_counters_end_frame ();
+
+  update_alloc_counters (self);
+}
+
+static void
+untrack_frame_clock (AdwInspectorPage *self)
+{
+  if (!self->frame_clock)
+    return;
+
+  g_clear_signal_handler (&self->after_paint_id, self->frame_clock);
+  g_clear_object (&self->frame_clock);
+}
+
+static GtkWidget *
+get_inspected_window (AdwInspectorPage *self)
+{
+  GtkRoot *own_root = gtk_widget_get_root (GTK_WIDGET (self));
+  GListModel *toplevels;
+  GtkWidget *window = NULL;
+  guint i, n;
+
+  if (GTK_IS_WIDGET (self->object))
+    return GTK_WIDGET (gtk_widget_get_root (GTK_WIDGET (self->object)));
+
+  toplevels = gtk_window_get_toplevels ();
+  n = g_list_model_get_n_items (toplevels);
+
+  for (i = 0; i < n && !window; i++) {
+    GtkWidget *toplevel = g_list_model_get_item (toplevels, i);
+
+    if (toplevel != GTK_WIDGET (own_root))
+      window = toplevel;
+
+    g_object_unref (toplevel);
+  }
+
+  return window;
+}
+
+/* Frames are counted for the window containing the inspected object */
+static void
+track_frame_clock (AdwInspectorPage *self)
+{
+  GtkWidget *window;
+  GdkFrameClock *frame_clock = NULL;
+
+  if (!adw_alloc_counters_get_enabled ())
+    return;
+
+  window = get_inspected_window (self);
+
+  if (window)
+    frame_clock = gtk_widget_get_frame_clock (window);
+
+  if (frame_clock == self->frame_clock)
+    return;
+
+  untrack_frame_clock (self);
+
+  if (!frame_clock)
+    return;
+
+  self->frame_clock = g_object_ref (frame_clock);
+  self->after_paint_id =
+    g_signal_connect_swapped (frame_clock, "after-paint",
+                              G_CALLBACK (after_paint_cb), self);
+}
+
+static void
+reset_alloc_counters_cb (AdwInspectorPage *self)
+{
+  adw_alloc_counters_reset ();
+
+  update_alloc_counters (self);
+}
+
 static void
 adw_inspector_page_get_property (GObject    *object,
                                  guint       prop_id,
@@ -337,7 +463,9 @@ adw_inspector_page_set_property (GObject      *object,
 
   switch (prop_id) {
   case PROP_OBJECT:
-    g_set_object (&self->object, g_value_get_object (value));
+    if (g_set_object (&self->object, g_value_get_object (value)) &&
+        gtk_widget_get_mapped (GTK_WIDGET (self)))
+      track_frame_clock (self);
     break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -354,6 +482,7 @@ adw_inspector_page_dispose (GObject *object)
     self->settings = NULL;
   }
 
+  untrack_frame_clock (self);
   g_clear_object (&self->object);
 
   G_OBJECT_CLASS (adw_inspector_page_parent_class)->dispose (object);
@@ -373,6 +502,26 @@ adw_inspector_page_realize (GtkWidget *widget)
   }
 }
 
+static void
+adw_inspector_page_map (GtkWidget *widget)
+{
+  AdwInspectorPage *self = ADW_INSPECTOR_PAGE (widget);
+
+  GTK_WIDGET_CLASS (adw_inspector_page_parent_class)->map (widget);
+
+  track_frame_clock (self);
+}
+
+static void
+adw_inspector_page_unmap (GtkWidget *widget)
+{
+  AdwInspectorPage *self = ADW_INSPECTOR_PAGE (widget);
+
+  untrack_frame_clock (self);
+
+  GTK_WIDGET_CLASS (adw_inspector_page_parent_class)->unmap (widget);
+}
+
 static void
 adw_inspector_page_class_init (AdwInspectorPageClass *klass)
 {
@@ -384,6 +533,8 @@ adw_inspector_page_class_init (AdwInspectorPageClass *klass)
   object_class->dispose = adw_inspector_page_dispose;
 
   widget_class->realize = adw_inspector_page_realize;
+  widget_class->map = adw_inspector_page_map;
+  widget_class->unmap = adw_inspector_page_unmap;
 
   props[PROP_TITLE] =
     g_param_spec_string ("title", NULL, NULL,
@@ -406,6 +557,8 @@ adw_inspector_page_class_init (AdwInspectorPageClass *klass)
   gtk_widget_class_bind_template_child (widget_class, AdwInspectorPage, support_accent_colors_row);
   gtk_widget_class_bind_template_child (widget_class, AdwInspectorPage, accent_color_row);
   gtk_widget_class_bind_template_child (widget_class, AdwInspectorPage, adaptive_preview_group);
+  gtk_widget_class_bind_template_child (widget_class, AdwInspectorPage, alloc_counters_group);
+  gtk_widget_class_bind_template_child (widget_class, AdwInspectorPage, clean_frames_row);
 
   gtk_widget_class_bind_template_callback (widget_class, get_system_color_scheme_name);
   gtk_widget_class_bind_template_callback (widget_class, get_accent_color_name);
@@ -417,6 +570,7 @@ adw_inspector_page_class_init (AdwInspectorPageClass *klass)
   gtk_widget_class_bind_template_callback (widget_class, color_scheme_changed_cb);
   gtk_widget_class_bind_template_callback (widget_class, high_contrast_changed_cb);
   gtk_widget_class_bind_template_callback (widget_class, accent_color_changed_cb);
+  gtk_widget_class_bind_template_callback (widget_class, reset_alloc_counters_cb);
 }
 
 static void
@@ -459,4 +613,22 @@ adw_inspector_page_init (AdwInspectorPage *self)
                                     NULL);
 
   g_object_unref (windows);
+
+  if (adw_alloc_counters_get_enabled ()) {
+    int i;
+
+    for (i = 0; i < ADW_N_ALLOC_COUNTERS; i++) {
+      GtkWidget *row = adw_action_row_new ();
+
+      adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row),
+                                     adw_alloc_counters_get_name (i));
+      adw_preferences_group_add (self->alloc_counters_group, row);
+
+      self->alloc_counter_rows[i] = ADW_ACTION_ROW (row);
+    }
+
+    update_alloc_counters (self);
+
+    gtk_widget_set_visible (GTK_WIDGET (self->alloc_counters_group), TRUE);
+  }
 }
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+  ADW_LAYOUT_PASS_MEASURE,
+  ADW_LAYOUT_PASS_ALLOCATE,
+} AdwLayoutPass;
+
+#ifdef ADW_ENABLE_PROFILING
+
+typedef struct {
+  gint64 begin_time;
+  gint64 outer_nested_time;
+} AdwLayoutProfilerMark;
+
+typedef struct {
+  guint n_measures;
+  gint64 measure_time;
+  guint n_allocations;
+  gint64 allocate_time;
+} AdwLayoutStats;
+
+void     adw_layout_profiler_set_enabled (gboolean enabled);
+gboolean adw_layout_profiler_get_enabled (void);
+
+AdwLayoutProfilerMark adw_layout_profiler_begin (void);
+void                  adw_layout_profiler_end   (GtkWidget             *widget,
+                                                 AdwLayoutPass          pass,
+                                                 AdwLayoutProfilerMark  mark);
+
+gboolean adw_layout_profiler_get_stats (GtkWidget      *widget,
+                                        AdwLayoutStats *stats);
+
+void adw_layout_profiler_reset (void);
+
+/* Put ADW_LAYOUT_PROFILER_BEGIN() after the declarations at the start of a
+ * measure or allocate implementation, and ADW_LAYOUT_PROFILER_END() before
+ * every return. Both compile to nothing without the profiling build option */
+#define ADW_LAYOUT_PROFILER_BEGIN() \
+  AdwLayoutProfilerMark adw_layout_profiler_mark = adw_layout_profiler_begin ()
+#define ADW_LAYOUT_PROFILER_END(widget, pass) \
+  adw_layout_profiler_end ((widget), (pass), adw_layout_profiler_mark)
+
+#else
+
+#define ADW_LAYOUT_PROFILER_BEGIN() G_STMT_START { } G_STMT_END
+#define ADW_LAYOUT_PROFILER_END(widget, pass) G_STMT_START { } G_STMT_END
+
+#endif
+
+G_END_DECLS
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-layout-profiler-private.h"
+
+#include <string.h>
+
+#ifdef HAVE_SYSPROF
+#include <sysprof-capture.h>
+#endif
+
+/*
+ * The layout profiler records how many times the adaptive containers are
+ * measured and allocated, and how long that takes.
+ *
+ * It's only built with the profiling build option, and is enabled at runtime
+ * with ADW_DEBUG_LAYOUT_PROFILER=1.
+ *
+ * The recorded durations exclude the time spent in other profiled containers
+ * inside, so nested containers don't all show up as expensive because of the
+ * innermost one. They still include everything else, such as measuring plain
+ * GTK widgets inside.
+ *
+ * When running under Sysprof, each pass is also emitted as a mark.
+ */
+
+typedef struct {
+  AdwLayoutStats stats;
+  guint generation;
+} StatsData;
+
+static gboolean enabled = FALSE;
+static guint generation = 0;
+static gint64 nested_time = 0;
+
+static GQuark
+get_stats_quark (void)
+{
+  static GQuark quark = 0;
+
+  if (G_UNLIKELY (quark == 0))
+    quark = g_quark_from_static_string ("adw-layout-profiler-stats");
+
+  return quark;
+}
+
+static inline gint64
+get_time (void)
+{
+#ifdef HAVE_SYSPROF
+  return SYSPROF_CAPTURE_CURRENT_TIME;
+#else
+  return g_get_monotonic_time () * 1000;
+#endif
+}
+
+void
+adw_layout_profiler_set_enabled (gboolean is_enabled)
+{
+  enabled = !!is_enabled;
+}
+
+gboolean
+adw_layout_profiler_get_enabled (void)
+{
+  return enabled;
+}
+
+AdwLayoutProfilerMark
+adw_layout_profiler_begin (void)
+{
+  AdwLayoutProfilerMark mark = { 0, 0 };
+
+  if (!enabled)
+    return mark;
+
+  mark.begin_time = get_time ();
+  mark.outer_nested_time = nested_time;
+
+  nested_time = 0;
+
+  return mark;
+}
+
+void
+adw_layout_profiler_end (GtkWidget             *widget,
+                         AdwLayoutPass          pass,
+                         AdwLayoutProfilerMark  mark)
+{
+  StatsData *data;
+  gint64 duration;
+
+  if (!enabled || mark.begin_time == 0)
+    return;
+
+  duration = get_time () - mark.begin_time;
+
+  data = g_object_get_qdata (G_OBJECT (widget), get_stats_quark ());
+
+  if (!data) {
+    data = g_new0 (StatsData, 1);
+    g_object_set_qdata_full (G_OBJECT (widget), get_stats_quark (), data, g_free);
+  }
+
+  if (data->generation != generation) {
+    memset (&data->stats, 0, sizeof (AdwLayoutStats));
+    data->generation = generation;
+  }
+
+  switch (pass) {
+  case ADW_LAYOUT_PASS_MEASURE:
+    data->stats.n_measures++;
+    data->stats.measure_time += duration - nested_time;
+    break;
+  case ADW_LAYOUT_PASS_ALLOCATE:
+    data->stats.n_allocations++;
+    data->stats.allocate_time += duration - nested_time;
+    break;
+  default:
+    g_assert_not_reached ();
+  }
+
+  nested_time = mark.outer_nested_time + duration;
+
+#ifdef HAVE_SYSPROF
+  if (sysprof_collector_is_active ())
+    sysprof_collector_mark (mark.begin_time, duration, "Adwaita",
+                            pass == ADW_LAYOUT_PASS_MEASURE ? "Measure" : "Allocate",
+                            G_OBJECT_TYPE_NAME (widget));
+#endif
+}
+
+/*
+ * adw_layout_profiler_get_stats:
+ * @widget: a widget
+ * @stats: (out): return location for the stats
+ *
+ * Gets the stats recorded for @widget since the last reset.
+ *
+ * Durations are in nanoseconds.
+ *
+ * Returns: whether @widget has been measured or allocated since then
+ */
+gboolean
+adw_layout_profiler_get_stats (GtkWidget      *widget,
+                               AdwLayoutStats *stats)
+{
+  StatsData *data;
+
+  g_return_val_if_fail (GTK_IS_WIDGET (widget), FALSE);
+  g_return_val_if_fail (stats != NULL, FALSE);
+
+  data = g_object_get_qdata (G_OBJECT (widget), get_stats_quark ());
+
+  if (!data || data->generation != generation)
+    return FALSE;
+
+  *stats = data->stats;
+
+  return TRUE;
+}
+
+/*
+ * adw_layout_profiler_reset:
+ *
+ * Discards the stats recorded so far for all widgets.
+ */
+void
+adw_layout_profiler_reset (void)
+{
+  generation++;
+}
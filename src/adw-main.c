@@ -7,8 +7,13 @@
 
 #include "adw-main-private.h"
 
+#include "adw-alloc-counters-private.h"
 #include "adw-inspector-page-private.h"
 #include "adw-style-manager-private.h"
+#ifdef ADW_ENABLE_PROFILING
+#include "adw-inspector-layout-page-private.h"
+#include "adw-layout-profiler-private.h"
+#endif
 #include <glib/gi18n-lib.h>
 #include <gtk/gtk.h>
 
@@ -45,19 +50,39 @@ static gboolean adw_initialized = FALSE;
 static gboolean adw_adaptive_preview = FALSE;
 
 static void
-init_debug (void)
+init_debug_flag (const char *name,
+                 gboolean   *value)
 {
-  const char *env = g_getenv ("ADW_DEBUG_ADAPTIVE_PREVIEW");
+  const char *env = g_getenv (name);
 
   if (!env || !*env)
     return;
 
   if (!g_strcmp0 (env, "1"))
-    adw_adaptive_preview = TRUE;
+    *value = TRUE;
   else if (!g_strcmp0 (env, "0"))
-    adw_adaptive_preview = FALSE;
+    *value = FALSE;
   else
-    g_warning ("Invalid value for ADW_DEBUG_ADAPTIVE_PREVIEW: %s (Expected 0 or 1)", env);
+    g_warning ("Invalid value for %s: %s (Expected 0 or 1)", name, env);
+}
+
+static void
+init_debug (void)
+{
+  gboolean alloc_counters = FALSE;
+#ifdef ADW_ENABLE_PROFILING
+  gboolean layout_profiler = FALSE;
+#endif
+
+  init_debug_flag ("ADW_DEBUG_ADAPTIVE_PREVIEW", &adw_adaptive_preview);
+
+  init_debug_flag ("ADW_DEBUG_ALLOC_COUNTERS", &alloc_counters);
+  adw_alloc_counters_set_enabled (alloc_counters);
+
+#ifdef ADW_ENABLE_PROFILING
+  init_debug_flag ("ADW_DEBUG_LAYOUT_PROFILER", &layout_profiler);
+  adw_layout_profiler_set_enabled (layout_profiler);
+#endif
 }
 
 /**
@@ -91,6 +116,8 @@ adw_init (void)
 #endif
   adw_init_public_types ();
 
+  init_debug ();
+
   if (!adw_is_granite_present ()) {
     gtk_icon_theme_add_resource_path (gtk_icon_theme_get_for_display (gdk_display_get_default ()),
                                       "/org/gnome/Adwaita/icons");
@@ -102,9 +129,16 @@ adw_init (void)
                                       ADW_TYPE_INSPECTOR_PAGE,
                                       "libadwaita",
                                       10);
-  }
 
-  init_debug ();
+#ifdef ADW_ENABLE_PROFILING
+    if (adw_layout_profiler_get_enabled () &&
+        g_io_extension_point_lookup ("gtk-inspector-page"))
+      g_io_extension_point_implement ("gtk-inspector-page",
+                                      ADW_TYPE_INSPECTOR_LAYOUT_PAGE,
+                                      "libadwaita-layout",
+                                      9);
+#endif
+  }
 
   adw_initialized = TRUE;
 }
@@ -12,6 +12,7 @@
 #include "adw-multi-layout-view-private.h"
 
 #include "adw-layout-private.h"
+#include "adw-layout-slot.h"
 #include "adw-widget-utils-private.h"
 
 /**
@@ -112,6 +113,8 @@ struct _AdwMultiLayoutView
   AdwLayout *current_layout;
   GtkWidget *content;
   GHashTable *slots;
+  GHashTable *nested_slots;
+  GQueue *pending_slots;
 
   gboolean accepting_slots;
 };
@@ -137,7 +140,7 @@ parent_child (AdwMultiLayoutView *self,
               const char         *id)
 {
   GtkWidget *slot = g_hash_table_lookup (self->slots, id);
-  GtkWidget *child;
+  GtkWidget *child, *parent;
   GBinding *child_visible_binding;
 
   if (!slot)
@@ -145,9 +148,21 @@ parent_child (AdwMultiLayoutView *self,
 
   child = g_hash_table_lookup (self->children, id);
 
-  if (gtk_widget_get_parent (child) == GTK_WIDGET (slot))
+  if (!child)
     return;
 
+  parent = gtk_widget_get_parent (child);
+
+  if (parent == GTK_WIDGET (slot))
+    return;
+
+  /* The child may still be in a slot nested inside another child that isn't
+   * a part of the current layout, take it from there */
+  if (parent) {
+    g_hash_table_remove (self->child_visible_bindings, child);
+    gtk_widget_unparent (child);
+  }
+
   child_visible_binding = g_object_bind_property (child, "visible",
                                                   slot, "visible",
                                                   G_BINDING_SYNC_CREATE);
@@ -159,12 +174,45 @@ parent_child (AdwMultiLayoutView *self,
   gtk_widget_set_parent (child, GTK_WIDGET (slot));
 }
 
+/* The child owning @slot is the one in the nearest registered slot above it.
+ * Children keep their slots when moving along with another child, so this
+ * can't rely on which child is being parented when @slot registers */
+static const char *
+find_slot_owner (AdwMultiLayoutView *self,
+                 GtkWidget          *slot)
+{
+  GtkWidget *widget;
+
+  for (widget = gtk_widget_get_parent (slot);
+       widget && widget != GTK_WIDGET (self);
+       widget = gtk_widget_get_parent (widget)) {
+    const char *id;
+
+    if (!ADW_IS_LAYOUT_SLOT (widget))
+      continue;
+
+    id = adw_layout_slot_get_slot_id (ADW_LAYOUT_SLOT (widget));
+
+    if (g_hash_table_lookup (self->slots, id) == widget &&
+        g_hash_table_contains (self->children, id))
+      return id;
+  }
+
+  return NULL;
+}
+
 static void
-parent_child_func (const char         *id,
-                   GtkWidget          *child,
-                   AdwMultiLayoutView *self)
+parent_pending_children (AdwMultiLayoutView *self)
 {
-  parent_child (self, id);
+  char *id;
+
+  /* Each slot is queued once when it registers, and parenting a child can
+   * only queue the slots inside that child, so this is a single pass over
+   * the slot tree regardless of how deeply slots are nested */
+  while ((id = g_queue_pop_head (self->pending_slots))) {
+    parent_child (self, id);
+    g_free (id);
+  }
 }
 
 static void
@@ -172,13 +220,63 @@ unparent_child (const char         *id,
                 GtkWidget          *child,
                 AdwMultiLayoutView *self)
 {
-  if (!g_hash_table_contains (self->slots, id))
+  if (!gtk_widget_get_parent (child))
     return;
 
   g_hash_table_remove (self->child_visible_bindings, child);
   gtk_widget_unparent (child);
 }
 
+static void
+remove_child_slots (AdwMultiLayoutView *self,
+                    const char         *id)
+{
+  GHashTableIter iter;
+  const char *slot_id, *owner_id;
+  GPtrArray *owned_slots = g_ptr_array_new_with_free_func (g_free);
+  guint i;
+
+  g_hash_table_iter_init (&iter, self->nested_slots);
+
+  while (g_hash_table_iter_next (&iter, (gpointer) &slot_id, (gpointer) &owner_id))
+    if (!g_strcmp0 (owner_id, id))
+      g_ptr_array_add (owned_slots, g_strdup (slot_id));
+
+  /* The slots go away along with the child, and so do the children placed
+   * into them. Those are rooted again, and their slots registered again, when
+   * they are placed into another slot */
+  for (i = 0; i < owned_slots->len; i++) {
+    const char *owned_id = g_ptr_array_index (owned_slots, i);
+    GtkWidget *child = g_hash_table_lookup (self->children, owned_id);
+
+    g_hash_table_remove (self->nested_slots, owned_id);
+    g_hash_table_remove (self->slots, owned_id);
+
+    if (child) {
+      remove_child_slots (self, owned_id);
+      unparent_child (owned_id, child, self);
+    }
+  }
+
+  g_ptr_array_unref (owned_slots);
+}
+
+static void
+unparent_toplevel_child (const char         *id,
+                         GtkWidget          *child,
+                         AdwMultiLayoutView *self)
+{
+  /* Children inside slots that belong to other children move along with
+   * them, so there's no need to reparent them */
+  if (g_hash_table_contains (self->nested_slots, id))
+    return;
+
+  if (!g_hash_table_contains (self->slots, id))
+    return;
+
+  unparent_child (id, child, self);
+}
+
 static void
 binding_unbind_and_unref (gpointer data)
 {
@@ -191,8 +289,10 @@ binding_unbind_and_unref (gpointer data)
 static void
 destroy_current_layout (AdwMultiLayoutView *self)
 {
-  g_hash_table_foreach (self->children, (GHFunc) unparent_child, self);
+  g_hash_table_foreach (self->children, (GHFunc) unparent_toplevel_child, self);
   g_hash_table_remove_all (self->slots);
+  g_hash_table_remove_all (self->nested_slots);
+  g_queue_clear_full (self->pending_slots, g_free);
   g_clear_pointer (&self->content, gtk_widget_unparent);
 }
 
@@ -226,16 +326,10 @@ rebuild_current_layout (AdwMultiLayoutView *self)
   self->content = adw_layout_get_content (self->current_layout);
 
   if (self->content) {
-    int old_size;
-
     self->accepting_slots = TRUE;
     gtk_widget_set_parent (self->content, GTK_WIDGET (self));
 
-    do {
-      old_size = g_hash_table_size (self->slots);
-
-      g_hash_table_foreach (self->children, (GHFunc) parent_child_func, self);
-    } while (g_hash_table_size (self->slots) > old_size);
+    parent_pending_children (self);
 
     self->accepting_slots = FALSE;
   } else {
@@ -295,6 +389,12 @@ adw_multi_layout_view_dispose (GObject *object)
   g_clear_pointer (&self->layouts, g_ptr_array_unref);
   g_clear_pointer (&self->content, gtk_widget_unparent);
   g_clear_pointer (&self->slots, g_hash_table_unref);
+  g_clear_pointer (&self->nested_slots, g_hash_table_unref);
+
+  if (self->pending_slots) {
+    g_queue_free_full (self->pending_slots, g_free);
+    self->pending_slots = NULL;
+  }
 
   G_OBJECT_CLASS (adw_multi_layout_view_parent_class)->dispose (object);
 }
@@ -393,6 +493,8 @@ adw_multi_layout_view_init (AdwMultiLayoutView *self)
   self->children = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
   self->child_visible_bindings = g_hash_table_new_full (NULL, NULL, NULL, binding_unbind_and_unref);
   self->slots = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  self->nested_slots = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  self->pending_slots = g_queue_new ();
 }
 
 static void
@@ -669,13 +771,21 @@ adw_multi_layout_view_set_child (AdwMultiLayoutView *self,
   if (prev_child == child)
     return;
 
-  if (prev_child && self->current_layout)
+  if (prev_child) {
+    remove_child_slots (self, id);
     unparent_child (id, prev_child, self);
+  }
 
   g_hash_table_insert (self->children, g_strdup (id), g_object_ref_sink (child));
 
-  if (self->current_layout)
+  if (self->current_layout && self->content) {
+    self->accepting_slots = TRUE;
+
     parent_child (self, id);
+    parent_pending_children (self);
+
+    self->accepting_slots = FALSE;
+  }
 }
 
 void
@@ -683,6 +793,8 @@ adw_multi_layout_view_register_slot (AdwMultiLayoutView *self,
                                      const char         *id,
                                      GtkWidget          *slot)
 {
+  const char *owner_id;
+
   g_return_if_fail (ADW_IS_MULTI_LAYOUT_VIEW (self));
   g_return_if_fail (id != NULL);
   g_return_if_fail (GTK_IS_WIDGET (slot));
@@ -695,5 +807,12 @@ adw_multi_layout_view_register_slot (AdwMultiLayoutView *self,
     return;
   }
 
+  owner_id = find_slot_owner (self, slot);
+
   g_hash_table_insert (self->slots, g_strdup (id), slot);
+
+  if (owner_id)
+    g_hash_table_insert (self->nested_slots, g_strdup (id), g_strdup (owner_id));
+
+  g_queue_push_tail (self->pending_slots, g_strdup (id));
 }
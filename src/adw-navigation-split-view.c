@@ -11,9 +11,11 @@
 
 #include <math.h>
 
+#include "adw-adaptive-context-private.h"
 #include "adw-bin.h"
 #include "adw-enums.h"
 #include "adw-gtkbuilder-utils-private.h"
+#include "adw-layout-profiler-private.h"
 #include "adw-length-unit.h"
 #include "adw-navigation-view-private.h"
 #include "adw-widget-utils-private.h"
@@ -183,6 +185,9 @@ struct _AdwNavigationSplitView
   GtkWidget *content_bin;
   GtkWidget *navigation_view;
 
+  AdwAdaptiveContext *sidebar_context;
+  AdwAdaptiveContext *content_context;
+
   GtkPackType sidebar_position;
   gboolean collapsed;
   gboolean show_content;
@@ -238,6 +243,7 @@ measure_uncollapsed (GtkWidget      *widget,
   AdwNavigationSplitView *self = ADW_NAVIGATION_SPLIT_VIEW (widget);
   int sidebar_min = 0, sidebar_nat = 0;
   int content_min = 0, content_nat = 0;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->sidebar_bin, orientation, -1,
                       &sidebar_min, &sidebar_nat, NULL, NULL);
@@ -271,6 +277,8 @@ measure_uncollapsed (GtkWidget      *widget,
     if (natural)
       *natural = MAX (sidebar_nat, content_nat);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static void
@@ -283,6 +291,7 @@ allocate_uncollapsed (GtkWidget *widget,
   GtkSettings *settings = gtk_widget_get_settings (widget);
   int sidebar_min, content_min, sidebar_max, sidebar_width;
   GskTransform *transform;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->sidebar_bin, GTK_ORIENTATION_HORIZONTAL, -1,
                       &sidebar_min, NULL, NULL, NULL);
@@ -314,6 +323,8 @@ allocate_uncollapsed (GtkWidget *widget,
     gtk_widget_allocate (self->sidebar_bin, sidebar_width, height, baseline, transform);
     gtk_widget_allocate (self->content_bin, width - sidebar_width, height, baseline, NULL);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static void
@@ -538,6 +549,7 @@ update_collapsed (AdwNavigationSplitView *self)
     gtk_widget_set_layout_manager (GTK_WIDGET (self), gtk_bin_layout_new ());
 
     self->navigation_view = adw_navigation_view_new ();
+    adw_adaptive_context_attach (self->content_context, self->navigation_view);
     gtk_widget_set_parent (self->navigation_view, GTK_WIDGET (self));
 
     if (self->sidebar_position == GTK_PACK_END) {
@@ -583,6 +595,7 @@ update_collapsed (AdwNavigationSplitView *self)
                                                           allocate_uncollapsed));
 
     self->sidebar_bin = adw_bin_new ();
+    adw_adaptive_context_attach (self->sidebar_context, self->sidebar_bin);
     gtk_widget_add_css_class (self->sidebar_bin, "sidebar-pane");
     gtk_widget_set_parent (self->sidebar_bin, GTK_WIDGET (self));
 
@@ -604,6 +617,7 @@ update_collapsed (AdwNavigationSplitView *self)
     }
 
     self->content_bin = adw_bin_new ();
+    adw_adaptive_context_attach (self->content_context, self->content_bin);
     gtk_widget_add_css_class (self->content_bin, "content-pane");
     gtk_widget_set_parent (self->content_bin, GTK_WIDGET (self));
 
@@ -717,8 +731,12 @@ adw_navigation_split_view_root (GtkWidget *widget)
 static void
 adw_navigation_split_view_unroot (GtkWidget *widget)
 {
+  AdwNavigationSplitView *self = ADW_NAVIGATION_SPLIT_VIEW (widget);
   GtkWidget *parent_page;
 
+  adw_adaptive_context_invalidate (self->sidebar_context);
+  adw_adaptive_context_invalidate (self->content_context);
+
   parent_page = adw_widget_get_ancestor (widget, ADW_TYPE_NAVIGATION_PAGE, TRUE, TRUE);
 
   if (parent_page)
@@ -735,6 +753,8 @@ adw_navigation_split_view_dispose (GObject *object)
   g_clear_pointer (&self->sidebar_bin, gtk_widget_unparent);
   g_clear_pointer (&self->content_bin, gtk_widget_unparent);
   g_clear_pointer (&self->navigation_view, gtk_widget_unparent);
+  g_clear_object (&self->sidebar_context);
+  g_clear_object (&self->content_context);
   self->sidebar = NULL;
   self->content = NULL;
 
@@ -1007,6 +1027,11 @@ adw_navigation_split_view_init (AdwNavigationSplitView *self)
   self->sidebar_width_fraction = 0.25;
   self->sidebar_width_unit = ADW_LENGTH_UNIT_SP;
 
+  self->sidebar_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR);
+  self->content_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_CONTENT);
+
   update_collapsed (self);
 }
 
@@ -9,6 +9,7 @@
 #include "config.h"
 #include "adw-navigation-view-private.h"
 
+#include "adw-adaptive-context-private.h"
 #include "adw-animation-util-private.h"
 #include "adw-gizmo-private.h"
 #include "adw-gtkbuilder-utils-private.h"
@@ -106,6 +107,20 @@
  * [property@NavigationPage:can-pop] can be used to disable them, along with the
  * header bar back buttons.
  *
+ * ## Releasing Hidden Pages
+ *
+ * Pages stay in the navigation stack with their whole widget tree until they
+ * are popped, so deep hierarchies such as file browsers can keep many hidden
+ * widgets around.
+ *
+ * Pages that can create their child on demand using
+ * [method@NavigationPage.set_load_func] can have it destroyed while they are
+ * deep in the navigation stack. Set [property@NavigationView:max-loaded-pages]
+ * to limit how many pages at the top of the navigation stack keep their
+ * children. The pages below them keep their tag and title, so they still
+ * appear in the [class@HeaderBar] back button context menu, and their child
+ * is created again once they are shown.
+ *
  * ## Actions
  *
  * `AdwNavigationView` defines actions for controlling the navigation stack.
@@ -233,6 +248,12 @@ typedef struct
   AdwNavigationView *child_view;
 
   int nav_split_views;
+
+  AdwAdaptiveContext *adaptive_context;
+
+  AdwNavigationPageLoadFunc load_func;
+  gpointer load_func_data;
+  GDestroyNotify load_func_data_destroy;
 } AdwNavigationPagePrivate;
 
 static void adw_navigation_page_buildable_init (GtkBuildableIface *iface);
@@ -249,6 +270,7 @@ enum {
   PAGE_PROP_TAG,
   PAGE_PROP_TITLE,
   PAGE_PROP_CAN_POP,
+  PAGE_PROP_LOADED,
   LAST_PAGE_PROP
 };
 
@@ -264,6 +286,37 @@ enum {
 
 static guint page_signals[LAST_PAGE_SIGNAL];
 
+static void
+page_load (AdwNavigationPage *page)
+{
+  AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (page);
+  GtkWidget *child;
+
+  if (!priv->load_func || priv->child)
+    return;
+
+  child = priv->load_func (page, priv->load_func_data);
+
+  if (!child) {
+    g_critical ("AdwNavigationPage load function returned NULL for page %s",
+                priv->tag ? priv->tag : "(untagged)");
+    return;
+  }
+
+  adw_navigation_page_set_child (page, child);
+}
+
+static void
+page_unload (AdwNavigationPage *page)
+{
+  AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (page);
+
+  if (!priv->load_func || !priv->child)
+    return;
+
+  adw_navigation_page_set_child (page, NULL);
+}
+
 struct _AdwNavigationView
 {
   GtkWidget parent_instance;
@@ -275,10 +328,12 @@ struct _AdwNavigationView
 
   gboolean animate_transitions;
   gboolean pop_on_escape;
+  guint max_loaded_pages;
 
   AdwAnimation *transition;
   AdwNavigationPage *showing_page;
   AdwNavigationPage *hiding_page;
+  GskRenderNode *hiding_node;
   gboolean transition_pop;
   gboolean transition_cancel;
   double transition_progress;
@@ -311,6 +366,7 @@ enum {
   PROP_ANIMATE_TRANSITIONS,
   PROP_POP_ON_ESCAPE,
   PROP_NAVIGATION_STACK,
+  PROP_MAX_LOADED_PAGES,
   LAST_PROP
 };
 
@@ -506,10 +562,27 @@ adw_navigation_page_dispose (GObject *object)
 
   g_clear_pointer (&priv->child, gtk_widget_unparent);
   g_clear_weak_pointer (&priv->child_view);
+  g_clear_object (&priv->adaptive_context);
+
+  if (priv->load_func_data_destroy)
+    g_clear_pointer (&priv->load_func_data, priv->load_func_data_destroy);
+
+  priv->load_func = NULL;
 
   G_OBJECT_CLASS (adw_navigation_page_parent_class)->dispose (object);
 }
 
+static void
+adw_navigation_page_unroot (GtkWidget *widget)
+{
+  AdwNavigationPage *self = ADW_NAVIGATION_PAGE (widget);
+  AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (self);
+
+  adw_adaptive_context_invalidate (priv->adaptive_context);
+
+  GTK_WIDGET_CLASS (adw_navigation_page_parent_class)->unroot (widget);
+}
+
 static void
 adw_navigation_page_finalize (GObject *object)
 {
@@ -544,6 +617,9 @@ adw_navigation_page_get_property (GObject    *object,
   case PAGE_PROP_CAN_POP:
     g_value_set_boolean (value, adw_navigation_page_get_can_pop (self));
     break;
+  case PAGE_PROP_LOADED:
+    g_value_set_boolean (value, adw_navigation_page_get_loaded (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -607,6 +683,7 @@ adw_navigation_page_class_init (AdwNavigationPageClass *klass)
   object_class->set_property = adw_navigation_page_set_property;
 
   widget_class->realize = adw_navigation_page_realize;
+  widget_class->unroot = adw_navigation_page_unroot;
   widget_class->compute_expand = adw_widget_compute_expand;
 
   klass->showing = adw_navigation_page_real_showing;
@@ -683,6 +760,22 @@ adw_navigation_page_class_init (AdwNavigationPageClass *klass)
                           TRUE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwNavigationPage:loaded:
+   *
+   * Whether the page currently has its child.
+   *
+   * This is always `TRUE` for pages without a load function.
+   *
+   * See [method@NavigationPage.set_load_func].
+   *
+   * Since: 1.10
+   */
+  page_props[PAGE_PROP_LOADED] =
+    g_param_spec_boolean ("loaded", NULL, NULL,
+                          TRUE,
+                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PAGE_PROP, page_props);
 
   /**
@@ -794,6 +887,10 @@ adw_navigation_page_init (AdwNavigationPage *self)
   priv->title = g_strdup ("");
   priv->can_pop = TRUE;
 
+  priv->adaptive_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_NAVIGATION_PAGE);
+  adw_adaptive_context_attach (priv->adaptive_context, GTK_WIDGET (self));
+
   gtk_accessible_update_property (GTK_ACCESSIBLE (self),
                                   GTK_ACCESSIBLE_PROPERTY_LABEL, priv->title,
                                   -1);
@@ -857,6 +954,8 @@ switch_page (AdwNavigationView *self,
   if (!prev_page)
     animate = FALSE;
 
+  g_clear_pointer (&self->hiding_node, gsk_render_node_unref);
+
   if (self->hiding_page && self->hiding_page != prev_page) {
     AdwNavigationPage *hiding_page = g_steal_pointer (&self->hiding_page);
 
@@ -1017,6 +1116,26 @@ pop_from_stack (AdwNavigationView *self,
   g_slist_free_full (popped, g_object_unref);
 }
 
+static void
+unload_pages (AdwNavigationView *self)
+{
+  GListModel *stack = G_LIST_MODEL (self->navigation_stack);
+  guint i, n_pages;
+
+  if (self->max_loaded_pages == 0 || !stack)
+    return;
+
+  n_pages = g_list_model_get_n_items (stack);
+
+  for (i = 0; i + self->max_loaded_pages < n_pages; i++) {
+    AdwNavigationPage *page = g_list_model_get_item (stack, i);
+
+    page_unload (page);
+
+    g_object_unref (page);
+  }
+}
+
 static void
 transition_cb (double             value,
                AdwNavigationView *self)
@@ -1029,6 +1148,8 @@ transition_cb (double             value,
 static void
 transition_done_cb (AdwNavigationView *self)
 {
+  g_clear_pointer (&self->hiding_node, gsk_render_node_unref);
+
   if (self->hiding_page) {
     AdwNavigationPage *hiding_page = g_steal_pointer (&self->hiding_page);
 
@@ -1072,6 +1193,8 @@ transition_done_cb (AdwNavigationView *self)
 
   gtk_widget_set_child_visible (self->shield, FALSE);
   gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  unload_pages (self);
 }
 
 static void
@@ -1644,6 +1767,26 @@ adw_navigation_view_size_allocate (GtkWidget *widget,
   }
 }
 
+static void
+snapshot_hiding_page (AdwNavigationView *self,
+                      GtkSnapshot       *snapshot)
+{
+  /* The page is fading out, so freeze it on the first frame instead of
+   * snapshotting it again every frame in case it keeps redrawing */
+  if (!self->hiding_node) {
+    GtkSnapshot *child_snapshot = gtk_snapshot_new ();
+
+    gtk_widget_snapshot_child (GTK_WIDGET (self),
+                               GTK_WIDGET (self->hiding_page),
+                               child_snapshot);
+
+    self->hiding_node = gtk_snapshot_free_to_node (child_snapshot);
+  }
+
+  if (self->hiding_node)
+    gtk_snapshot_append_node (snapshot, self->hiding_node);
+}
+
 static void
 adw_navigation_view_snapshot (GtkWidget   *widget,
                               GtkSnapshot *snapshot)
@@ -1664,7 +1807,7 @@ adw_navigation_view_snapshot (GtkWidget   *widget,
     if (self->showing_page && self->hiding_page && self->showing_page != self->hiding_page) {
       gtk_snapshot_push_cross_fade (snapshot, self->transition_progress);
 
-      gtk_widget_snapshot_child (widget, GTK_WIDGET (self->hiding_page), snapshot);
+      snapshot_hiding_page (self, snapshot);
       gtk_snapshot_pop (snapshot);
 
       gtk_widget_snapshot_child (widget, GTK_WIDGET (self->showing_page), snapshot);
@@ -1791,6 +1934,7 @@ adw_navigation_view_dispose (GObject *object)
   g_clear_object (&self->navigation_stack);
   g_clear_pointer (&self->tag_mapping, g_hash_table_unref);
   g_clear_object (&self->transition);
+  g_clear_pointer (&self->hiding_node, gsk_render_node_unref);
 
   G_OBJECT_CLASS (adw_navigation_view_parent_class)->dispose (object);
 }
@@ -1835,6 +1979,9 @@ adw_navigation_view_get_property (GObject    *object,
   case PROP_NAVIGATION_STACK:
     g_value_take_object (value, adw_navigation_view_get_navigation_stack (self));
     break;
+  case PROP_MAX_LOADED_PAGES:
+    g_value_set_uint (value, adw_navigation_view_get_max_loaded_pages (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1861,6 +2008,9 @@ adw_navigation_view_set_property (GObject      *object,
   case PROP_POP_ON_ESCAPE:
     adw_navigation_view_set_pop_on_escape (self, g_value_get_boolean (value));
     break;
+  case PROP_MAX_LOADED_PAGES:
+    adw_navigation_view_set_max_loaded_pages (self, g_value_get_uint (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -2004,6 +2154,25 @@ adw_navigation_view_class_init (AdwNavigationViewClass *klass)
                          G_TYPE_LIST_MODEL,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdwNavigationView:max-loaded-pages:
+   *
+   * The maximum number of pages at the top of the navigation stack that keep
+   * their child, including the visible page.
+   *
+   * The pages below them that have a load function set with
+   * [method@NavigationPage.set_load_func] have their child destroyed once the
+   * transition finishes, and created again when they're shown.
+   *
+   * If set to 0, pages always keep their child.
+   *
+   * Since: 1.10
+   */
+  props[PROP_MAX_LOADED_PAGES] =
+    g_param_spec_uint ("max-loaded-pages", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -2365,6 +2534,7 @@ adw_navigation_page_set_child (AdwNavigationPage *self,
                                GtkWidget         *child)
 {
   AdwNavigationPagePrivate *priv;
+  gboolean was_loaded;
 
   g_return_if_fail (ADW_IS_NAVIGATION_PAGE (self));
   g_return_if_fail (child == NULL || GTK_IS_WIDGET (child));
@@ -2377,6 +2547,8 @@ adw_navigation_page_set_child (AdwNavigationPage *self,
   if (child)
     g_return_if_fail (gtk_widget_get_parent (child) == NULL);
 
+  was_loaded = adw_navigation_page_get_loaded (self);
+
   g_object_freeze_notify (G_OBJECT (self));
 
   if (priv->child)
@@ -2389,6 +2561,9 @@ adw_navigation_page_set_child (AdwNavigationPage *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_CHILD]);
 
+  if (was_loaded != adw_navigation_page_get_loaded (self))
+    g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_LOADED]);
+
   g_object_thaw_notify (G_OBJECT (self));
 }
 
@@ -2585,6 +2760,79 @@ adw_navigation_page_set_can_pop (AdwNavigationPage *self,
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_CAN_POP]);
 }
 
+/**
+ * adw_navigation_page_set_load_func:
+ * @self: a navigation page
+ * @load_func: (nullable) (scope notified) (closure user_data) (destroy user_data_destroy):
+ *   the function creating the child of @self
+ * @user_data: user data for @load_func
+ * @user_data_destroy: (nullable): destroy notify for @user_data
+ *
+ * Sets the function creating the child of @self on demand.
+ *
+ * @load_func is called when @self is shown without a child, for example the
+ * first time it's pushed, or when it's shown again after its child has been
+ * destroyed because of [property@NavigationView:max-loaded-pages]. Any state
+ * that needs to survive that, such as scroll positions or entered text, must
+ * be stored elsewhere.
+ *
+ * Pages without a load function always keep their child.
+ *
+ * Since: 1.10
+ */
+void
+adw_navigation_page_set_load_func (AdwNavigationPage         *self,
+                                   AdwNavigationPageLoadFunc  load_func,
+                                   gpointer                   user_data,
+                                   GDestroyNotify             user_data_destroy)
+{
+  AdwNavigationPagePrivate *priv;
+  gboolean was_loaded;
+
+  g_return_if_fail (ADW_IS_NAVIGATION_PAGE (self));
+
+  priv = adw_navigation_page_get_instance_private (self);
+
+  was_loaded = adw_navigation_page_get_loaded (self);
+
+  if (priv->load_func_data_destroy)
+    g_clear_pointer (&priv->load_func_data, priv->load_func_data_destroy);
+
+  priv->load_func = load_func;
+  priv->load_func_data = user_data;
+  priv->load_func_data_destroy = user_data_destroy;
+
+  if (gtk_widget_get_mapped (GTK_WIDGET (self)))
+    page_load (self);
+
+  if (was_loaded != adw_navigation_page_get_loaded (self))
+    g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_LOADED]);
+}
+
+/**
+ * adw_navigation_page_get_loaded:
+ * @self: a navigation page
+ *
+ * Gets whether @self currently has its child.
+ *
+ * This is always `TRUE` for pages without a load function.
+ *
+ * Returns: whether @self is loaded
+ *
+ * Since: 1.10
+ */
+gboolean
+adw_navigation_page_get_loaded (AdwNavigationPage *self)
+{
+  AdwNavigationPagePrivate *priv;
+
+  g_return_val_if_fail (ADW_IS_NAVIGATION_PAGE (self), FALSE);
+
+  priv = adw_navigation_page_get_instance_private (self);
+
+  return !priv->load_func || priv->child != NULL;
+}
+
 AdwNavigationView *
 adw_navigation_page_get_child_view (AdwNavigationPage *self)
 {
@@ -2604,6 +2852,8 @@ adw_navigation_page_showing (AdwNavigationPage *self)
 
   g_return_if_fail (ADW_IS_NAVIGATION_PAGE (self));
 
+  page_load (self);
+
   if (!priv->block_signals)
     g_signal_emit (self, page_signals[PAGE_SIGNAL_SHOWING], 0);
 }
@@ -3441,6 +3691,58 @@ adw_navigation_view_set_pop_on_escape (AdwNavigationView *self,
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_POP_ON_ESCAPE]);
 }
 
+/**
+ * adw_navigation_view_get_max_loaded_pages:
+ * @self: a navigation view
+ *
+ * Gets the maximum number of pages that keep their child.
+ *
+ * Returns: the maximum number of loaded pages, or 0 if there's no limit
+ *
+ * Since: 1.10
+ */
+guint
+adw_navigation_view_get_max_loaded_pages (AdwNavigationView *self)
+{
+  g_return_val_if_fail (ADW_IS_NAVIGATION_VIEW (self), 0);
+
+  return self->max_loaded_pages;
+}
+
+/**
+ * adw_navigation_view_set_max_loaded_pages:
+ * @self: a navigation view
+ * @max_loaded_pages: the maximum number of loaded pages
+ *
+ * Sets the maximum number of pages at the top of the navigation stack that
+ * keep their child, including the visible page.
+ *
+ * The pages below them that have a load function set with
+ * [method@NavigationPage.set_load_func] have their child destroyed once the
+ * transition finishes, and created again when they're shown.
+ *
+ * If set to 0, pages always keep their child.
+ *
+ * Since: 1.10
+ */
+void
+adw_navigation_view_set_max_loaded_pages (AdwNavigationView *self,
+                                          guint              max_loaded_pages)
+{
+  g_return_if_fail (ADW_IS_NAVIGATION_VIEW (self));
+
+  if (max_loaded_pages == self->max_loaded_pages)
+    return;
+
+  self->max_loaded_pages = max_loaded_pages;
+
+  /* Otherwise it will happen once the transition is done */
+  if (!self->showing_page && !self->hiding_page)
+    unload_pages (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_LOADED_PAGES]);
+}
+
 /**
  * adw_navigation_view_get_navigation_stack:
  * @self: a navigation view
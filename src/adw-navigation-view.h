@@ -108,6 +108,18 @@ ADW_AVAILABLE_IN_1_4
 void     adw_navigation_page_set_can_pop (AdwNavigationPage *self,
                                           gboolean           can_pop);
 
+typedef GtkWidget *(*AdwNavigationPageLoadFunc) (AdwNavigationPage *page,
+                                                 gpointer           user_data);
+
+ADW_AVAILABLE_IN_1_10
+void adw_navigation_page_set_load_func (AdwNavigationPage         *self,
+                                        AdwNavigationPageLoadFunc  load_func,
+                                        gpointer                   user_data,
+                                        GDestroyNotify             user_data_destroy);
+
+ADW_AVAILABLE_IN_1_10
+gboolean adw_navigation_page_get_loaded (AdwNavigationPage *self);
+
 #define ADW_TYPE_NAVIGATION_VIEW (adw_navigation_view_get_type())
 
 ADW_AVAILABLE_IN_1_4
@@ -190,6 +202,12 @@ ADW_AVAILABLE_IN_1_4
 void     adw_navigation_view_set_pop_on_escape (AdwNavigationView *self,
                                                 gboolean           pop_on_escape);
 
+ADW_AVAILABLE_IN_1_10
+guint adw_navigation_view_get_max_loaded_pages (AdwNavigationView *self);
+ADW_AVAILABLE_IN_1_10
+void  adw_navigation_view_set_max_loaded_pages (AdwNavigationView *self,
+                                                guint              max_loaded_pages);
+
 ADW_AVAILABLE_IN_1_4
 GListModel *adw_navigation_view_get_navigation_stack (AdwNavigationView *self);
 
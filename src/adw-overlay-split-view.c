@@ -10,10 +10,12 @@
 
 #include <math.h>
 
+#include "adw-adaptive-context-private.h"
 #include "adw-animation-util.h"
 #include "adw-bin.h"
 #include "adw-gizmo-private.h"
 #include "adw-gtkbuilder-utils-private.h"
+#include "adw-layout-profiler-private.h"
 #include "adw-length-unit.h"
 #include "adw-shadow-helper-private.h"
 #include "adw-spring-animation.h"
@@ -194,6 +196,9 @@ struct _AdwOverlaySplitView
 
   GtkWidget *last_sidebar_focus;
   GtkWidget *last_content_focus;
+
+  AdwAdaptiveContext *sidebar_context;
+  AdwAdaptiveContext *content_context;
 };
 
 static void adw_overlay_split_view_buildable_init (GtkBuildableIface *iface);
@@ -531,6 +536,7 @@ measure_uncollapsed (GtkWidget      *widget,
   AdwOverlaySplitView *self = ADW_OVERLAY_SPLIT_VIEW (widget);
   int sidebar_min = 0, sidebar_nat = 0;
   int content_min = 0, content_nat = 0;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->sidebar_bin, orientation, -1,
                       &sidebar_min, &sidebar_nat, NULL, NULL);
@@ -567,6 +573,8 @@ measure_uncollapsed (GtkWidget      *widget,
     if (natural)
       *natural = MAX (sidebar_nat, content_nat);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static void
@@ -578,6 +586,7 @@ allocate_uncollapsed (GtkWidget *widget,
   AdwOverlaySplitView *self = ADW_OVERLAY_SPLIT_VIEW (widget);
   int content_min, sidebar_width, sidebar_offset;
   GskTransform *transform;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->content_bin, GTK_ORIENTATION_HORIZONTAL, -1,
                       &content_min, NULL, NULL, NULL);
@@ -607,6 +616,8 @@ allocate_uncollapsed (GtkWidget *widget,
     gtk_widget_allocate (self->sidebar_bin, sidebar_width, height, baseline, transform);
     gtk_widget_allocate (self->content_bin, width - sidebar_offset, height, baseline, NULL);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static void
@@ -622,6 +633,7 @@ measure_collapsed (GtkWidget      *widget,
 
   int content_min = 0, content_nat = 0;
   int sidebar_min = 0, sidebar_nat = 0;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->content_bin, orientation, -1, &content_min, &content_nat, NULL, NULL);
   gtk_widget_measure (self->sidebar_bin, orientation, -1, &sidebar_min, &sidebar_nat, NULL, NULL);
@@ -648,6 +660,8 @@ measure_collapsed (GtkWidget      *widget,
     *minimum_baseline = -1;
   if (natural_baseline)
     *natural_baseline = -1;
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static void
@@ -659,6 +673,7 @@ allocate_collapsed (GtkWidget *widget,
   AdwOverlaySplitView *self = ADW_OVERLAY_SPLIT_VIEW (widget);
   int sidebar_width, sidebar_pos, sidebar_offset;
   double shadow_progress;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   sidebar_width = get_sidebar_width (self, width, TRUE);
   self->sidebar_width = sidebar_width;
@@ -700,6 +715,8 @@ allocate_collapsed (GtkWidget *widget,
                                      baseline, -sidebar_offset, 0,
                                      shadow_progress, GTK_PAN_DIRECTION_RIGHT);
   }
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static gboolean
@@ -872,6 +889,17 @@ adw_overlay_split_view_set_property (GObject      *object,
   }
 }
 
+static void
+adw_overlay_split_view_unroot (GtkWidget *widget)
+{
+  AdwOverlaySplitView *self = ADW_OVERLAY_SPLIT_VIEW (widget);
+
+  adw_adaptive_context_invalidate (self->sidebar_context);
+  adw_adaptive_context_invalidate (self->content_context);
+
+  GTK_WIDGET_CLASS (adw_overlay_split_view_parent_class)->unroot (widget);
+}
+
 static void
 adw_overlay_split_view_dispose (GObject *object)
 {
@@ -888,6 +916,8 @@ adw_overlay_split_view_dispose (GObject *object)
   g_clear_object (&self->shadow_helper);
   g_clear_object (&self->swipe_tracker);
   g_clear_object (&self->animation);
+  g_clear_object (&self->sidebar_context);
+  g_clear_object (&self->content_context);
 
   self->shortcut_controller = NULL;
 
@@ -905,6 +935,7 @@ adw_overlay_split_view_class_init (AdwOverlaySplitViewClass *klass)
   object_class->dispose = adw_overlay_split_view_dispose;
 
   widget_class->snapshot = adw_overlay_split_view_snapshot;
+  widget_class->unroot = adw_overlay_split_view_unroot;
   widget_class->direction_changed = adw_overlay_split_view_direction_changed;
   widget_class->compute_expand = adw_widget_compute_expand;
 
@@ -1125,7 +1156,13 @@ adw_overlay_split_view_init (AdwOverlaySplitView *self)
   g_signal_connect (self->swipe_tracker, "update-swipe", G_CALLBACK (update_swipe_cb), self);
   g_signal_connect (self->swipe_tracker, "end-swipe", G_CALLBACK (end_swipe_cb), self);
 
+  self->sidebar_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_SIDEBAR);
+  self->content_context =
+    adw_adaptive_context_new (GTK_WIDGET (self), ADW_ADAPTIVE_CONTEXT_SPLIT_VIEW_CONTENT);
+
   self->content_bin = adw_bin_new ();
+  adw_adaptive_context_attach (self->content_context, self->content_bin);
   gtk_widget_set_parent (self->content_bin, GTK_WIDGET (self));
 
   self->shield = adw_gizmo_new ("widget", NULL, NULL, NULL, NULL, NULL, NULL);
@@ -1136,6 +1173,7 @@ adw_overlay_split_view_init (AdwOverlaySplitView *self)
                                  gtk_custom_layout_new (adw_widget_get_request_mode,
                                                         measure_sidebar,
                                                         allocate_sidebar));
+  adw_adaptive_context_attach (self->sidebar_context, self->sidebar_bin);
   gtk_widget_set_parent (self->sidebar_bin, GTK_WIDGET (self));
 
   gesture = GTK_EVENT_CONTROLLER (gtk_gesture_click_new ());
@@ -8,11 +8,15 @@
 
 #include "adw-preferences-group-private.h"
 
+#include "adw-action-row.h"
 #include "adw-css-class-binding.h"
+#include "adw-gizmo-private.h"
 #include "adw-gtkbuilder-utils-private.h"
 #include "adw-preferences-row.h"
 #include "adw-widget-utils-private.h"
 
+#include <math.h>
+
 /**
  * AdwPreferencesGroup:
  *
@@ -45,6 +49,14 @@
  * When the "type" attribute of a child is `header-suffix`, the child
  * is set as the suffix on the end of the title and description.
  *
+ * ## Large Lists
+ *
+ * [method@PreferencesGroup.bind_model] creates a row for every item of the
+ * model up front, which becomes slow with thousands of items, such as installed
+ * fonts or extensions. Use [method@PreferencesGroup.bind_model_with_factory]
+ * instead to show them in a [class@Gtk.ListView] that only creates rows for
+ * the visible items and reuses them while scrolling.
+ *
  * ## CSS nodes
  *
  * `AdwPreferencesGroup` has a single CSS node with name `preferencesgroup`.
@@ -66,6 +78,13 @@ typedef struct
   gboolean separate_rows;
 
   GListModel *rows;
+
+  GtkWidget *list_view_bin;
+  GtkListView *list_view;
+  GListModel *list_view_model;
+  GtkAdjustment *page_adjustment;
+  int list_view_top;
+  gboolean syncing_list_view;
 } AdwPreferencesGroupPrivate;
 
 static void adw_preferences_group_buildable_init (GtkBuildableIface *iface);
@@ -122,6 +141,187 @@ update_listbox_visibility (AdwPreferencesGroup *self)
                           g_list_model_get_n_items (priv->rows) > 0);
 }
 
+static void
+update_list_view_visibility (AdwPreferencesGroup *self)
+{
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+
+  gtk_widget_set_visible (priv->list_view_bin,
+                          g_list_model_get_n_items (priv->list_view_model) > 0);
+}
+
+static void
+list_view_activate_cb (AdwPreferencesGroup *self,
+                       guint                position)
+{
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+  GtkWidget *item, *row;
+
+  /* Only the factory knows the rows, so find the one at @position through
+   * the list view: focusing an item gives focus to its widget. The activated
+   * item is usually focused already, from a click or from the keyboard */
+  gtk_list_view_scroll_to (priv->list_view, position, GTK_LIST_SCROLL_FOCUS, NULL);
+
+  item = gtk_widget_get_focus_child (GTK_WIDGET (priv->list_view));
+
+  if (!item)
+    return;
+
+  row = gtk_widget_get_first_child (item);
+
+  if (ADW_IS_ACTION_ROW (row))
+    adw_action_row_activate (ADW_ACTION_ROW (row));
+}
+
+static void
+page_adjustment_value_changed_cb (AdwPreferencesGroup *self)
+{
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+
+  gtk_widget_queue_allocate (priv->list_view_bin);
+}
+
+static void
+set_page_adjustment (AdwPreferencesGroup *self,
+                     GtkAdjustment       *adjustment)
+{
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+
+  if (priv->page_adjustment == adjustment)
+    return;
+
+  if (priv->page_adjustment)
+    g_signal_handlers_disconnect_by_func (priv->page_adjustment,
+                                          page_adjustment_value_changed_cb, self);
+
+  g_set_object (&priv->page_adjustment, adjustment);
+
+  if (adjustment)
+    g_signal_connect_swapped (adjustment, "value-changed",
+                              G_CALLBACK (page_adjustment_value_changed_cb), self);
+}
+
+static void
+list_view_adjustment_value_changed_cb (AdwPreferencesGroup *self,
+                                       GtkAdjustment       *adjustment)
+{
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+  double delta;
+
+  if (priv->syncing_list_view || !priv->page_adjustment)
+    return;
+
+  /* The list view scrolled itself, e.g. to move focus to the next item.
+   * Scroll the page instead, the list view will follow it */
+  delta = gtk_adjustment_get_value (adjustment) - priv->list_view_top;
+
+  gtk_adjustment_set_value (priv->page_adjustment,
+                            gtk_adjustment_get_value (priv->page_adjustment) + delta);
+}
+
+static void
+list_view_bin_measure (AdwGizmo       *bin,
+                       GtkOrientation  orientation,
+                       int             for_size,
+                       int            *minimum,
+                       int            *natural,
+                       int            *minimum_baseline,
+                       int            *natural_baseline)
+{
+  GtkWidget *list_view = gtk_widget_get_first_child (GTK_WIDGET (bin));
+
+  gtk_widget_measure (list_view, orientation, for_size,
+                      minimum, natural, NULL, NULL);
+
+  /* The list view doesn't scroll, the page does */
+  if (orientation == GTK_ORIENTATION_VERTICAL)
+    *minimum = *natural;
+}
+
+static void
+list_view_bin_allocate (AdwGizmo *bin,
+                        int       width,
+                        int       height,
+                        int       baseline)
+{
+  GtkWidget *widget = gtk_widget_get_ancestor (GTK_WIDGET (bin), ADW_TYPE_PREFERENCES_GROUP);
+  AdwPreferencesGroup *self = ADW_PREFERENCES_GROUP (widget);
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+  GtkWidget *scrolled_window, *viewport = NULL;
+  GtkAdjustment *adjustment;
+  graphene_rect_t bounds;
+  int top = 0, bottom = height;
+
+  scrolled_window = gtk_widget_get_ancestor (GTK_WIDGET (bin), GTK_TYPE_SCROLLED_WINDOW);
+
+  if (scrolled_window)
+    viewport = gtk_scrolled_window_get_child (GTK_SCROLLED_WINDOW (scrolled_window));
+
+  if (viewport) {
+    set_page_adjustment (self, gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled_window)));
+
+    /* Only give the list view the part of the page that is visible, so that
+     * it only creates rows for it */
+    if (gtk_widget_compute_bounds (GTK_WIDGET (bin), viewport, &bounds)) {
+      top = CLAMP ((int) floorf (-bounds.origin.y), 0, height);
+      bottom = CLAMP ((int) ceilf (gtk_widget_get_height (viewport) - bounds.origin.y),
+                      top, height);
+    }
+  } else {
+    set_page_adjustment (self, NULL);
+  }
+
+  adjustment = gtk_scrollable_get_vadjustment (GTK_SCROLLABLE (priv->list_view));
+
+  priv->syncing_list_view = TRUE;
+  priv->list_view_top = top;
+
+  gtk_adjustment_configure (adjustment, top, 0, height,
+                            gtk_adjustment_get_step_increment (adjustment),
+                            gtk_adjustment_get_page_increment (adjustment),
+                            bottom - top);
+
+  gtk_widget_allocate (GTK_WIDGET (priv->list_view), width, bottom - top, -1,
+                       gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (0, top)));
+
+  priv->syncing_list_view = FALSE;
+}
+
+static void
+create_list_view (AdwPreferencesGroup *self)
+{
+  AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
+  GtkAdjustment *adjustment;
+
+  priv->list_view = GTK_LIST_VIEW (gtk_list_view_new (NULL, NULL));
+  gtk_list_view_set_single_click_activate (priv->list_view, TRUE);
+  gtk_list_view_set_tab_behavior (priv->list_view, GTK_LIST_TAB_ITEM);
+  g_signal_connect_swapped (priv->list_view, "activate",
+                            G_CALLBACK (list_view_activate_cb), self);
+  g_signal_connect (priv->list_view, "keynav-failed",
+                    G_CALLBACK (adw_widget_on_vertical_keynav_failed), NULL);
+
+  adjustment = gtk_adjustment_new (0, 0, 0, 0, 0, 0);
+  g_signal_connect_swapped (adjustment, "value-changed",
+                            G_CALLBACK (list_view_adjustment_value_changed_cb), self);
+  gtk_scrollable_set_vadjustment (GTK_SCROLLABLE (priv->list_view), adjustment);
+
+  /* The list view only creates rows for the area it's allocated, so instead
+   * of scrolling it separately, it's allocated over the visible part of the
+   * page and scrolled along with it */
+  priv->list_view_bin =
+    adw_gizmo_new ("widget", list_view_bin_measure, list_view_bin_allocate,
+                   NULL, NULL,
+                   (AdwGizmoFocusFunc) adw_widget_focus_child,
+                   (AdwGizmoGrabFocusFunc) adw_widget_grab_focus_child);
+  gtk_widget_set_overflow (priv->list_view_bin, GTK_OVERFLOW_HIDDEN);
+  gtk_widget_add_css_class (priv->list_view_bin, "boxed-list-view");
+  gtk_widget_set_parent (GTK_WIDGET (priv->list_view), priv->list_view_bin);
+
+  gtk_box_insert_child_after (priv->listbox_box, priv->list_view_bin,
+                              GTK_WIDGET (priv->listbox));
+}
+
 static gboolean
 is_single_line (AdwPreferencesGroup *self)
 {
@@ -231,9 +431,14 @@ adw_preferences_group_dispose (GObject *object)
   AdwPreferencesGroupPrivate *priv = adw_preferences_group_get_instance_private (self);
 
   g_clear_object (&priv->rows);
+  g_clear_object (&priv->list_view_model);
+  set_page_adjustment (self, NULL);
 
   gtk_widget_dispose_template (GTK_WIDGET (self), ADW_TYPE_PREFERENCES_GROUP);
 
+  priv->list_view_bin = NULL;
+  priv->list_view = NULL;
+
   G_OBJECT_CLASS (adw_preferences_group_parent_class)->dispose (object);
 }
 
@@ -692,6 +897,9 @@ adw_preferences_group_set_separate_rows (AdwPreferencesGroup *self,
  *
  * See [method@Gtk.ListBox.bind_model].
  *
+ * This creates a row for every item in @model. For models with many items, use
+ * [method@PreferencesGroup.bind_model_with_factory] instead.
+ *
  * Since: 1.8
  */
 void
@@ -712,6 +920,85 @@ adw_preferences_group_bind_model (AdwPreferencesGroup        *self,
   gtk_list_box_bind_model (priv->listbox, model, create_row_func, user_data, user_data_free_func);
 }
 
+/**
+ * adw_preferences_group_bind_model_with_factory:
+ * @self: a preferences group
+ * @model: (nullable): a list model to bind
+ * @factory: (nullable): the factory creating rows for the items of @model, or
+ *   `NULL` in case @model is `NULL`
+ *
+ * Binds @model to @self using a [class@Gtk.ListView].
+ *
+ * Unlike [method@PreferencesGroup.bind_model], only the rows for the visible
+ * items are created, and they are reused as the list is scrolled, so the
+ * number of widgets stays the same no matter how many items @model has.
+ *
+ * The rows are shown below the other rows of @self, with the same style as the
+ * [`.boxed-list`](style-classes.html#boxed-lists-cards) style class.
+ * [property@PreferencesGroup:separate-rows] doesn't affect it. The list isn't
+ * scrolled separately: when @self is inside a [class@Gtk.ScrolledWindow], such
+ * as in [class@PreferencesPage], rows are only created for the items within its
+ * visible area.
+ *
+ * @factory should set a [class@PreferencesRow] as the child of each list item.
+ * Since the list items are already focusable, the rows shouldn't be. If
+ * @factory is a [class@Gtk.SignalListItemFactory], activating a list item
+ * activates its row if it's an [class@ActionRow].
+ *
+ * Rows created this way are not returned by
+ * [method@PreferencesGroup.get_row], and can't be searched for in
+ * [class@PreferencesDialog].
+ *
+ * Pass `NULL` as @model to remove the list.
+ *
+ * Since: 1.10
+ */
+void
+adw_preferences_group_bind_model_with_factory (AdwPreferencesGroup *self,
+                                               GListModel          *model,
+                                               GtkListItemFactory  *factory)
+{
+  AdwPreferencesGroupPrivate *priv;
+
+  g_return_if_fail (ADW_IS_PREFERENCES_GROUP (self));
+  g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
+  g_return_if_fail (model == NULL || GTK_IS_LIST_ITEM_FACTORY (factory));
+
+  priv = adw_preferences_group_get_instance_private (self);
+
+  if (priv->list_view_model) {
+    g_signal_handlers_disconnect_by_func (priv->list_view_model,
+                                          update_list_view_visibility, self);
+    g_clear_object (&priv->list_view_model);
+  }
+
+  if (!model) {
+    set_page_adjustment (self, NULL);
+
+    if (priv->list_view_bin) {
+      gtk_box_remove (priv->listbox_box, priv->list_view_bin);
+      priv->list_view_bin = NULL;
+      priv->list_view = NULL;
+    }
+
+    return;
+  }
+
+  if (!priv->list_view_bin)
+    create_list_view (self);
+
+  priv->list_view_model = G_LIST_MODEL (gtk_no_selection_new (g_object_ref (model)));
+
+  g_signal_connect_object (priv->list_view_model, "items-changed",
+                           G_CALLBACK (update_list_view_visibility), self,
+                           G_CONNECT_SWAPPED);
+
+  gtk_list_view_set_factory (priv->list_view, factory);
+  gtk_list_view_set_model (priv->list_view, GTK_SELECTION_MODEL (priv->list_view_model));
+
+  update_list_view_visibility (self);
+}
+
 /**
  * adw_preferences_group_get_rows:
  * @self: a preferences group
@@ -78,4 +78,9 @@ void adw_preferences_group_bind_model (AdwPreferencesGroup        *self,
                                        gpointer                    user_data,
                                        GDestroyNotify              user_data_free_func);
 
+ADW_AVAILABLE_IN_1_10
+void adw_preferences_group_bind_model_with_factory (AdwPreferencesGroup *self,
+                                                    GListModel          *model,
+                                                    GtkListItemFactory  *factory);
+
 G_END_DECLS
@@ -15,4 +15,9 @@ G_BEGIN_DECLS
 void adw_shortcut_label_set_wrap (AdwShortcutLabel *self,
                                   gboolean          wrap);
 
+void adw_shortcut_label_set_draw_keycaps (AdwShortcutLabel *self,
+                                          gboolean          draw_keycaps);
+
+char *adw_shortcut_label_get_search_text (const char *accelerator) G_GNUC_WARN_UNUSED_RESULT;
+
 G_END_DECLS
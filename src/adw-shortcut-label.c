@@ -13,6 +13,7 @@
 
 #include "adw-shortcut-label-private.h"
 
+#include "adw-style-manager.h"
 #include "adw-widget-utils-private.h"
 #include "adw-wrap-layout.h"
 
@@ -21,6 +22,19 @@
 #define GETTEXT_PACKAGE_GTK "gtk40"
 #define GTK_KEY_LABEL(str) (g_dpgettext2 (GETTEXT_PACKAGE_GTK, "keyboard label", (str)))
 
+#define SPACING 6
+
+/* The keycap metrics and colors when drawing keycaps directly, see .keycap in
+ * _shortcuts-dialog.scss */
+#define KEYCAP_PADDING 6
+#define KEYCAP_MIN_WIDTH 20
+#define KEYCAP_RADIUS 6
+#define KEYCAP_SHADE_SIZE 2
+#define KEYCAP_BG_OPACITY 0.1f
+#define KEYCAP_BORDER_OPACITY 0.5f
+#define DIM_OPACITY 0.55f
+#define DIM_OPACITY_HC 0.9f
+
 /**
  * AdwShortcutLabel:
  *
@@ -92,6 +106,23 @@
  * Since: 1.8
  */
 
+typedef struct {
+  PangoLayout *layout;
+  int width;
+  int height;
+} Keycap;
+
+typedef struct {
+  /* Either a separator, drawn using a shared layout, or a set of keycaps */
+  PangoLayout *separator;
+  GArray *keycaps;
+
+  int width;
+  int height;
+  int x;
+  int y;
+} Item;
+
 struct _AdwShortcutLabel
 {
   GtkWidget parent_instance;
@@ -99,6 +130,12 @@ struct _AdwShortcutLabel
   char *accelerator;
   char *disabled_text;
   gboolean wrap;
+
+  gboolean draw_keycaps;
+  GArray *items;
+  GHashTable *separators;
+  gboolean item_sizes_valid;
+  guint pango_context_serial;
 };
 
 G_DEFINE_FINAL_TYPE (AdwShortcutLabel, adw_shortcut_label, GTK_TYPE_WIDGET)
@@ -367,21 +404,88 @@ dim_label (const char *text)
   return label;
 }
 
+static PangoLayout *
+create_layout (AdwShortcutLabel *self,
+               const char       *markup)
+{
+  PangoLayout *layout = gtk_widget_create_pango_layout (GTK_WIDGET (self), NULL);
+
+  pango_layout_set_markup (layout, markup, -1);
+
+  return layout;
+}
+
+static void
+clear_keycap (Keycap *keycap)
+{
+  g_clear_object (&keycap->layout);
+}
+
+static void
+clear_item (Item *item)
+{
+  g_clear_pointer (&item->keycaps, g_array_unref);
+}
+
+static void
+display_separator (AdwShortcutLabel *self,
+                   const char       *text)
+{
+  Item item = { 0 };
+
+  if (!self->draw_keycaps) {
+    gtk_widget_set_parent (dim_label (text), GTK_WIDGET (self));
+    return;
+  }
+
+  /* The same separator is usually repeated many times, so draw every copy
+   * of it with the same layout */
+  item.separator = g_hash_table_lookup (self->separators, text);
+
+  if (!item.separator) {
+    char *markup = g_markup_escape_text (text, -1);
+
+    item.separator = create_layout (self, markup);
+    g_hash_table_insert (self->separators, g_strdup (text), item.separator);
+
+    g_free (markup);
+  }
+
+  g_array_append_val (self->items, item);
+}
+
 static void
-display_shortcut (GtkWidget       *self,
-                  guint            key,
-                  GdkModifierType  modifier)
+display_shortcut (AdwShortcutLabel *self,
+                  guint             key,
+                  GdkModifierType   modifier)
 {
-  GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0);
+  GtkWidget *box = NULL;
+  Item item = { 0 };
   char **keys = NULL;
   int i;
   guint n_mods;
 
-  gtk_widget_set_direction (GTK_WIDGET (box), GTK_TEXT_DIR_LTR);
+  if (self->draw_keycaps) {
+    item.keycaps = g_array_new (FALSE, TRUE, sizeof (Keycap));
+    g_array_set_clear_func (item.keycaps, (GDestroyNotify) clear_keycap);
+  } else {
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0);
+    gtk_widget_set_direction (GTK_WIDGET (box), GTK_TEXT_DIR_LTR);
+  }
 
   keys = get_labels (key, modifier, &n_mods);
   for (i = 0; keys[i]; i++) {
-    GtkWidget *disp = gtk_label_new (keys[i]);
+    GtkWidget *disp;
+
+    if (self->draw_keycaps) {
+      Keycap keycap = { 0 };
+
+      keycap.layout = create_layout (self, keys[i]);
+      g_array_append_val (item.keycaps, keycap);
+      continue;
+    }
+
+    disp = gtk_label_new (keys[i]);
 
     gtk_widget_add_css_class (disp, "keycap");
     gtk_label_set_use_markup (GTK_LABEL (disp), TRUE);
@@ -389,7 +493,10 @@ display_shortcut (GtkWidget       *self,
     gtk_box_append (GTK_BOX (box), disp);
   }
 
-  gtk_widget_set_parent (box, self);
+  if (self->draw_keycaps)
+    g_array_append_val (self->items, item);
+  else
+    gtk_widget_set_parent (box, GTK_WIDGET (self));
 
   g_strfreev (keys);
 }
@@ -414,7 +521,7 @@ parse_combination (AdwShortcutLabel *self,
       break;
     }
 
-    display_shortcut (GTK_WIDGET (self), key, modifier);
+    display_shortcut (self, key, modifier);
 
     /* Use gtk_accelerator_get_label() which is meant for user-facing localized
      * strings, and not gtk_accelerator_get_accessible_label() which corresponds
@@ -445,7 +552,7 @@ parse_sequence (AdwShortcutLabel *self,
   for (k = 0; accels[k]; k++) {
     if (k > 0) {
       const char *arrow = is_rtl ? "←" : "→";
-      gtk_widget_set_parent (dim_label (arrow), GTK_WIDGET (self));
+      display_separator (self, arrow);
       g_string_append (accessible_label_string, arrow);
     }
 
@@ -475,7 +582,7 @@ parse_range (AdwShortcutLabel *self,
   if (!parse_sequence (self, str, accessible_label_string))
     return FALSE;
 
-  gtk_widget_set_parent (dim_label ("⋯"), GTK_WIDGET (self));
+  display_separator (self, "⋯");
   g_string_append (accessible_label_string, "…");
 
   if (!parse_sequence (self, dots + 3, accessible_label_string))
@@ -489,15 +596,16 @@ clear_children (AdwShortcutLabel *self)
 {
   GtkWidget *child;
 
-  child = gtk_widget_get_first_child (GTK_WIDGET (self));
+  if (self->items)
+    g_array_set_size (self->items, 0);
 
-  while (child) {
-    GtkWidget *next = gtk_widget_get_next_sibling (child);
+  if (self->separators)
+    g_hash_table_remove_all (self->separators);
 
-    gtk_widget_unparent (child);
+  self->item_sizes_valid = FALSE;
 
-    child = next;
-  }
+  while ((child = gtk_widget_get_first_child (GTK_WIDGET (self))))
+    gtk_widget_unparent (child);
 }
 
 static void
@@ -511,11 +619,8 @@ rebuild (AdwShortcutLabel *self)
   clear_children (self);
 
   if (self->accelerator == NULL || self->accelerator[0] == '\0') {
-    GtkWidget *label;
-
-    label = dim_label (self->disabled_text);
-
-    gtk_widget_set_parent (label, GTK_WIDGET (self));
+    display_separator (self, self->disabled_text);
+    gtk_widget_queue_resize (GTK_WIDGET (self));
     return;
   }
 
@@ -524,7 +629,7 @@ rebuild (AdwShortcutLabel *self)
   accessible_label_string = g_string_new (NULL);
   for (k = 0; accels[k]; k++) {
     if (k > 0) {
-      gtk_widget_set_parent (dim_label ("/"), GTK_WIDGET (self));
+      display_separator (self, "/");
       g_string_append (accessible_label_string, " ");
     }
 
@@ -541,6 +646,391 @@ rebuild (AdwShortcutLabel *self)
 
   g_free (accessible_label);
   g_strfreev (accels);
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+}
+
+static void
+append_search_text_for_combination (GString    *string,
+                                    const char *str)
+{
+  char **accels = g_strsplit (str, "&", 0);
+  int k;
+
+  for (k = 0; accels[k]; k++) {
+    GdkModifierType modifier = 0;
+    guint key = 0;
+    char **keys;
+    char *label;
+    guint n_mods, i;
+
+    if (!gtk_accelerator_parse (accels[k], &key, &modifier))
+      continue;
+
+    /* The keycap labels are markup, strip it */
+    keys = get_labels (key, modifier, &n_mods);
+    for (i = 0; keys[i]; i++) {
+      char *text = NULL;
+
+      if (!pango_parse_markup (keys[i], -1, 0, NULL, &text, NULL, NULL))
+        continue;
+
+      g_string_append_printf (string, "%s ", text);
+      g_free (text);
+    }
+
+    label = gtk_accelerator_get_label (key, modifier);
+    g_string_append_printf (string, "%s ", label);
+
+    g_free (label);
+    g_strfreev (keys);
+  }
+
+  g_strfreev (accels);
+}
+
+/*
+ * adw_shortcut_label_get_search_text:
+ * @accelerator: an accelerator in the `AdwShortcutLabel:accelerator` format
+ *
+ * Gets the text a user can search @accelerator by.
+ *
+ * This includes both the localized keycap labels and the labels produced by
+ * gtk_accelerator_get_label(), separated with spaces.
+ *
+ * Returns: (transfer full): the search text
+ */
+char *
+adw_shortcut_label_get_search_text (const char *accelerator)
+{
+  GString *string;
+  char **accels;
+  int k;
+
+  if (!accelerator || !*accelerator)
+    return g_strdup ("");
+
+  string = g_string_new (NULL);
+  accels = g_strsplit (accelerator, " ", 0);
+
+  for (k = 0; accels[k]; k++) {
+    char **ranges = g_strsplit (accels[k], "...", 0);
+    int i;
+
+    for (i = 0; ranges[i]; i++) {
+      char **sequence = g_strsplit (ranges[i], "+", 0);
+      int j;
+
+      for (j = 0; sequence[j]; j++)
+        append_search_text_for_combination (string, sequence[j]);
+
+      g_strfreev (sequence);
+    }
+
+    g_strfreev (ranges);
+  }
+
+  g_strfreev (accels);
+
+  return g_string_free (string, FALSE);
+}
+
+static void
+get_layout_size (PangoLayout *layout,
+                 int         *width,
+                 int         *height)
+{
+  PangoRectangle rect;
+
+  pango_layout_get_pixel_extents (layout, NULL, &rect);
+
+  *width = rect.width;
+  *height = rect.height;
+}
+
+static void
+update_item_sizes (AdwShortcutLabel *self)
+{
+  PangoContext *context = gtk_widget_get_pango_context (GTK_WIDGET (self));
+  guint serial = pango_context_get_serial (context);
+  guint i, j;
+
+  /* The layouts only need to be measured again when the items or the font
+   * have changed */
+  if (self->item_sizes_valid && self->pango_context_serial == serial)
+    return;
+
+  for (i = 0; i < self->items->len; i++) {
+    Item *item = &g_array_index (self->items, Item, i);
+
+    if (item->separator) {
+      get_layout_size (item->separator, &item->width, &item->height);
+      item->height += KEYCAP_PADDING * 2;
+      continue;
+    }
+
+    item->width = 0;
+    item->height = 0;
+
+    for (j = 0; j < item->keycaps->len; j++) {
+      Keycap *keycap = &g_array_index (item->keycaps, Keycap, j);
+
+      get_layout_size (keycap->layout, &keycap->width, &keycap->height);
+      keycap->width = MAX (keycap->width, KEYCAP_MIN_WIDTH) + KEYCAP_PADDING * 2;
+      keycap->height += KEYCAP_PADDING * 2;
+
+      if (j > 0)
+        item->width += SPACING;
+
+      item->width += keycap->width;
+      item->height = MAX (item->height, keycap->height);
+    }
+  }
+
+  self->item_sizes_valid = TRUE;
+  self->pango_context_serial = serial;
+}
+
+static int
+layout_items (AdwShortcutLabel *self,
+              int               for_width,
+              gboolean          allocate)
+{
+  int line_start = 0, line_width = 0, line_height = 0, y = 0;
+  guint i, j;
+
+  for (i = 0; i <= self->items->len; i++) {
+    Item *item = NULL;
+
+    if (i < self->items->len) {
+      item = &g_array_index (self->items, Item, i);
+
+      if (i == line_start ||
+          !self->wrap ||
+          for_width < 0 ||
+          line_width + SPACING + item->width <= for_width) {
+        if (i > line_start)
+          line_width += SPACING;
+
+        item->x = line_width;
+        line_width += item->width;
+        line_height = MAX (line_height, item->height);
+        continue;
+      }
+    }
+
+    /* Either the last item or the first item not fitting into the line */
+    if (allocate) {
+      for (j = line_start; j < i; j++) {
+        Item *line_item = &g_array_index (self->items, Item, j);
+
+        line_item->y = y + (line_height - line_item->height) / 2;
+      }
+    }
+
+    y += line_height;
+
+    if (!item)
+      break;
+
+    y += SPACING;
+    line_start = i;
+    line_width = 0;
+    line_height = 0;
+    i--;
+  }
+
+  return y;
+}
+
+static GtkSizeRequestMode
+keycaps_get_request_mode (GtkWidget *widget)
+{
+  AdwShortcutLabel *self = ADW_SHORTCUT_LABEL (widget);
+
+  if (self->wrap)
+    return GTK_SIZE_REQUEST_HEIGHT_FOR_WIDTH;
+
+  return GTK_SIZE_REQUEST_CONSTANT_SIZE;
+}
+
+static void
+keycaps_measure (GtkWidget      *widget,
+                 GtkOrientation  orientation,
+                 int             for_size,
+                 int            *minimum,
+                 int            *natural,
+                 int            *minimum_baseline,
+                 int            *natural_baseline)
+{
+  AdwShortcutLabel *self = ADW_SHORTCUT_LABEL (widget);
+  int min = 0, nat = 0;
+  guint i;
+
+  update_item_sizes (self);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL) {
+    for (i = 0; i < self->items->len; i++) {
+      Item *item = &g_array_index (self->items, Item, i);
+
+      if (i > 0)
+        nat += SPACING;
+
+      nat += item->width;
+      min = MAX (min, item->width);
+    }
+
+    if (!self->wrap)
+      min = nat;
+  } else {
+    min = nat = layout_items (self, for_size, FALSE);
+  }
+
+  *minimum = min;
+  *natural = nat;
+  *minimum_baseline = -1;
+  *natural_baseline = -1;
+}
+
+static void
+keycaps_allocate (GtkWidget *widget,
+                  int        width,
+                  int        height,
+                  int        baseline)
+{
+  AdwShortcutLabel *self = ADW_SHORTCUT_LABEL (widget);
+  guint i;
+
+  update_item_sizes (self);
+  layout_items (self, width, TRUE);
+
+  if (gtk_widget_get_direction (widget) != GTK_TEXT_DIR_RTL)
+    return;
+
+  /* Keycaps within a shortcut still go left to right */
+  for (i = 0; i < self->items->len; i++) {
+    Item *item = &g_array_index (self->items, Item, i);
+
+    item->x = width - item->x - item->width;
+  }
+}
+
+static void
+snapshot_layout (GtkSnapshot   *snapshot,
+                 PangoLayout   *layout,
+                 int            x,
+                 int            y,
+                 int            width,
+                 int            height,
+                 const GdkRGBA *color)
+{
+  PangoRectangle rect;
+
+  pango_layout_get_pixel_extents (layout, NULL, &rect);
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot,
+                          &GRAPHENE_POINT_INIT (x + (width - rect.width) / 2 - rect.x,
+                                                y + (height - rect.height) / 2 - rect.y));
+  gtk_snapshot_append_layout (snapshot, layout, color);
+  gtk_snapshot_restore (snapshot);
+}
+
+static void
+snapshot_keycaps (AdwShortcutLabel *self,
+                  GtkSnapshot      *snapshot)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+  AdwStyleManager *manager = adw_style_manager_get_for_display (gtk_widget_get_display (widget));
+  gboolean high_contrast = adw_style_manager_get_high_contrast (manager);
+  GdkRGBA color, bg_color, border_color, shade_color;
+  guint i, j;
+
+  /* Everything is derived from the label's own color, the same way the
+   * stylesheet derives it from currentColor */
+  gtk_widget_get_color (widget, &color);
+
+  bg_color = color;
+  bg_color.alpha *= KEYCAP_BG_OPACITY;
+
+  border_color = color;
+  border_color.alpha *= KEYCAP_BORDER_OPACITY;
+
+  /* @card_shade_color */
+  shade_color = (GdkRGBA) { 0, 0, 6 / 255.0f,
+                            adw_style_manager_get_dark (manager) ? 0.36f : 0.07f };
+
+  for (i = 0; i < self->items->len; i++) {
+    Item *item = &g_array_index (self->items, Item, i);
+    int x;
+
+    if (item->separator) {
+      gtk_snapshot_push_opacity (snapshot, high_contrast ? DIM_OPACITY_HC : DIM_OPACITY);
+      snapshot_layout (snapshot, item->separator,
+                       item->x, item->y, item->width, item->height, &color);
+      gtk_snapshot_pop (snapshot);
+      continue;
+    }
+
+    x = item->x;
+
+    for (j = 0; j < item->keycaps->len; j++) {
+      Keycap *keycap = &g_array_index (item->keycaps, Keycap, j);
+      int y = item->y + (item->height - keycap->height) / 2;
+      GskRoundedRect outline;
+
+      gsk_rounded_rect_init_from_rect (&outline,
+                                       &GRAPHENE_RECT_INIT (x, y, keycap->width, keycap->height),
+                                       KEYCAP_RADIUS);
+
+      if (high_contrast)
+        gtk_snapshot_append_outset_shadow (snapshot, &outline, &border_color, 0, 0, 1, 0);
+
+      gtk_snapshot_push_rounded_clip (snapshot, &outline);
+      gtk_snapshot_append_color (snapshot, &bg_color, &outline.bounds);
+      gtk_snapshot_pop (snapshot);
+
+      gtk_snapshot_append_inset_shadow (snapshot, &outline, &shade_color,
+                                        0, -KEYCAP_SHADE_SIZE, 0, 0);
+
+      snapshot_layout (snapshot, keycap->layout,
+                       x, y, keycap->width, keycap->height, &color);
+
+      x += keycap->width + SPACING;
+    }
+  }
+}
+
+static void
+adw_shortcut_label_snapshot (GtkWidget   *widget,
+                             GtkSnapshot *snapshot)
+{
+  AdwShortcutLabel *self = ADW_SHORTCUT_LABEL (widget);
+
+  if (self->draw_keycaps)
+    snapshot_keycaps (self, snapshot);
+  else
+    GTK_WIDGET_CLASS (adw_shortcut_label_parent_class)->snapshot (widget, snapshot);
+}
+
+static void
+update_layout_manager (AdwShortcutLabel *self)
+{
+  GtkLayoutManager *layout;
+
+  if (self->draw_keycaps) {
+    layout = gtk_custom_layout_new (keycaps_get_request_mode,
+                                    keycaps_measure,
+                                    keycaps_allocate);
+  } else if (self->wrap) {
+    layout = adw_wrap_layout_new ();
+    adw_wrap_layout_set_child_spacing (ADW_WRAP_LAYOUT (layout), SPACING);
+    adw_wrap_layout_set_line_spacing (ADW_WRAP_LAYOUT (layout), SPACING);
+  } else {
+    layout = gtk_box_layout_new (GTK_ORIENTATION_HORIZONTAL);
+  }
+
+  gtk_widget_set_layout_manager (GTK_WIDGET (self), layout);
 }
 
 static void
@@ -549,6 +1039,8 @@ adw_shortcut_label_dispose (GObject *object)
   AdwShortcutLabel *self = ADW_SHORTCUT_LABEL (object);
 
   clear_children (self);
+  g_clear_pointer (&self->items, g_array_unref);
+  g_clear_pointer (&self->separators, g_hash_table_unref);
 
   G_OBJECT_CLASS (adw_shortcut_label_parent_class)->dispose (object);
 }
@@ -624,6 +1116,7 @@ adw_shortcut_label_class_init (AdwShortcutLabelClass *klass)
   object_class->get_property = adw_shortcut_label_get_property;
   object_class->set_property = adw_shortcut_label_set_property;
 
+  widget_class->snapshot = adw_shortcut_label_snapshot;
   widget_class->direction_changed = adw_shortcut_label_direction_changed;
 
   /**
@@ -775,8 +1268,6 @@ void
 adw_shortcut_label_set_wrap (AdwShortcutLabel *self,
                              gboolean          wrap)
 {
-  GtkLayoutManager *layout;
-
   g_return_if_fail (ADW_IS_SHORTCUT_LABEL (self));
 
   wrap = !!wrap;
@@ -786,15 +1277,66 @@ adw_shortcut_label_set_wrap (AdwShortcutLabel *self,
 
   self->wrap = wrap;
 
-  if (wrap) {
-    layout = adw_wrap_layout_new ();
-    adw_wrap_layout_set_child_spacing (ADW_WRAP_LAYOUT (layout), 6);
-    adw_wrap_layout_set_line_spacing (ADW_WRAP_LAYOUT (layout), 6);
+  rebuild (self);
+
+  update_layout_manager (self);
+}
+
+/*
+ * adw_shortcut_label_set_draw_keycaps:
+ * @self: a shortcut label
+ * @draw_keycaps: whether to draw keycaps directly
+ *
+ * Sets whether @self draws its keycaps directly instead of creating a label
+ * for each of them.
+ *
+ * In this mode @self has no children. It draws each keycap and separator as a
+ * cached Pango layout in its own snapshot, styled after `.keycap` using its own
+ * color and font, and every copy of the same separator uses the same layout.
+ * This keeps the number of widgets and style nodes constant when showing a
+ * large number of shortcuts, such as in `AdwShortcutsDialog`.
+ */
+void
+adw_shortcut_label_set_draw_keycaps (AdwShortcutLabel *self,
+                                     gboolean          draw_keycaps)
+{
+  AdwStyleManager *manager;
+
+  g_return_if_fail (ADW_IS_SHORTCUT_LABEL (self));
+
+  draw_keycaps = !!draw_keycaps;
+
+  if (self->draw_keycaps == draw_keycaps)
+    return;
+
+  clear_children (self);
+
+  self->draw_keycaps = draw_keycaps;
+
+  manager = adw_style_manager_get_for_display (gtk_widget_get_display (GTK_WIDGET (self)));
+
+  if (draw_keycaps) {
+    self->items = g_array_new (FALSE, TRUE, sizeof (Item));
+    g_array_set_clear_func (self->items, (GDestroyNotify) clear_item);
+
+    self->separators = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                              g_free, g_object_unref);
+
+    /* The keycap shade and border depend on these */
+    g_signal_connect_object (manager, "notify::dark",
+                             G_CALLBACK (gtk_widget_queue_draw), self,
+                             G_CONNECT_SWAPPED);
+    g_signal_connect_object (manager, "notify::high-contrast",
+                             G_CALLBACK (gtk_widget_queue_draw), self,
+                             G_CONNECT_SWAPPED);
   } else {
-    layout = gtk_box_layout_new (GTK_ORIENTATION_HORIZONTAL);
+    g_signal_handlers_disconnect_by_func (manager, gtk_widget_queue_draw, self);
+
+    g_clear_pointer (&self->items, g_array_unref);
+    g_clear_pointer (&self->separators, g_hash_table_unref);
   }
 
   rebuild (self);
 
-  gtk_widget_set_layout_manager (GTK_WIDGET (self), layout);
+  update_layout_manager (self);
 }
@@ -29,4 +29,7 @@ GtkWidget *adw_shortcut_row_new (AdwShortcutsItem *item) G_GNUC_WARN_UNUSED_RESU
 
 AdwShortcutsItem *adw_shortcut_row_get_item (AdwShortcutRow *self);
 
+char *adw_shortcut_row_resolve_accelerator (AdwShortcutsItem *item,
+                                            GtkWidget        *widget) G_GNUC_WARN_UNUSED_RESULT;
+
 G_END_DECLS
@@ -57,41 +57,11 @@ string_is_not_empty (GBinding     *binding,
 static void
 update_accel (AdwShortcutRow *self)
 {
-  const char *accel = adw_shortcuts_item_get_accelerator (self->item);
-  const char *action_name = adw_shortcuts_item_get_action_name (self->item);
-  char *action_accel = NULL;
-
-  if (action_name && *action_name) {
-    GtkRoot *root = gtk_widget_get_root (GTK_WIDGET (self));
-
-    if (GTK_IS_WINDOW (root)) {
-      GtkApplication *app = gtk_window_get_application (GTK_WINDOW (root));
-
-      if (!GTK_IS_APPLICATION (app)) {
-        GtkWindow *transient_for = gtk_window_get_transient_for (GTK_WINDOW (root));
-
-        if (GTK_IS_WINDOW (transient_for))
-          app = gtk_window_get_application (GTK_WINDOW (transient_for));
-      }
-
-      if (GTK_IS_APPLICATION (app)) {
-        char **action_accels = gtk_application_get_accels_for_action (app, action_name);
-        char *new_action_accels = g_strjoinv (" ", action_accels);
-
-        g_free (action_accel);
-        action_accel = new_action_accels;
-
-        g_strfreev (action_accels);
-      }
-    }
-  }
+  char *accel = adw_shortcut_row_resolve_accelerator (self->item, GTK_WIDGET (self));
 
-  if (action_accel && *action_accel)
-    adw_shortcut_label_set_accelerator (ADW_SHORTCUT_LABEL (self->accel_label), action_accel);
-  else
-    adw_shortcut_label_set_accelerator (ADW_SHORTCUT_LABEL (self->accel_label), accel);
+  adw_shortcut_label_set_accelerator (ADW_SHORTCUT_LABEL (self->accel_label), accel);
 
-  g_free (action_accel);
+  g_free (accel);
 }
 
 static void
@@ -258,6 +228,7 @@ adw_shortcut_row_init (AdwShortcutRow *self)
      doesn't actually have a shortcut */
   adw_shortcut_label_set_disabled_text (ADW_SHORTCUT_LABEL (self->accel_label), _("No Shortcut"));
   adw_shortcut_label_set_wrap (ADW_SHORTCUT_LABEL (self->accel_label), TRUE);
+  adw_shortcut_label_set_draw_keycaps (ADW_SHORTCUT_LABEL (self->accel_label), TRUE);
   adw_wrap_box_append (ADW_WRAP_BOX (box), self->accel_label);
 }
 
@@ -276,3 +247,55 @@ adw_shortcut_row_get_item (AdwShortcutRow *self)
 
   return self->item;
 }
+
+/*
+ * adw_shortcut_row_resolve_accelerator:
+ * @item: a shortcuts item
+ * @widget: the widget @item is displayed in
+ *
+ * Gets the accelerator to display for @item.
+ *
+ * If @item has an action name and the application of the window containing
+ * @widget has accelerators for it, those are used instead of
+ * [property@ShortcutsItem:accelerator].
+ *
+ * Returns: (transfer full) (nullable): the accelerator
+ */
+char *
+adw_shortcut_row_resolve_accelerator (AdwShortcutsItem *item,
+                                      GtkWidget        *widget)
+{
+  const char *accel = adw_shortcuts_item_get_accelerator (item);
+  const char *action_name = adw_shortcuts_item_get_action_name (item);
+  char *action_accel = NULL;
+
+  if (action_name && *action_name) {
+    GtkRoot *root = gtk_widget_get_root (widget);
+
+    if (GTK_IS_WINDOW (root)) {
+      GtkApplication *app = gtk_window_get_application (GTK_WINDOW (root));
+
+      if (!GTK_IS_APPLICATION (app)) {
+        GtkWindow *transient_for = gtk_window_get_transient_for (GTK_WINDOW (root));
+
+        if (GTK_IS_WINDOW (transient_for))
+          app = gtk_window_get_application (GTK_WINDOW (transient_for));
+      }
+
+      if (GTK_IS_APPLICATION (app)) {
+        char **action_accels = gtk_application_get_accels_for_action (app, action_name);
+
+        action_accel = g_strjoinv (" ", action_accels);
+
+        g_strfreev (action_accels);
+      }
+    }
+  }
+
+  if (action_accel && *action_accel)
+    return action_accel;
+
+  g_free (action_accel);
+
+  return g_strdup (accel);
+}
@@ -12,6 +12,7 @@
 
 #include "adw-preferences-group.h"
 #include "adw-preferences-page.h"
+#include "adw-shortcut-label-private.h"
 #include "adw-shortcut-row-private.h"
 #include "adw-view-stack.h"
 #include "adw-widget-utils-private.h"
@@ -134,10 +135,13 @@ struct _AdwShortcutsDialog
   GtkFilterListModel *title_sections;
 
   GListModel *all_rows;
-  GtkStringFilter *title_filter;
-  GtkStringFilter *subtitle_filter;
+  GtkCustomFilter *search_filter;
   GtkFilterListModel *search_model;
 
+  char *search_text;
+  GHashTable *search_index;
+  GHashTable *item_rows;
+
   AdwShortcutsSection *selected_section;
   GtkWidget *selected_button;
 };
@@ -247,60 +251,164 @@ update_stack (AdwShortcutsDialog *self)
   update_nav_visibility (self);
 }
 
+static char *
+normalize_search_text (const char *text)
+{
+  char *normalized, *casefolded;
+
+  normalized = g_utf8_normalize (text, -1, G_NORMALIZE_ALL);
+  if (!normalized)
+    return g_strdup ("");
+
+  casefolded = g_utf8_casefold (normalized, -1);
+
+  g_free (normalized);
+
+  return casefolded;
+}
+
 static void
-stop_search (AdwShortcutsDialog *self)
+invalidate_search_index_entry (AdwShortcutsDialog *self,
+                               AdwShortcutsItem   *item)
 {
-  gtk_editable_set_text (GTK_EDITABLE (self->search_entry), "");
-  gtk_string_filter_set_search (self->title_filter, "");
-  gtk_string_filter_set_search (self->subtitle_filter, "");
-  update_stack (self);
+  /* Keep the key so that we don't connect to the item twice */
+  g_hash_table_insert (self->search_index, g_object_ref (item), NULL);
 }
 
-static GtkWidget *
-find_row (AdwShortcutsDialog *self,
-          AdwShortcutsItem   *the_item)
+static void
+item_notify_cb (AdwShortcutsDialog *self,
+                GParamSpec         *pspec,
+                AdwShortcutsItem   *item)
 {
-  guint i, j, n, m;
-  gboolean found = FALSE;
-  AdwPreferencesGroup *group;
-  GtkWidget *row;
+  if (!self->search_index)
+    return;
 
-  n = g_list_model_get_n_items (G_LIST_MODEL (self->filtered_sections));
+  invalidate_search_index_entry (self, item);
 
-  for (i = 0; i < n; i++) {
-    GListModel *section;
+  gtk_filter_changed (GTK_FILTER (self->search_filter), GTK_FILTER_CHANGE_DIFFERENT);
+}
 
-    section = g_list_model_get_item (G_LIST_MODEL (self->filtered_sections), i);
-    m = g_list_model_get_n_items (section);
+static const char *
+get_search_index_entry (AdwShortcutsDialog *self,
+                        AdwShortcutsItem   *item)
+{
+  const char *title, *subtitle;
+  char *accel, *accel_text, *text;
+  gpointer entry;
 
-    for (j = 0; j < m; j++) {
-      AdwShortcutsItem *item = g_list_model_get_item (section, j);
+  if (g_hash_table_lookup_extended (self->search_index, item, NULL, &entry)) {
+    if (entry)
+      return entry;
+  } else {
+    g_signal_connect_object (item, "notify",
+                             G_CALLBACK (item_notify_cb), self,
+                             G_CONNECT_SWAPPED);
+  }
 
-      if (item == the_item)
-        found = TRUE;
+  title = adw_shortcuts_item_get_title (item);
+  subtitle = adw_shortcuts_item_get_subtitle (item);
+  accel = adw_shortcut_row_resolve_accelerator (item, GTK_WIDGET (self));
+  accel_text = adw_shortcut_label_get_search_text (accel);
 
-      g_object_unref (item);
+  /* The search entry doesn't allow newlines, so a match can't span fields */
+  text = g_strdup_printf ("%s\n%s\n%s",
+                          title ? title : "",
+                          subtitle ? subtitle : "",
+                          accel_text);
 
-      if (found)
-        break;
-    }
+  entry = normalize_search_text (text);
 
-    g_object_unref (section);
+  g_hash_table_insert (self->search_index, g_object_ref (item), entry);
+
+  g_free (text);
+  g_free (accel_text);
+  g_free (accel);
+
+  return entry;
+}
+
+static void
+invalidate_search_index (AdwShortcutsDialog *self)
+{
+  GList *items = g_hash_table_get_keys (self->search_index);
+  GList *l;
+
+  for (l = items; l; l = l->next)
+    invalidate_search_index_entry (self, l->data);
+
+  g_list_free (items);
+
+  if (self->search_text && *self->search_text)
+    gtk_filter_changed (GTK_FILTER (self->search_filter), GTK_FILTER_CHANGE_DIFFERENT);
+}
+
+static gboolean
+search_filter_func (AdwShortcutsItem   *item,
+                    AdwShortcutsDialog *self)
+{
+  if (!self->search_text || !*self->search_text)
+    return TRUE;
+
+  return strstr (get_search_index_entry (self, item), self->search_text) != NULL;
+}
+
+static void
+set_search_text (AdwShortcutsDialog *self,
+                 const char         *text)
+{
+  char *search_text = normalize_search_text (text ? text : "");
+  GtkFilterChange change;
 
-    if (found)
-      break;
+  if (!g_strcmp0 (search_text, self->search_text)) {
+    g_free (search_text);
+    return;
   }
 
-  if (!found)
-    return NULL;
+  /* When the new text extends the old one, only the items that currently
+   * match need to be checked again, and the other way around */
+  if (!self->search_text || !*self->search_text)
+    change = GTK_FILTER_CHANGE_MORE_STRICT;
+  else if (!*search_text)
+    change = GTK_FILTER_CHANGE_LESS_STRICT;
+  else if (g_str_has_prefix (search_text, self->search_text))
+    change = GTK_FILTER_CHANGE_MORE_STRICT;
+  else if (g_str_has_prefix (self->search_text, search_text))
+    change = GTK_FILTER_CHANGE_LESS_STRICT;
+  else
+    change = GTK_FILTER_CHANGE_DIFFERENT;
 
-  group = adw_preferences_page_get_group (self->contents, i + N_BUILTIN_WIDGETS);
-  g_assert (group != NULL);
+  g_free (self->search_text);
+  self->search_text = search_text;
 
-  row = adw_preferences_group_get_row (group, j);
-  g_assert (row != NULL);
+  gtk_filter_changed (GTK_FILTER (self->search_filter), change);
+}
 
-  return row;
+static void
+stop_search (AdwShortcutsDialog *self)
+{
+  gtk_editable_set_text (GTK_EDITABLE (self->search_entry), "");
+  set_search_text (self, "");
+  update_stack (self);
+}
+
+static void
+row_destroy_cb (AdwShortcutsDialog *self,
+                GtkWidget          *row)
+{
+  AdwShortcutsItem *item = g_object_get_data (G_OBJECT (row), "-adw-shortcuts-dialog-item");
+
+  if (!self->item_rows)
+    return;
+
+  if (g_hash_table_lookup (self->item_rows, item) == row)
+    g_hash_table_remove (self->item_rows, item);
+}
+
+static GtkWidget *
+find_row (AdwShortcutsDialog *self,
+          AdwShortcutsItem   *item)
+{
+  return g_hash_table_lookup (self->item_rows, item);
 }
 
 static void
@@ -334,8 +442,7 @@ search_changed_cb (AdwShortcutsDialog *self)
 {
   const char *text = gtk_editable_get_text (GTK_EDITABLE (self->search_entry));
 
-  gtk_string_filter_set_search (self->title_filter, text);
-  gtk_string_filter_set_search (self->subtitle_filter, text);
+  set_search_text (self, text);
 
   update_stack (self);
 }
@@ -374,6 +481,13 @@ create_row (AdwShortcutsItem   *item,
 
   gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (row), FALSE);
 
+  g_object_set_data (G_OBJECT (row), "-adw-shortcuts-dialog-item", item);
+  g_hash_table_insert (self->item_rows, item, row);
+
+  g_signal_connect_object (row, "destroy",
+                           G_CALLBACK (row_destroy_cb), self,
+                           G_CONNECT_SWAPPED);
+
   return row;
 }
 
@@ -531,10 +645,33 @@ title_changed_cb (AdwShortcutsDialog *self)
 static void
 adw_shortcuts_dialog_root (GtkWidget *widget)
 {
+  AdwShortcutsDialog *self = ADW_SHORTCUTS_DIALOG (widget);
+  GtkRoot *root;
+
   GTK_WIDGET_CLASS (adw_shortcuts_dialog_parent_class)->root (widget);
 
   /* The previous size was calculated with empty content, so recalculate it */
   adw_dialog_set_content_height (ADW_DIALOG (widget), -1);
+
+  root = gtk_widget_get_root (widget);
+
+  /* Accelerators of action items depend on the application */
+  if (GTK_IS_WINDOW (root))
+    g_signal_connect_swapped (root, "keys-changed", G_CALLBACK (invalidate_search_index), self);
+
+  invalidate_search_index (self);
+}
+
+static void
+adw_shortcuts_dialog_unroot (GtkWidget *widget)
+{
+  AdwShortcutsDialog *self = ADW_SHORTCUTS_DIALOG (widget);
+  GtkRoot *root = gtk_widget_get_root (widget);
+
+  if (GTK_IS_WINDOW (root))
+    g_signal_handlers_disconnect_by_func (root, invalidate_search_index, self);
+
+  GTK_WIDGET_CLASS (adw_shortcuts_dialog_parent_class)->unroot (widget);
 }
 
 static void
@@ -555,9 +692,11 @@ adw_shortcuts_dialog_dispose (GObject *object)
   g_clear_object (&self->search_model);
   g_clear_object (&self->title_sections);
   g_clear_object (&self->direction_filter);
+  g_clear_pointer (&self->search_index, g_hash_table_unref);
+  g_clear_pointer (&self->item_rows, g_hash_table_unref);
+  g_clear_pointer (&self->search_text, g_free);
   self->all_rows = NULL;
-  self->title_filter = NULL;
-  self->subtitle_filter = NULL;
+  self->search_filter = NULL;
   self->filtered_sections = NULL;
 
   G_OBJECT_CLASS (adw_shortcuts_dialog_parent_class)->dispose (object);
@@ -572,6 +711,7 @@ adw_shortcuts_dialog_class_init (AdwShortcutsDialogClass *klass)
   object_class->dispose = adw_shortcuts_dialog_dispose;
 
   widget_class->root = adw_shortcuts_dialog_root;
+  widget_class->unroot = adw_shortcuts_dialog_unroot;
   widget_class->direction_changed = adw_shortcuts_dialog_direction_changed;
 
   gtk_widget_class_set_template_from_resource (widget_class,
@@ -627,8 +767,7 @@ direction_filter_func (AdwShortcutsItem   *item,
 static void
 adw_shortcuts_dialog_init (AdwShortcutsDialog *self)
 {
-  GtkExpression *title_expr, *subtitle_expr;
-  GtkFilter *filter, *section_title_filter;
+  GtkFilter *section_title_filter;
 
   gtk_widget_init_template (GTK_WIDGET (self));
 
@@ -636,20 +775,15 @@ adw_shortcuts_dialog_init (AdwShortcutsDialog *self)
 
   gtk_search_entry_set_key_capture_widget (self->search_entry, GTK_WIDGET (self));
 
-  title_expr = gtk_property_expression_new (ADW_TYPE_SHORTCUTS_ITEM,
-                                            NULL, "title");
-  subtitle_expr = gtk_property_expression_new (ADW_TYPE_SHORTCUTS_ITEM,
-                                               NULL, "subtitle");
+  self->search_index = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                              g_object_unref, g_free);
+  self->item_rows = g_hash_table_new (g_direct_hash, g_direct_equal);
 
-  self->title_filter = gtk_string_filter_new (title_expr);
-  self->subtitle_filter = gtk_string_filter_new (subtitle_expr);
+  self->search_filter = gtk_custom_filter_new ((GtkCustomFilterFunc) search_filter_func,
+                                               self, NULL);
   self->direction_filter = gtk_custom_filter_new ((GtkCustomFilterFunc) direction_filter_func,
                                                   self, NULL);
 
-  filter = GTK_FILTER (gtk_any_filter_new ());
-  gtk_multi_filter_append (GTK_MULTI_FILTER (filter), GTK_FILTER (self->title_filter));
-  gtk_multi_filter_append (GTK_MULTI_FILTER (filter), GTK_FILTER (self->subtitle_filter));
-
   section_title_filter = GTK_FILTER (gtk_custom_filter_new ((GtkCustomFilterFunc) section_title_filter_func,
                                                             NULL, NULL));
   self->title_sections = gtk_filter_list_model_new (G_LIST_MODEL (g_object_ref (self->sections)),
@@ -663,7 +797,7 @@ adw_shortcuts_dialog_init (AdwShortcutsDialog *self)
                                                     (GtkMapListModelMapFunc) section_to_filter_model,
                                                     self, NULL);
   self->all_rows = G_LIST_MODEL (gtk_flatten_list_model_new (G_LIST_MODEL (self->filtered_sections)));
-  self->search_model = gtk_filter_list_model_new (self->all_rows, filter);
+  self->search_model = gtk_filter_list_model_new (self->all_rows, GTK_FILTER (self->search_filter));
 
   g_signal_connect_object (self->filtered_sections, "items-changed",
                            G_CALLBACK (sections_changed_cb), self,
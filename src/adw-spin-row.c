@@ -446,17 +446,6 @@ adw_spin_row_class_init (AdwSpinRowClass *klass)
                               G_TYPE_FROM_CLASS (klass),
                               adw_marshal_VOID__VOIDv);
 
-  gtk_widget_class_set_template_from_resource (widget_class,
-                                               "/org/gnome/Adwaita/ui/adw-spin-row.ui");
-  gtk_widget_class_bind_template_child (widget_class, AdwSpinRow, spin_button);
-
-  gtk_widget_class_bind_template_callback (widget_class, spin_button_state_flags_changed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, spin_button_keynav_failed_cb);
-  gtk_widget_class_bind_template_callback (widget_class, spin_button_input_cb);
-  gtk_widget_class_bind_template_callback (widget_class, spin_button_output_cb);
-  gtk_widget_class_bind_template_callback (widget_class, spin_button_wrapped_cb);
-  gtk_widget_class_bind_template_callback (widget_class, spin_button_notify_value_cb);
-
   gtk_widget_class_set_accessible_role (widget_class, GTK_ACCESSIBLE_ROLE_PRESENTATION);
 }
 
@@ -466,7 +455,32 @@ adw_spin_row_init (AdwSpinRow *self)
   GListModel *controllers;
   guint i, n;
 
-  gtk_widget_init_template (GTK_WIDGET (self));
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (self), TRUE);
+  gtk_widget_add_css_class (GTK_WIDGET (self), "spin");
+
+  self->spin_button = gtk_spin_button_new (NULL, 0, 0);
+  gtk_widget_set_valign (self->spin_button, GTK_ALIGN_CENTER);
+  gtk_widget_set_hexpand (self->spin_button, TRUE);
+  gtk_editable_set_alignment (GTK_EDITABLE (self->spin_button), 1);
+  gtk_accessible_update_relation (GTK_ACCESSIBLE (self->spin_button),
+                                  GTK_ACCESSIBLE_RELATION_LABELLED_BY, self, NULL,
+                                  GTK_ACCESSIBLE_RELATION_DESCRIBED_BY, self, NULL,
+                                  -1);
+  adw_action_row_add_suffix (ADW_ACTION_ROW (self), self->spin_button);
+
+  g_signal_connect_swapped (self->spin_button, "state-flags-changed",
+                            G_CALLBACK (spin_button_state_flags_changed_cb), self);
+  g_signal_connect_swapped (self->spin_button, "keynav-failed",
+                            G_CALLBACK (spin_button_keynav_failed_cb), self);
+  g_signal_connect_swapped (self->spin_button, "input",
+                            G_CALLBACK (spin_button_input_cb), self);
+  g_signal_connect_swapped (self->spin_button, "output",
+                            G_CALLBACK (spin_button_output_cb), self);
+  g_signal_connect_swapped (self->spin_button, "wrapped",
+                            G_CALLBACK (spin_button_wrapped_cb), self);
+  g_signal_connect_swapped (self->spin_button, "notify::value",
+                            G_CALLBACK (spin_button_notify_value_cb), self);
+
   gtk_editable_init_delegate (GTK_EDITABLE (self));
 
   adw_action_row_set_expand_suffixes (ADW_ACTION_ROW (self), TRUE);
@@ -18,4 +18,6 @@ G_BEGIN_DECLS
 
 void adw_style_manager_ensure (void);
 
+guint adw_style_manager_get_n_stylesheet_updates (AdwStyleManager *self);
+
 G_END_DECLS
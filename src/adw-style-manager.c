@@ -11,6 +11,7 @@
 #include "adw-style-manager-private.h"
 
 #include "adw-accent-color-private.h"
+#include "adw-alloc-counters-private.h"
 #include "adw-main-private.h"
 #include "adw-settings-private.h"
 #include <gtk/gtk.h>
@@ -58,6 +59,15 @@
 #define DEFAULT_DOCUMENT_FONT (DEFAULT_DOCUMENT_FONT_FAMILY " " DEFAULT_DOCUMENT_FONT_SIZE_STR)
 #define DEFAULT_MONOSPACE_FONT (DEFAULT_MONOSPACE_FONT_FAMILY " " DEFAULT_MONOSPACE_FONT_SIZE_STR)
 
+typedef enum {
+  UPDATE_CONTRAST       = 1 << 0,
+  UPDATE_COLOR_SCHEME   = 1 << 1,
+  UPDATE_ACCENT_COLOR   = 1 << 2,
+  UPDATE_FONTS          = 1 << 3,
+  UPDATE_REDUCED_MOTION = 1 << 4,
+  UPDATE_ALL            = 0xFF
+} G_GNUC_FLAG_ENUM StylesheetUpdateFlags;
+
 struct _AdwStyleManager
 {
   GObject parent_instance;
@@ -76,6 +86,12 @@ struct _AdwStyleManager
 
   GtkCssProvider *animations_provider;
   guint animation_timeout_id;
+
+  StylesheetUpdateFlags pending_update_flags;
+  GdkFrameClock *update_frame_clock;
+  gulong update_frame_clock_id;
+  guint update_source_id;
+  guint n_stylesheet_updates;
 };
 
 G_DEFINE_FINAL_TYPE (AdwStyleManager, adw_style_manager, G_TYPE_OBJECT);
@@ -100,15 +116,6 @@ static GParamSpec *props[LAST_PROP];
 static GHashTable *display_style_managers = NULL;
 static AdwStyleManager *default_instance = NULL;
 
-typedef enum {
-  UPDATE_CONTRAST       = 1 << 0,
-  UPDATE_COLOR_SCHEME   = 1 << 1,
-  UPDATE_ACCENT_COLOR   = 1 << 2,
-  UPDATE_FONTS          = 1 << 3,
-  UPDATE_REDUCED_MOTION = 1 << 4,
-  UPDATE_ALL            = 0xFF
-} G_GNUC_FLAG_ENUM StylesheetUpdateFlags;
-
 static void
 unregister_display (GdkDisplay *display)
 {
@@ -157,6 +164,8 @@ generate_accent_css (AdwStyleManager *self)
   adw_accent_color_to_rgba (accent, &rgba);
   rgba_str = gdk_rgba_to_string (&rgba);
 
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_STYLE_CSS, 2);
+
   g_string_append_printf (str, "@define-color accent_bg_color %s;\n", rgba_str);
   g_string_append (str, "@define-color accent_fg_color white;\n");
 
@@ -172,6 +181,8 @@ generate_fonts_css (AdwStyleManager *self)
   PangoFontDescription *monospace_desc = pango_font_description_from_string (self->monospace_font_name);
   GString *str = g_string_new ("");
 
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_STYLE_CSS, 3);
+
   g_string_append (str, ":root {\n");
 
   if (document_desc && (pango_font_description_get_set_fields (document_desc) & (PANGO_FONT_MASK_FAMILY)) != 0) {
@@ -231,6 +242,8 @@ update_stylesheet (AdwStyleManager       *self,
   if (!self->display)
     return;
 
+  self->n_stylesheet_updates++;
+
   if (self->animation_timeout_id)
     g_clear_handle_id (&self->animation_timeout_id, g_source_remove);
 
@@ -300,6 +313,114 @@ update_stylesheet (AdwStyleManager       *self,
                         self);
 }
 
+static void
+unqueue_stylesheet_update (AdwStyleManager *self)
+{
+  if (self->update_frame_clock) {
+    g_clear_signal_handler (&self->update_frame_clock_id, self->update_frame_clock);
+    g_clear_object (&self->update_frame_clock);
+  }
+
+  g_clear_handle_id (&self->update_source_id, g_source_remove);
+}
+
+static void
+flush_stylesheet_update (AdwStyleManager *self)
+{
+  StylesheetUpdateFlags flags = self->pending_update_flags;
+
+  unqueue_stylesheet_update (self);
+
+  self->pending_update_flags = 0;
+
+  if (!flags)
+    return;
+
+  update_stylesheet (self, flags);
+
+  /* Notifications were held back when the update was queued, so that handlers
+   * see the stylesheet already applied */
+  g_object_thaw_notify (G_OBJECT (self));
+}
+
+static void
+update_source_cb (AdwStyleManager *self)
+{
+  self->update_source_id = 0;
+
+  flush_stylesheet_update (self);
+}
+
+static GdkFrameClock *
+find_frame_clock (AdwStyleManager *self)
+{
+  GList *toplevels = gtk_window_list_toplevels ();
+  GdkFrameClock *frame_clock = NULL;
+  GList *l;
+
+  for (l = toplevels; l; l = l->next) {
+    GtkWidget *window = l->data;
+
+    if (gtk_widget_get_display (window) != self->display ||
+        !gtk_widget_get_mapped (window))
+      continue;
+
+    frame_clock = gtk_widget_get_frame_clock (window);
+
+    if (frame_clock)
+      break;
+  }
+
+  g_list_free (toplevels);
+
+  return frame_clock;
+}
+
+/* Settings often change several at once, e.g. when switching to high contrast
+ * or when the portal delivers a theme change. Each update invalidates styles
+ * for the whole display, so collect them and apply together before the next
+ * frame is drawn.
+ *
+ * Property notifications are frozen until then, so that anything reacting to
+ * them, e.g. application stylesheets, changes together with the stylesheet. */
+static void
+queue_stylesheet_update (AdwStyleManager       *self,
+                         StylesheetUpdateFlags  flags)
+{
+  GdkFrameClock *frame_clock;
+
+  if (!self->display)
+    return;
+
+  if (!self->pending_update_flags)
+    g_object_freeze_notify (G_OBJECT (self));
+
+  self->pending_update_flags |= flags;
+
+  if (self->update_source_id)
+    return;
+
+  frame_clock = find_frame_clock (self);
+
+  if (frame_clock) {
+    self->update_frame_clock = g_object_ref (frame_clock);
+    self->update_frame_clock_id =
+      g_signal_connect_swapped (frame_clock, "update",
+                                G_CALLBACK (flush_stylesheet_update), self);
+
+    gdk_frame_clock_request_phase (frame_clock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+
+    /* The window may be hidden before the next frame, don't wait forever */
+    self->update_source_id =
+      g_timeout_add_once (SWITCH_DURATION,
+                          (GSourceOnceFunc) update_source_cb,
+                          self);
+  } else {
+    self->update_source_id =
+      g_idle_add_once ((GSourceOnceFunc) update_source_cb, self);
+  }
+}
+
 static gboolean
 get_is_dark (AdwStyleManager *self)
 {
@@ -333,7 +454,7 @@ update_dark (AdwStyleManager *self)
 
   self->dark = dark;
 
-  update_stylesheet (self, UPDATE_COLOR_SCHEME);
+  queue_stylesheet_update (self, UPDATE_COLOR_SCHEME);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_DARK]);
 }
@@ -397,7 +518,7 @@ update_fonts (AdwStyleManager *self)
   }
 
   if (document_changed || monospace_changed)
-    update_stylesheet (self, UPDATE_FONTS);
+    queue_stylesheet_update (self, UPDATE_FONTS);
 
   if (document_changed)
     g_object_notify_by_pspec (G_OBJECT (self), props[PROP_DOCUMENT_FONT_NAME]);
@@ -409,7 +530,7 @@ update_fonts (AdwStyleManager *self)
 static void
 notify_reduced_motion_cb (AdwStyleManager *self)
 {
-  update_stylesheet (self, UPDATE_REDUCED_MOTION);
+  queue_stylesheet_update (self, UPDATE_REDUCED_MOTION);
 }
 
 static void
@@ -421,7 +542,7 @@ notify_system_supports_color_schemes_cb (AdwStyleManager *self)
 static void
 notify_accent_color_cb (AdwStyleManager *self)
 {
-  update_stylesheet (self, UPDATE_ACCENT_COLOR);
+  queue_stylesheet_update (self, UPDATE_ACCENT_COLOR);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ACCENT_COLOR]);
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ACCENT_COLOR_RGBA]);
@@ -436,7 +557,7 @@ notify_system_supports_accent_colors_cb (AdwStyleManager *self)
 static void
 notify_high_contrast_cb (AdwStyleManager *self)
 {
-  update_stylesheet (self, UPDATE_CONTRAST);
+  queue_stylesheet_update (self, UPDATE_CONTRAST);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_HIGH_CONTRAST]);
 }
@@ -528,7 +649,8 @@ adw_style_manager_constructed (GObject *object)
 
   update_dark (self);
   update_fonts (self);
-  update_stylesheet (self, UPDATE_ALL);
+  queue_stylesheet_update (self, UPDATE_ALL);
+  flush_stylesheet_update (self);
 
   if (self->provider) {
     gtk_css_provider_load_from_resource (self->provider,
@@ -541,6 +663,13 @@ adw_style_manager_dispose (GObject *object)
 {
   AdwStyleManager *self = ADW_STYLE_MANAGER (object);
 
+  unqueue_stylesheet_update (self);
+
+  if (self->pending_update_flags) {
+    self->pending_update_flags = 0;
+    g_object_thaw_notify (object);
+  }
+
   g_clear_handle_id (&self->animation_timeout_id, g_source_remove);
   g_clear_object (&self->provider);
   g_clear_object (&self->animations_provider);
@@ -827,6 +956,15 @@ adw_style_manager_init (AdwStyleManager *self)
   self->color_scheme = ADW_COLOR_SCHEME_DEFAULT;
 }
 
+/* Used in tests to check that settings changes are batched */
+guint
+adw_style_manager_get_n_stylesheet_updates (AdwStyleManager *self)
+{
+  g_return_val_if_fail (ADW_IS_STYLE_MANAGER (self), 0);
+
+  return self->n_stylesheet_updates;
+}
+
 void
 adw_style_manager_ensure (void)
 {
@@ -989,6 +1127,7 @@ adw_style_manager_set_color_scheme (AdwStyleManager *self,
   g_object_freeze_notify (G_OBJECT (self));
 
   update_dark (self);
+  flush_stylesheet_update (self);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_COLOR_SCHEME]);
 
@@ -1000,9 +1139,12 @@ adw_style_manager_set_color_scheme (AdwStyleManager *self,
 
     g_hash_table_iter_init (&iter, display_style_managers);
 
-    while (g_hash_table_iter_next (&iter, NULL, (gpointer) &manager))
-      if (manager->color_scheme == ADW_COLOR_SCHEME_DEFAULT)
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer) &manager)) {
+      if (manager->color_scheme == ADW_COLOR_SCHEME_DEFAULT) {
         update_dark (manager);
+        flush_stylesheet_update (manager);
+      }
+    }
   }
 }
 
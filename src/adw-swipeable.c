@@ -8,6 +8,8 @@
 
 #include "adw-swipeable.h"
 
+#include "adw-alloc-counters-private.h"
+
 /**
  * AdwSwipeable:
  *
@@ -84,6 +86,8 @@ adw_swipeable_get_snap_points (AdwSwipeable *self,
   iface = ADW_SWIPEABLE_GET_IFACE (self);
   g_return_val_if_fail (iface->get_snap_points != NULL, NULL);
 
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_SNAP_POINTS, 1);
+
   return iface->get_snap_points (self, n_snap_points);
 }
 
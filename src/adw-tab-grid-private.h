@@ -13,6 +13,7 @@
 #endif
 
 #include <gtk/gtk.h>
+#include "adw-tab-search-private.h"
 #include "adw-tab-thumbnail-private.h"
 #include "adw-tab-view.h"
 
@@ -74,8 +75,8 @@ void adw_tab_grid_scroll_to_page (AdwTabGrid *self,
 void adw_tab_grid_set_hovering (AdwTabGrid *self,
                                 gboolean    hovering);
 
-void adw_tab_grid_set_search_terms (AdwTabGrid *self,
-                                    const char *terms);
+void adw_tab_grid_set_search (AdwTabGrid   *self,
+                              AdwTabSearch *search);
 
 gboolean adw_tab_grid_get_empty (AdwTabGrid *self);
 
@@ -192,10 +192,7 @@ struct _AdwTabGrid
   double lower_inset;
   double upper_inset;
 
-  GtkStringFilter *title_filter;
-  GtkStringFilter *tooltip_filter;
-  GtkStringFilter *keyword_filter;
-  GtkFilter *filter;
+  AdwTabSearch *search;
   gboolean searching;
 
   gboolean empty;
@@ -773,7 +770,7 @@ tab_should_be_visible (AdwTabGrid *self,
   if (!self->searching)
     return TRUE;
 
-  return gtk_filter_match (self->filter, page);
+  return gtk_filter_match (GTK_FILTER (self->search), page);
 }
 
 static void
@@ -796,6 +793,8 @@ search_changed_cb (AdwTabGrid      *self,
   gboolean changed = FALSE;
   gboolean empty = TRUE;
 
+  self->searching = adw_tab_search_get_active (self->search);
+
   for (l = self->tabs; l; l = l->next) {
     TabInfo *info = l->data;
     gboolean visible;
@@ -820,7 +819,10 @@ search_changed_cb (AdwTabGrid      *self,
     }
   }
 
-  set_empty (self, empty);
+  if (self->searching)
+    set_empty (self, empty);
+  else
+    set_empty (self, self->n_tabs == 0);
 
   if (changed)
     gtk_widget_queue_resize (GTK_WIDGET (self));
@@ -3263,10 +3265,7 @@ adw_tab_grid_dispose (GObject *object)
   self->tab_overview = NULL;
   adw_tab_grid_set_view (self, NULL);
 
-  g_clear_object (&self->filter);
-  self->title_filter = NULL;
-  self->tooltip_filter = NULL;
-  self->keyword_filter = NULL;
+  adw_tab_grid_set_search (self, NULL);
 
   g_clear_object (&self->resize_animation);
 
@@ -3472,7 +3471,6 @@ adw_tab_grid_init (AdwTabGrid *self)
 {
   GtkEventController *controller;
   AdwAnimationTarget *target;
-  GtkExpression *expression;
 
   self->can_remove_placeholder = TRUE;
   self->initial_max_n_columns = -1;
@@ -3528,26 +3526,6 @@ adw_tab_grid_init (AdwTabGrid *self)
 
   g_signal_connect_swapped (self->resize_animation, "done",
                             G_CALLBACK (resize_animation_done_cb), self);
-
-  expression = gtk_property_expression_new (ADW_TYPE_TAB_PAGE, NULL, "title");
-  self->title_filter = gtk_string_filter_new (expression);
-
-  expression = gtk_property_expression_new (ADW_TYPE_TAB_PAGE, NULL, "tooltip");
-  self->tooltip_filter = gtk_string_filter_new (expression);
-
-  expression = gtk_property_expression_new (ADW_TYPE_TAB_PAGE, NULL, "keyword");
-  self->keyword_filter = gtk_string_filter_new (expression);
-
-  self->filter = GTK_FILTER (gtk_any_filter_new ());
-  gtk_multi_filter_append (GTK_MULTI_FILTER (self->filter),
-                           GTK_FILTER (self->title_filter));
-  gtk_multi_filter_append (GTK_MULTI_FILTER (self->filter),
-                           GTK_FILTER (self->tooltip_filter));
-  gtk_multi_filter_append (GTK_MULTI_FILTER (self->filter),
-                           GTK_FILTER (self->keyword_filter));
-
-  g_signal_connect_swapped (self->filter, "changed",
-                            G_CALLBACK (search_changed_cb), self);
 }
 
 void
@@ -3798,16 +3776,28 @@ adw_tab_grid_set_hovering (AdwTabGrid *self,
 }
 
 void
-adw_tab_grid_set_search_terms (AdwTabGrid *self,
-                               const char *terms)
+adw_tab_grid_set_search (AdwTabGrid   *self,
+                         AdwTabSearch *search)
 {
-  self->searching = terms && *terms;
-  gtk_string_filter_set_search (self->title_filter, terms);
-  gtk_string_filter_set_search (self->tooltip_filter, terms);
-  gtk_string_filter_set_search (self->keyword_filter, terms);
+  g_return_if_fail (ADW_IS_TAB_GRID (self));
+  g_return_if_fail (search == NULL || ADW_IS_TAB_SEARCH (search));
 
-  if (!self->searching)
-    set_empty (self, self->n_tabs == 0);
+  if (self->search == search)
+    return;
+
+  if (self->search)
+    g_signal_handlers_disconnect_by_func (self->search, search_changed_cb, self);
+
+  g_set_object (&self->search, search);
+
+  if (self->search) {
+    g_signal_connect_swapped (self->search, "changed",
+                              G_CALLBACK (search_changed_cb), self);
+
+    search_changed_cb (self, GTK_FILTER_CHANGE_DIFFERENT);
+  } else {
+    self->searching = FALSE;
+  }
 }
 
 gboolean
@@ -134,6 +134,7 @@ struct _AdwTabOverview
 
   AdwTabGrid *grid;
   AdwTabGrid *pinned_grid;
+  AdwTabSearch *search;
 
   gboolean enable_search;
   gboolean enable_new_tab;
@@ -865,8 +866,7 @@ search_changed_cb (AdwTabOverview *self)
 {
   const char *text = gtk_editable_get_text (GTK_EDITABLE (self->search_entry));
 
-  adw_tab_grid_set_search_terms (self->grid, text);
-  adw_tab_grid_set_search_terms (self->pinned_grid, text);
+  adw_tab_search_set_terms (self->search, text);
 
   set_search_active (self, text && *text);
 }
@@ -876,8 +876,7 @@ stop_search_cb (AdwTabOverview *self)
 {
   gtk_editable_set_text (GTK_EDITABLE (self->search_entry), "");
 
-  adw_tab_grid_set_search_terms (self->grid, "");
-  adw_tab_grid_set_search_terms (self->pinned_grid, "");
+  adw_tab_search_set_terms (self->search, NULL);
 
   set_search_active (self, FALSE);
 }
@@ -1011,6 +1010,7 @@ page_detached_cb (AdwTabOverview *self,
                   int             position)
 {
   g_signal_handlers_disconnect_by_func (page, notify_pinned_cb, self);
+  adw_tab_search_remove_page (self->search, page);
   update_actions (self);
 }
 
@@ -1429,6 +1429,8 @@ adw_tab_overview_dispose (GObject *object)
 
   gtk_widget_dispose_template (GTK_WIDGET (self), ADW_TYPE_TAB_OVERVIEW);
 
+  g_clear_object (&self->search);
+
   G_OBJECT_CLASS (adw_tab_overview_parent_class)->dispose (object);
 }
 
@@ -1929,6 +1931,10 @@ adw_tab_overview_init (AdwTabOverview *self)
   gtk_search_bar_connect_entry (GTK_SEARCH_BAR (self->search_bar),
                                 GTK_EDITABLE (self->search_entry));
 
+  self->search = adw_tab_search_new ();
+  adw_tab_grid_set_search (self->grid, self->search);
+  adw_tab_grid_set_search (self->pinned_grid, self->search);
+
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc) open_animation_value_cb,
                                               self, NULL);
 
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADWAITA_INSIDE) && !defined(ADWAITA_COMPILATION)
+#error "Only <adwaita.h> can be included directly."
+#endif
+
+#include <gtk/gtk.h>
+#include "adw-tab-view.h"
+
+G_BEGIN_DECLS
+
+#define ADW_TYPE_TAB_SEARCH (adw_tab_search_get_type())
+
+G_DECLARE_FINAL_TYPE (AdwTabSearch, adw_tab_search, ADW, TAB_SEARCH, GtkFilter)
+
+AdwTabSearch *adw_tab_search_new (void) G_GNUC_WARN_UNUSED_RESULT;
+
+void adw_tab_search_set_terms (AdwTabSearch *self,
+                               const char   *terms);
+
+gboolean adw_tab_search_get_active (AdwTabSearch *self);
+
+void adw_tab_search_remove_page (AdwTabSearch *self,
+                                 AdwTabPage   *page);
+
+G_END_DECLS
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-tab-search-private.h"
+
+/*
+ * AdwTabSearch:
+ *
+ * The filter used for searching tabs in `AdwTabOverview`.
+ *
+ * It matches pages whose title, tooltip or keyword contains the search terms,
+ * ignoring case, same as a `GtkStringFilter` on each of them would.
+ *
+ * The normalized strings are cached per page the first time the page is
+ * matched, and dropped when the corresponding properties change, so typing
+ * into the search entry doesn't need to query and normalize the properties of
+ * every page on each keystroke. Setting the terms emits a single
+ * [signal@Gtk.Filter::changed], telling whether the search became more or less
+ * strict when the new terms extend or shorten the old ones, so that the grids
+ * only need to look at the tabs that can actually change visibility. The same
+ * goes for a page whose title, tooltip or keyword changes: the filter only
+ * changes if the page starts or stops matching.
+ *
+ * The overview is responsible for calling adw_tab_search_remove_page() when a
+ * page is detached from its view.
+ */
+
+typedef enum {
+  KEY_TITLE,
+  KEY_TOOLTIP,
+  KEY_KEYWORD,
+  N_KEYS,
+} PageKey;
+
+typedef struct {
+  AdwTabSearch *search;
+  AdwTabPage *page;
+
+  gboolean valid;
+  char *keys[N_KEYS];
+} PageEntry;
+
+struct _AdwTabSearch
+{
+  GtkFilter parent_instance;
+
+  char *terms;
+
+  GHashTable *entries;
+};
+
+G_DEFINE_FINAL_TYPE (AdwTabSearch, adw_tab_search, GTK_TYPE_FILTER)
+
+static char *
+prepare_string (const char *str)
+{
+  char *normalized, *ret;
+
+  if (!str || !*str)
+    return NULL;
+
+  normalized = g_utf8_normalize (str, -1, G_NORMALIZE_ALL);
+
+  if (!normalized)
+    return NULL;
+
+  ret = g_utf8_casefold (normalized, -1);
+
+  g_free (normalized);
+
+  return ret;
+}
+
+static void
+clear_keys (PageEntry *entry)
+{
+  int i;
+
+  for (i = 0; i < N_KEYS; i++)
+    g_clear_pointer (&entry->keys[i], g_free);
+
+  entry->valid = FALSE;
+}
+
+static void
+validate_keys (PageEntry *entry)
+{
+  if (entry->valid)
+    return;
+
+  entry->keys[KEY_TITLE] = prepare_string (adw_tab_page_get_title (entry->page));
+  entry->keys[KEY_TOOLTIP] = prepare_string (adw_tab_page_get_tooltip (entry->page));
+  entry->keys[KEY_KEYWORD] = prepare_string (adw_tab_page_get_keyword (entry->page));
+  entry->valid = TRUE;
+}
+
+static gboolean
+entry_matches (PageEntry  *entry,
+               const char *terms)
+{
+  int i;
+
+  for (i = 0; i < N_KEYS; i++)
+    if (entry->keys[i] && strstr (entry->keys[i], terms))
+      return TRUE;
+
+  return FALSE;
+}
+
+static void
+page_notify_cb (PageEntry *entry)
+{
+  AdwTabSearch *self = entry->search;
+  gboolean was_valid = entry->valid;
+  gboolean matched = FALSE, matches;
+
+  if (!self->terms) {
+    clear_keys (entry);
+    return;
+  }
+
+  if (was_valid)
+    matched = entry_matches (entry, self->terms);
+
+  clear_keys (entry);
+  validate_keys (entry);
+
+  matches = entry_matches (entry, self->terms);
+
+  /* Only this page can start or stop matching, so the filter only gets more
+   * strict if it stopped matching and less strict if it started. Without the
+   * old keys there's no way to tell which one it is */
+  if (!was_valid)
+    gtk_filter_changed (GTK_FILTER (self), GTK_FILTER_CHANGE_DIFFERENT);
+  else if (matched && !matches)
+    gtk_filter_changed (GTK_FILTER (self), GTK_FILTER_CHANGE_MORE_STRICT);
+  else if (!matched && matches)
+    gtk_filter_changed (GTK_FILTER (self), GTK_FILTER_CHANGE_LESS_STRICT);
+}
+
+static void
+page_entry_free (PageEntry *entry)
+{
+  g_signal_handlers_disconnect_by_func (entry->page, page_notify_cb, entry);
+  clear_keys (entry);
+  g_object_unref (entry->page);
+
+  g_free (entry);
+}
+
+static PageEntry *
+ensure_entry (AdwTabSearch *self,
+              AdwTabPage   *page)
+{
+  PageEntry *entry = g_hash_table_lookup (self->entries, page);
+
+  if (!entry) {
+    entry = g_new0 (PageEntry, 1);
+    entry->search = self;
+    entry->page = g_object_ref (page);
+
+    g_signal_connect_swapped (page, "notify::title",
+                              G_CALLBACK (page_notify_cb), entry);
+    g_signal_connect_swapped (page, "notify::tooltip",
+                              G_CALLBACK (page_notify_cb), entry);
+    g_signal_connect_swapped (page, "notify::keyword",
+                              G_CALLBACK (page_notify_cb), entry);
+
+    g_hash_table_insert (self->entries, page, entry);
+  }
+
+  validate_keys (entry);
+
+  return entry;
+}
+
+static gboolean
+adw_tab_search_match (GtkFilter *filter,
+                      gpointer   item)
+{
+  AdwTabSearch *self = ADW_TAB_SEARCH (filter);
+  PageEntry *entry;
+
+  if (!self->terms)
+    return TRUE;
+
+  if (!ADW_IS_TAB_PAGE (item))
+    return FALSE;
+
+  entry = ensure_entry (self, item);
+
+  return entry_matches (entry, self->terms);
+}
+
+static GtkFilterMatch
+adw_tab_search_get_strictness (GtkFilter *filter)
+{
+  AdwTabSearch *self = ADW_TAB_SEARCH (filter);
+
+  if (!self->terms)
+    return GTK_FILTER_MATCH_ALL;
+
+  return GTK_FILTER_MATCH_SOME;
+}
+
+static void
+adw_tab_search_finalize (GObject *object)
+{
+  AdwTabSearch *self = ADW_TAB_SEARCH (object);
+
+  g_hash_table_unref (self->entries);
+  g_free (self->terms);
+
+  G_OBJECT_CLASS (adw_tab_search_parent_class)->finalize (object);
+}
+
+static void
+adw_tab_search_class_init (AdwTabSearchClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GtkFilterClass *filter_class = GTK_FILTER_CLASS (klass);
+
+  object_class->finalize = adw_tab_search_finalize;
+
+  filter_class->match = adw_tab_search_match;
+  filter_class->get_strictness = adw_tab_search_get_strictness;
+}
+
+static void
+adw_tab_search_init (AdwTabSearch *self)
+{
+  self->entries = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                         NULL, (GDestroyNotify) page_entry_free);
+}
+
+AdwTabSearch *
+adw_tab_search_new (void)
+{
+  return g_object_new (ADW_TYPE_TAB_SEARCH, NULL);
+}
+
+/*
+ * adw_tab_search_set_terms:
+ * @self: a tab search
+ * @terms: (nullable): the search terms
+ *
+ * Sets the search terms.
+ *
+ * Empty or `NULL` terms match every page.
+ */
+void
+adw_tab_search_set_terms (AdwTabSearch *self,
+                          const char   *terms)
+{
+  GtkFilterChange change;
+  char *prepared;
+
+  g_return_if_fail (ADW_IS_TAB_SEARCH (self));
+
+  prepared = prepare_string (terms);
+
+  if (!g_strcmp0 (prepared, self->terms)) {
+    g_free (prepared);
+    return;
+  }
+
+  if (!self->terms)
+    change = GTK_FILTER_CHANGE_MORE_STRICT;
+  else if (!prepared)
+    change = GTK_FILTER_CHANGE_LESS_STRICT;
+  else if (strstr (prepared, self->terms))
+    change = GTK_FILTER_CHANGE_MORE_STRICT;
+  else if (strstr (self->terms, prepared))
+    change = GTK_FILTER_CHANGE_LESS_STRICT;
+  else
+    change = GTK_FILTER_CHANGE_DIFFERENT;
+
+  g_free (self->terms);
+  self->terms = prepared;
+
+  gtk_filter_changed (GTK_FILTER (self), change);
+}
+
+/*
+ * adw_tab_search_get_active:
+ * @self: a tab search
+ *
+ * Gets whether @self has any search terms.
+ *
+ * Returns: whether search is active
+ */
+gboolean
+adw_tab_search_get_active (AdwTabSearch *self)
+{
+  g_return_val_if_fail (ADW_IS_TAB_SEARCH (self), FALSE);
+
+  return self->terms != NULL;
+}
+
+/*
+ * adw_tab_search_remove_page:
+ * @self: a tab search
+ * @page: a tab page
+ *
+ * Drops the cached data for @page.
+ */
+void
+adw_tab_search_remove_page (AdwTabSearch *self,
+                            AdwTabPage   *page)
+{
+  g_return_if_fail (ADW_IS_TAB_SEARCH (self));
+  g_return_if_fail (ADW_IS_TAB_PAGE (page));
+
+  g_hash_table_remove (self->entries, page);
+}
@@ -27,6 +27,11 @@ static GSList *tab_view_list;
 #define MAX_THUMBNAIL_BITMAP_WIDTH 500
 #define MIN_THUMBNAIL_BITMAP_HEIGHT 200
 #define MAX_THUMBNAIL_BITMAP_HEIGHT 600
+/* Thumbnails are re-rendered at most 15 times per second each, and at most
+ * 2 of them are rendered within the same frame */
+#define THUMBNAIL_REFRESH_INTERVAL (G_USEC_PER_SEC / 15)
+#define MAX_THUMBNAIL_RENDERS_PER_FRAME 2
+#define THUMBNAIL_RETRY_DELAY 16
 
 /**
  * AdwTabView:
@@ -156,6 +161,7 @@ struct _AdwTabPage
 
   gboolean live_thumbnail;
   gboolean invalidated;
+  gboolean render_pending;
   gboolean in_destruction;
 };
 
@@ -205,6 +211,13 @@ struct _AdwTabView
   int overview_count;
   gulong unmap_extra_pages_cb;
 
+  /* Pages whose bin is child-visible: the selected page, plus the pages that
+   * need to draw their thumbnails while the overview is open */
+  GPtrArray *visible_pages;
+
+  gint64 thumbnail_frame;
+  int n_thumbnail_renders;
+
   GtkSelectionModel *pages;
 };
 
@@ -252,7 +265,20 @@ page_should_be_visible (AdwTabView *view,
   if (!view->overview_count)
     return FALSE;
 
-  return page->live_thumbnail || page->invalidated;
+  return page->live_thumbnail || page->invalidated || page->render_pending;
+}
+
+static void
+set_page_child_visible (AdwTabView *view,
+                        AdwTabPage *page,
+                        gboolean    visible)
+{
+  gtk_widget_set_child_visible (page->bin, visible);
+
+  if (!visible)
+    g_ptr_array_remove (view->visible_pages, page);
+  else if (!g_ptr_array_find (view->visible_pages, page, NULL))
+    g_ptr_array_add (view->visible_pages, page);
 }
 
 static void
@@ -351,7 +377,7 @@ map_or_unmap_page (AdwTabPage *self)
   if (gtk_widget_get_child_visible (self->bin) == should_be_visible)
     return;
 
-  gtk_widget_set_child_visible (self->bin, should_be_visible);
+  set_page_child_visible (view, self, should_be_visible);
   gtk_widget_queue_allocate (parent);
 }
 
@@ -807,7 +833,7 @@ adw_tab_page_class_init (AdwTabPageClass *klass)
    * Whether to enable live thumbnail for this page.
    *
    * When set to `TRUE`, the page's thumbnail in [class@TabOverview] will update
-   * immediately when the page is redrawn or resized.
+   * when the page is redrawn or resized, up to 15 times per second.
    *
    * If it's set to `FALSE`, the thumbnail will only be live when the page is
    * selected, and otherwise it will be static and will only update when
@@ -965,6 +991,9 @@ struct _AdwTabPaintable
 
   double last_xalign;
   double last_yalign;
+
+  gint64 last_render_time;
+  guint deferred_render_id;
 };
 
 static void
@@ -1192,11 +1221,66 @@ render_contents (AdwTabPaintable *self,
   return ret;
 }
 
+/* Returns the time in milliseconds to wait before the thumbnail can be
+ * rendered again, or 0 if it can be rendered right away */
+static guint
+get_render_delay (AdwTabPaintable *self)
+{
+  AdwTabView *view;
+  GdkFrameClock *frame_clock;
+  gint64 now, frame;
+
+  if (!self->view)
+    return 0;
+
+  now = g_get_monotonic_time ();
+
+  if (self->last_render_time &&
+      now - self->last_render_time < THUMBNAIL_REFRESH_INTERVAL)
+    return (THUMBNAIL_REFRESH_INTERVAL - (now - self->last_render_time)) / 1000 + 1;
+
+  frame_clock = gtk_widget_get_frame_clock (self->view);
+
+  if (!frame_clock)
+    return 0;
+
+  view = ADW_TAB_VIEW (self->view);
+  frame = gdk_frame_clock_get_frame_counter (frame_clock);
+
+  if (view->thumbnail_frame != frame) {
+    view->thumbnail_frame = frame;
+    view->n_thumbnail_renders = 0;
+  }
+
+  if (view->n_thumbnail_renders >= MAX_THUMBNAIL_RENDERS_PER_FRAME)
+    return THUMBNAIL_RETRY_DELAY;
+
+  return 0;
+}
+
+static void invalidate_texture (AdwTabPaintable *self);
+
+static void
+deferred_render_cb (AdwTabPaintable *self)
+{
+  self->deferred_render_id = 0;
+
+  invalidate_texture (self);
+
+  /* The page was kept visible for the render, it can be hidden now unless
+   * the render was deferred again */
+  if (!self->deferred_render_id) {
+    self->page->render_pending = FALSE;
+    map_or_unmap_page (self->page);
+  }
+}
+
 static void
 invalidate_texture (AdwTabPaintable *self)
 {
   GdkTexture *texture;
   double old_aspect_ratio;
+  guint delay;
 
   if (!self->page->bin || !gtk_widget_get_mapped (self->page->bin))
     return;
@@ -1210,8 +1294,27 @@ invalidate_texture (AdwTabPaintable *self)
     }
   }
 
+  if (self->frozen || self->deferred_render_id)
+    return;
+
+  delay = get_render_delay (self);
+
+  if (delay > 0) {
+    /* Keep the page visible until then, so that it doesn't need to be shown
+     * and redrawn again for the render */
+    self->page->render_pending = TRUE;
+    self->deferred_render_id =
+      g_timeout_add_once (delay, (GSourceOnceFunc) deferred_render_cb, self);
+    return;
+  }
+
   texture = render_contents (self, FALSE);
 
+  self->last_render_time = g_get_monotonic_time ();
+
+  if (self->view)
+    ADW_TAB_VIEW (self->view)->n_thumbnail_renders++;
+
   if (!texture)
     return;
 
@@ -1348,6 +1451,7 @@ adw_tab_paintable_dispose (GObject *object)
 
   disconnect_from_view (self);
 
+  g_clear_handle_id (&self->deferred_render_id, g_source_remove);
   g_clear_object (&self->child_paintable);
   g_clear_object (&self->cached_paintable);
 
@@ -1409,6 +1513,8 @@ adw_tab_paintable_freeze (AdwTabPaintable *self)
 
   self->frozen = TRUE;
 
+  g_clear_handle_id (&self->deferred_render_id, g_source_remove);
+  self->page->render_pending = FALSE;
   g_clear_object (&self->child_paintable);
 }
 
@@ -1751,8 +1857,7 @@ attach_page (AdwTabView *self,
 
   g_list_store_insert (self->children, position, page);
 
-  gtk_widget_set_child_visible (page->bin,
-                                page_should_be_visible (self, page));
+  set_page_child_visible (self, page, page_should_be_visible (self, page));
   gtk_widget_set_parent (page->bin, GTK_WIDGET (self));
   page->transfer_binding =
     g_object_bind_property (self, "is-transferring-page",
@@ -1808,8 +1913,8 @@ set_selected_page (AdwTabView *self,
     }
 
     if (self->selected_page->bin && selected_page) {
-      gtk_widget_set_child_visible (self->selected_page->bin,
-                                    page_should_be_visible (self, self->selected_page));
+      set_page_child_visible (self, self->selected_page,
+                              page_should_be_visible (self, self->selected_page));
     }
 
     set_page_selected (self->selected_page, FALSE);
@@ -1822,7 +1927,7 @@ set_selected_page (AdwTabView *self,
       new_position = adw_tab_view_get_page_position (self, self->selected_page);
 
     if (!gtk_widget_in_destruction (GTK_WIDGET (self))) {
-      gtk_widget_set_child_visible (selected_page->bin, TRUE);
+      set_page_child_visible (self, selected_page, TRUE);
 
       if (contains_focus) {
         if (selected_page->last_focus)
@@ -1925,6 +2030,7 @@ detach_page (AdwTabView *self,
 
   g_clear_pointer (&page->transfer_binding, g_binding_unbind);
   gtk_widget_unparent (page->bin);
+  g_ptr_array_remove (self->visible_pages, page);
 
   if (!in_dispose)
     gtk_widget_queue_resize (GTK_WIDGET (self));
@@ -2279,34 +2385,30 @@ adw_tab_view_size_allocate (GtkWidget *widget,
                             int        baseline)
 {
   AdwTabView *self = ADW_TAB_VIEW (widget);
-  int i;
+  guint i;
 
-  for (i = 0; i < self->n_pages; i++) {
-    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+  for (i = 0; i < self->visible_pages->len; i++) {
+    AdwTabPage *page = g_ptr_array_index (self->visible_pages, i);
 
-    if (gtk_widget_get_child_visible (page->bin))
-      gtk_widget_allocate (page->bin, width, height, baseline, NULL);
+    gtk_widget_allocate (page->bin, width, height, baseline, NULL);
   }
 }
 
 static void
 unmap_extra_pages (AdwTabView *self)
 {
-  int i;
+  guint i = self->visible_pages->len;
 
-  for (i = 0; i < self->n_pages; i++) {
-    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+  while (i-- > 0) {
+    AdwTabPage *page = g_ptr_array_index (self->visible_pages, i);
 
     if (page == self->selected_page)
       continue;
 
-    if (!gtk_widget_get_child_visible (page->bin))
-      continue;
-
     if (page_should_be_visible (self, page))
       continue;
 
-    gtk_widget_set_child_visible (page->bin, FALSE);
+    set_page_child_visible (self, page, FALSE);
   }
 
   self->unmap_extra_pages_cb = 0;
@@ -2317,16 +2419,13 @@ adw_tab_view_snapshot (GtkWidget   *widget,
                        GtkSnapshot *snapshot)
 {
   AdwTabView *self = ADW_TAB_VIEW (widget);
-  int i;
+  guint i;
 
   if (self->selected_page)
     gtk_widget_snapshot_child (widget, self->selected_page->bin, snapshot);
 
-  for (i = 0; i < self->n_pages; i++) {
-    AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
-
-    if (!gtk_widget_get_child_visible (page->bin))
-      continue;
+  for (i = 0; i < self->visible_pages->len; i++) {
+    AdwTabPage *page = g_ptr_array_index (self->visible_pages, i);
 
     if (page->paintable) {
       if (page == self->selected_page && page->invalidated)
@@ -2361,7 +2460,7 @@ draw_overview_pages_after_map_cb (AdwTabView *self)
     AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
 
     if (page->live_thumbnail || page->invalidated)
-      gtk_widget_set_child_visible (page->bin, TRUE);
+      set_page_child_visible (self, page, TRUE);
     else if (page == self->selected_page)
       gtk_widget_queue_draw (GTK_WIDGET (page->bin));
   }
@@ -2412,6 +2511,7 @@ adw_tab_view_finalize (GObject *object)
   AdwTabView *self = (AdwTabView *) object;
 
   g_clear_weak_pointer (&self->pages);
+  g_clear_pointer (&self->visible_pages, g_ptr_array_unref);
   g_clear_object (&self->default_icon);
   g_clear_object (&self->menu_model);
 
@@ -2858,6 +2958,7 @@ adw_tab_view_init (AdwTabView *self)
   GtkEventController *controller;
 
   self->children = g_list_store_new (ADW_TYPE_TAB_PAGE);
+  self->visible_pages = g_ptr_array_new ();
   self->default_icon = G_ICON (g_themed_icon_new ("adw-tab-icon-missing-symbolic"));
   self->shortcuts = ADW_TAB_VIEW_SHORTCUT_ALL_SHORTCUTS;
 
@@ -3519,7 +3620,7 @@ adw_tab_page_get_live_thumbnail (AdwTabPage *self)
  * Sets whether to enable live thumbnail for @self.
  *
  * When set to `TRUE`, @self's thumbnail in [class@TabOverview] will update
- * immediately when @self is redrawn or resized.
+ * when @self is redrawn or resized, up to 15 times per second.
  *
  * If it's set to `FALSE`, the thumbnail will only be live when the @self is
  * selected, and otherwise it will be static and will only update when
@@ -4846,7 +4947,7 @@ adw_tab_view_open_overview (AdwTabView *self)
       AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
 
       if (page->live_thumbnail || page->invalidated)
-        gtk_widget_set_child_visible (page->bin, TRUE);
+        set_page_child_visible (self, page, TRUE);
     }
 
     gtk_widget_queue_allocate (GTK_WIDGET (self));
@@ -4863,14 +4964,13 @@ adw_tab_view_close_overview (AdwTabView *self)
   self->overview_count--;
 
   if (self->overview_count == 0) {
-    int i;
+    guint i = self->visible_pages->len;
 
-    for (i = 0; i < self->n_pages; i++) {
-      AdwTabPage *page = adw_tab_view_get_nth_page (self, i);
+    while (i-- > 0) {
+      AdwTabPage *page = g_ptr_array_index (self->visible_pages, i);
 
-      if (page->live_thumbnail || page->invalidated)
-        gtk_widget_set_child_visible (page->bin,
-                                      page == self->selected_page);
+      if (page != self->selected_page)
+        set_page_child_visible (self, page, FALSE);
     }
 
     gtk_widget_queue_allocate (GTK_WIDGET (self));
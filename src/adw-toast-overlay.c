@@ -23,6 +23,20 @@
 #define SCALE_AMOUNT 0.05
 #define NATURAL_WIDTH 450
 
+/**
+ * AdwToastDropPolicy:
+ * @ADW_TOAST_DROP_POLICY_OLDEST: dismiss the toast that would be shown next
+ * @ADW_TOAST_DROP_POLICY_NEWEST: dismiss the toast that would be shown last,
+ *   usually the one that has just been added
+ *
+ * Describes which toasts [class@ToastOverlay] dismisses when its queue is
+ * full.
+ *
+ * See [property@ToastOverlay:max-queue-length].
+ *
+ * Since: 1.10
+ */
+
 /**
  * AdwToastOverlay:
  *
@@ -42,6 +56,19 @@
  *
  * See [class@Toast] for details.
  *
+ * ## Toast Storms
+ *
+ * Toasts are queued until they can be shown, so an application that sends
+ * toasts from background operations can end up with a long queue.
+ *
+ * Toasts with the same [property@Toast:key] are merged: adding such a toast
+ * while another one with the same key is shown or queued updates the existing
+ * toast instead. The number of merged toasts is shown next to the title.
+ *
+ * [property@ToastOverlay:max-queue-length] limits the number of queued toasts.
+ * When it's exceeded, toasts are dismissed according to
+ * [property@ToastOverlay:drop-policy].
+ *
  * ## CSS nodes
  *
  * ```
@@ -82,6 +109,9 @@ typedef struct {
   gulong shown_id;
   gulong dismissed_id;
   gboolean postponing;
+
+  char *key;
+  guint count;
 } ToastInfo;
 
 struct _AdwToastOverlay {
@@ -90,13 +120,20 @@ struct _AdwToastOverlay {
   GtkWidget *child;
 
   GQueue *queue;
+  GHashTable *queue_links;
+  GHashTable *keyed_toasts;
   ToastInfo *current_toast;
   GList *hiding_toasts;
+
+  guint max_queue_length;
+  AdwToastDropPolicy drop_policy;
 };
 
 enum {
   PROP_0,
   PROP_CHILD,
+  PROP_MAX_QUEUE_LENGTH,
+  PROP_DROP_POLICY,
   LAST_PROP,
 };
 
@@ -110,9 +147,25 @@ G_DEFINE_FINAL_TYPE_WITH_CODE (AdwToastOverlay, adw_toast_overlay, GTK_TYPE_WIDG
 
 static GtkBuildableIface *parent_buildable_iface;
 
+static void
+unregister_key (ToastInfo *info)
+{
+  AdwToastOverlay *self = info->overlay;
+
+  if (!info->key)
+    return;
+
+  if (g_hash_table_lookup (self->keyed_toasts, info->key) == info)
+    g_hash_table_remove (self->keyed_toasts, info->key);
+
+  g_clear_pointer (&info->key, g_free);
+}
+
 static void
 free_toast_info (ToastInfo *info)
 {
+  unregister_key (info);
+
   if (info->shown_id && info->show_animation)
     g_signal_handler_disconnect (info->show_animation, info->shown_id);
   if (info->dismissed_id && info->toast)
@@ -129,6 +182,8 @@ free_toast_info (ToastInfo *info)
 static void
 dismiss_and_free_toast_info (ToastInfo *info)
 {
+  unregister_key (info);
+
   g_signal_handler_disconnect (info->toast, info->dismissed_id);
   info->dismissed_id = 0;
 
@@ -137,6 +192,85 @@ dismiss_and_free_toast_info (ToastInfo *info)
   free_toast_info (info);
 }
 
+static void
+queue_push_head (AdwToastOverlay *self,
+                 ToastInfo       *info)
+{
+  g_queue_push_head (self->queue, info);
+  g_hash_table_insert (self->queue_links, info->toast, self->queue->head);
+}
+
+static void
+queue_push_tail (AdwToastOverlay *self,
+                 ToastInfo       *info)
+{
+  g_queue_push_tail (self->queue, info);
+  g_hash_table_insert (self->queue_links, info->toast, self->queue->tail);
+}
+
+static ToastInfo *
+queue_pop_head (AdwToastOverlay *self)
+{
+  ToastInfo *info = g_queue_pop_head (self->queue);
+
+  if (info)
+    g_hash_table_remove (self->queue_links, info->toast);
+
+  return info;
+}
+
+static void
+queue_remove (AdwToastOverlay *self,
+              ToastInfo       *info)
+{
+  GList *link = g_hash_table_lookup (self->queue_links, info->toast);
+
+  if (!link)
+    return;
+
+  g_queue_delete_link (self->queue, link);
+  g_hash_table_remove (self->queue_links, info->toast);
+}
+
+static void
+queue_clear (AdwToastOverlay *self)
+{
+  g_hash_table_remove_all (self->queue_links);
+  g_queue_clear_full (self->queue, (GDestroyNotify) dismiss_and_free_toast_info);
+}
+
+/* @requeued is a toast that was being shown and has been put back into the
+ * queue, it's never dropped */
+static void
+trim_queue (AdwToastOverlay *self,
+            ToastInfo       *requeued)
+{
+  if (self->max_queue_length == 0)
+    return;
+
+  while (self->queue->length > self->max_queue_length) {
+    GList *link;
+    ToastInfo *info;
+
+    if (self->drop_policy == ADW_TOAST_DROP_POLICY_OLDEST) {
+      link = self->queue->head;
+
+      if (link->data == requeued)
+        link = link->next;
+    } else {
+      link = self->queue->tail;
+
+      if (link->data == requeued)
+        link = link->prev;
+    }
+
+    info = link->data;
+
+    queue_remove (self, info);
+    adw_toast_dismiss (info->toast);
+  }
+}
+
 static void
 hide_value_cb (double     value,
                ToastInfo *info)
@@ -217,17 +351,19 @@ dismissed_cb (ToastInfo *info)
     info->dismissed_id = 0;
   }
 
+  unregister_key (info);
+
   if (info == self->current_toast) {
     ToastInfo *next_toast;
 
     hide_current_toast (self);
 
-    next_toast = g_queue_pop_head (self->queue);
+    next_toast = queue_pop_head (self);
 
     if (next_toast)
       show_toast (self, next_toast);
   } else {
-    g_queue_remove (self->queue, info);
+    queue_remove (self, info);
 
     adw_toast_set_overlay (ADW_TOAST (info->toast), NULL);
     if (!info->hide_animation)
@@ -262,6 +398,7 @@ show_toast (AdwToastOverlay *self,
   self->current_toast = info;
 
   info->widget = adw_toast_widget_new (info->toast);
+  adw_toast_widget_set_count (ADW_TOAST_WIDGET (info->widget), info->count);
   gtk_widget_insert_before (info->widget, GTK_WIDGET (self), NULL);
 
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc)
@@ -310,49 +447,73 @@ show_toast (AdwToastOverlay *self,
   g_free (announcement);
 }
 
-static int
-bump_sort_func (ToastInfo *compare,
-                AdwToast  *toast,
-                gpointer   user_data)
-{
-  if (adw_toast_get_priority (compare->toast) == ADW_TOAST_PRIORITY_HIGH)
-    return -1;
-
-  return 1;
-}
-
-static int
-find_toast_func (ToastInfo *info,
-                 AdwToast  *toast)
-{
-  if (info && info->toast == toast)
-    return 0;
-
-  return 1;
-}
-
 static void
 bump_toast (AdwToastOverlay *self,
             AdwToast        *toast)
 {
-  GList *link;
+  GList *link, *sibling;
   ToastInfo *info;
 
   /* Remove it from the queue, then reinsert in the right location */
-  link = g_queue_find_custom (self->queue, toast,
-                              (GCompareFunc) find_toast_func);
+  link = g_hash_table_lookup (self->queue_links, toast);
 
   g_assert (link);
 
   info = link->data;
-  g_queue_remove (self->queue, info);
+  queue_remove (self, info);
 
-  if (adw_toast_get_priority (toast) == ADW_TOAST_PRIORITY_HIGH)
-    g_queue_push_head (self->queue, info);
-  else
-    g_queue_insert_sorted (self->queue, info,
-                           (GCompareDataFunc) bump_sort_func,
-                           NULL);
+  if (adw_toast_get_priority (toast) == ADW_TOAST_PRIORITY_HIGH) {
+    queue_push_head (self, info);
+    return;
+  }
+
+  /* Place it after the high priority toasts */
+  for (sibling = self->queue->head; sibling; sibling = sibling->next) {
+    ToastInfo *sibling_info = sibling->data;
+
+    if (adw_toast_get_priority (sibling_info->toast) != ADW_TOAST_PRIORITY_HIGH)
+      break;
+  }
+
+  if (sibling) {
+    g_queue_insert_before (self->queue, sibling, info);
+    g_hash_table_insert (self->queue_links, toast, sibling->prev);
+  } else {
+    queue_push_tail (self, info);
+  }
+}
+
+static void
+merge_toast (AdwToastOverlay *self,
+             ToastInfo       *info,
+             AdwToast        *toast)
+{
+  GtkWidget *custom_title = adw_toast_get_custom_title (toast);
+
+  if (custom_title) {
+    g_object_ref (custom_title);
+    adw_toast_set_custom_title (toast, NULL);
+    adw_toast_set_custom_title (info->toast, custom_title);
+    g_object_unref (custom_title);
+  } else if (adw_toast_get_title (toast)) {
+    adw_toast_set_title (info->toast, adw_toast_get_title (toast));
+  }
+
+  adw_toast_set_use_markup (info->toast, adw_toast_get_use_markup (toast));
+  adw_toast_set_button_label (info->toast, adw_toast_get_button_label (toast));
+  adw_toast_set_action_name (info->toast, adw_toast_get_action_name (toast));
+  adw_toast_set_action_target_value (info->toast, adw_toast_get_action_target_value (toast));
+  adw_toast_set_timeout (info->toast, adw_toast_get_timeout (toast));
+
+  info->count++;
+
+  if (info == self->current_toast) {
+    adw_toast_widget_set_count (ADW_TOAST_WIDGET (info->widget), info->count);
+    adw_toast_widget_reset_timeout (ADW_TOAST_WIDGET (info->widget));
+  }
+
+  /* @toast never gets an overlay, so adw_toast_dismiss() would do nothing */
+  g_signal_emit_by_name (toast, "dismissed");
 }
 
 static gboolean
@@ -480,7 +641,7 @@ adw_toast_overlay_dispose (GObject *object)
 
   g_clear_list (&self->hiding_toasts, (GDestroyNotify) free_toast_info);
   g_clear_pointer (&self->current_toast, dismiss_and_free_toast_info);
-  g_queue_foreach (self->queue, (GFunc) dismiss_and_free_toast_info, NULL);
+  queue_clear (self);
 
   G_OBJECT_CLASS (adw_toast_overlay_parent_class)->dispose (object);
 }
@@ -491,6 +652,8 @@ adw_toast_overlay_finalize (GObject *object)
   AdwToastOverlay *self = ADW_TOAST_OVERLAY (object);
 
   g_queue_free (self->queue);
+  g_hash_table_unref (self->queue_links);
+  g_hash_table_unref (self->keyed_toasts);
 
   G_OBJECT_CLASS (adw_toast_overlay_parent_class)->finalize (object);
 }
@@ -507,6 +670,12 @@ adw_toast_overlay_get_property (GObject    *object,
   case PROP_CHILD:
     g_value_set_object (value, adw_toast_overlay_get_child (self));
     break;
+  case PROP_MAX_QUEUE_LENGTH:
+    g_value_set_uint (value, adw_toast_overlay_get_max_queue_length (self));
+    break;
+  case PROP_DROP_POLICY:
+    g_value_set_enum (value, adw_toast_overlay_get_drop_policy (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -524,6 +693,12 @@ adw_toast_overlay_set_property (GObject      *object,
   case PROP_CHILD:
     adw_toast_overlay_set_child (self, g_value_get_object (value));
     break;
+  case PROP_MAX_QUEUE_LENGTH:
+    adw_toast_overlay_set_max_queue_length (self, g_value_get_uint (value));
+    break;
+  case PROP_DROP_POLICY:
+    adw_toast_overlay_set_drop_policy (self, g_value_get_enum (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -555,6 +730,40 @@ adw_toast_overlay_class_init (AdwToastOverlayClass *klass)
                          GTK_TYPE_WIDGET,
                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwToastOverlay:max-queue-length:
+   *
+   * The maximum number of toasts waiting to be shown.
+   *
+   * When a toast is added to a full queue, a toast is dismissed according to
+   * [property@ToastOverlay:drop-policy].
+   *
+   * The currently shown toast doesn't count towards the limit.
+   *
+   * If the value is 0, the queue isn't limited.
+   *
+   * Since: 1.10
+   */
+  props[PROP_MAX_QUEUE_LENGTH] =
+    g_param_spec_uint ("max-queue-length", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwToastOverlay:drop-policy:
+   *
+   * Which toasts to dismiss when the queue is full.
+   *
+   * See [property@ToastOverlay:max-queue-length].
+   *
+   * Since: 1.10
+   */
+  props[PROP_DROP_POLICY] =
+    g_param_spec_enum ("drop-policy", NULL, NULL,
+                       ADW_TYPE_TOAST_DROP_POLICY,
+                       ADW_TOAST_DROP_POLICY_OLDEST,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_css_name (widget_class, "toastoverlay");
@@ -567,6 +776,9 @@ static void
 adw_toast_overlay_init (AdwToastOverlay *self)
 {
   self->queue = g_queue_new ();
+  self->queue_links = g_hash_table_new (NULL, NULL);
+  self->keyed_toasts = g_hash_table_new (g_str_hash, g_str_equal);
+  self->drop_policy = ADW_TOAST_DROP_POLICY_OLDEST;
 
   gtk_widget_set_overflow (GTK_WIDGET (self), GTK_OVERFLOW_HIDDEN);
 }
@@ -672,13 +884,18 @@ adw_toast_overlay_set_child (AdwToastOverlay *self,
  *
  * If called on a toast currently in the queue, the toast will be bumped
  * forward to be shown as soon as possible.
+ *
+ * If @toast has a [property@Toast:key] and a toast with the same key is
+ * already shown or queued, that toast will be updated instead and @toast will
+ * be dismissed.
  */
 void
 adw_toast_overlay_add_toast (AdwToastOverlay *self,
                              AdwToast        *toast)
 {
-  ToastInfo *info;
+  ToastInfo *info, *requeued;
   AdwToastOverlay *overlay;
+  const char *key;
 
   g_return_if_fail (ADW_IS_TOAST_OVERLAY (self));
   g_return_if_fail (ADW_IS_TOAST (toast));
@@ -706,15 +923,34 @@ adw_toast_overlay_add_toast (AdwToastOverlay *self,
     return;
   }
 
+  key = adw_toast_get_key (toast);
+
+  if (key) {
+    info = g_hash_table_lookup (self->keyed_toasts, key);
+
+    if (info) {
+      merge_toast (self, info, toast);
+
+      g_object_unref (toast);
+      return;
+    }
+  }
+
   adw_toast_set_overlay (toast, self);
 
   info = g_new0 (ToastInfo, 1);
   info->overlay = self;
   info->toast = toast;
+  info->count = 1;
   info->dismissed_id =
     g_signal_connect_swapped (info->toast, "dismissed",
                               G_CALLBACK (dismissed_cb), info);
 
+  if (key) {
+    info->key = g_strdup (key);
+    g_hash_table_insert (self->keyed_toasts, info->key, info);
+  }
+
   if (!self->current_toast) {
     show_toast (self, info);
 
@@ -723,15 +959,18 @@ adw_toast_overlay_add_toast (AdwToastOverlay *self,
 
   switch (adw_toast_get_priority (toast)) {
   case ADW_TOAST_PRIORITY_NORMAL:
-    g_queue_push_tail (self->queue, info);
+    queue_push_tail (self, info);
+    trim_queue (self, NULL);
     break;
 
   case ADW_TOAST_PRIORITY_HIGH:
-    self->current_toast->postponing = TRUE;
-    g_queue_push_head (self->queue, self->current_toast);
+    requeued = self->current_toast;
+    requeued->postponing = TRUE;
+    queue_push_head (self, requeued);
 
     hide_current_toast (self);
     show_toast (self, info);
+    trim_queue (self, requeued);
     break;
 
   default:
@@ -754,8 +993,102 @@ adw_toast_overlay_dismiss_all (AdwToastOverlay *self)
 {
   g_return_if_fail (ADW_IS_TOAST_OVERLAY (self));
 
-  g_queue_clear_full (self->queue, (GDestroyNotify) dismiss_and_free_toast_info);
+  queue_clear (self);
 
   if (self->current_toast)
     adw_toast_dismiss (self->current_toast->toast);
 }
+
+/**
+ * adw_toast_overlay_get_max_queue_length:
+ * @self: a toast overlay
+ *
+ * Gets the maximum number of toasts waiting to be shown.
+ *
+ * Returns: the maximum queue length, or 0 if it's not limited
+ *
+ * Since: 1.10
+ */
+guint
+adw_toast_overlay_get_max_queue_length (AdwToastOverlay *self)
+{
+  g_return_val_if_fail (ADW_IS_TOAST_OVERLAY (self), 0);
+
+  return self->max_queue_length;
+}
+
+/**
+ * adw_toast_overlay_set_max_queue_length:
+ * @self: a toast overlay
+ * @max_queue_length: the maximum queue length
+ *
+ * Sets the maximum number of toasts waiting to be shown.
+ *
+ * When a toast is added to a full queue, a toast is dismissed according to
+ * [property@ToastOverlay:drop-policy].
+ *
+ * The currently shown toast doesn't count towards the limit.
+ *
+ * If @max_queue_length is 0, the queue isn't limited.
+ *
+ * Since: 1.10
+ */
+void
+adw_toast_overlay_set_max_queue_length (AdwToastOverlay *self,
+                                        guint            max_queue_length)
+{
+  g_return_if_fail (ADW_IS_TOAST_OVERLAY (self));
+
+  if (self->max_queue_length == max_queue_length)
+    return;
+
+  self->max_queue_length = max_queue_length;
+
+  trim_queue (self, NULL);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_QUEUE_LENGTH]);
+}
+
+/**
+ * adw_toast_overlay_get_drop_policy:
+ * @self: a toast overlay
+ *
+ * Gets which toasts to dismiss when the queue is full.
+ *
+ * Returns: the drop policy
+ *
+ * Since: 1.10
+ */
+AdwToastDropPolicy
+adw_toast_overlay_get_drop_policy (AdwToastOverlay *self)
+{
+  g_return_val_if_fail (ADW_IS_TOAST_OVERLAY (self), ADW_TOAST_DROP_POLICY_OLDEST);
+
+  return self->drop_policy;
+}
+
+/**
+ * adw_toast_overlay_set_drop_policy:
+ * @self: a toast overlay
+ * @policy: the drop policy
+ *
+ * Sets which toasts to dismiss when the queue is full.
+ *
+ * See [property@ToastOverlay:max-queue-length].
+ *
+ * Since: 1.10
+ */
+void
+adw_toast_overlay_set_drop_policy (AdwToastOverlay    *self,
+                                   AdwToastDropPolicy  policy)
+{
+  g_return_if_fail (ADW_IS_TOAST_OVERLAY (self));
+  g_return_if_fail (policy <= ADW_TOAST_DROP_POLICY_NEWEST);
+
+  if (self->drop_policy == policy)
+    return;
+
+  self->drop_policy = policy;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_DROP_POLICY]);
+}
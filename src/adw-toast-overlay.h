@@ -17,6 +17,11 @@
 
 G_BEGIN_DECLS
 
+typedef enum {
+  ADW_TOAST_DROP_POLICY_OLDEST,
+  ADW_TOAST_DROP_POLICY_NEWEST,
+} AdwToastDropPolicy;
+
 #define ADW_TYPE_TOAST_OVERLAY (adw_toast_overlay_get_type())
 
 ADW_AVAILABLE_IN_ALL
@@ -38,4 +43,16 @@ void adw_toast_overlay_add_toast (AdwToastOverlay *self,
 ADW_AVAILABLE_IN_1_7
 void adw_toast_overlay_dismiss_all (AdwToastOverlay *self);
 
+ADW_AVAILABLE_IN_1_10
+guint adw_toast_overlay_get_max_queue_length (AdwToastOverlay *self);
+ADW_AVAILABLE_IN_1_10
+void  adw_toast_overlay_set_max_queue_length (AdwToastOverlay *self,
+                                              guint            max_queue_length);
+
+ADW_AVAILABLE_IN_1_10
+AdwToastDropPolicy adw_toast_overlay_get_drop_policy (AdwToastOverlay    *self);
+ADW_AVAILABLE_IN_1_10
+void               adw_toast_overlay_set_drop_policy (AdwToastOverlay    *self,
+                                                      AdwToastDropPolicy  policy);
+
 G_END_DECLS
@@ -25,6 +25,9 @@ GtkWidget *adw_toast_widget_new (AdwToast *toast) G_GNUC_WARN_UNUSED_RESULT;
 
 void adw_toast_widget_reset_timeout (AdwToastWidget *self);
 
+void adw_toast_widget_set_count (AdwToastWidget *self,
+                                 guint           count);
+
 gboolean adw_toast_widget_get_button_visible (AdwToastWidget *self);
 
 G_END_DECLS
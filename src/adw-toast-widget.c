@@ -5,6 +5,7 @@
  */
 
 #include "config.h"
+#include <glib/gi18n-lib.h>
 
 #include "adw-toast-widget-private.h"
 
@@ -14,6 +15,7 @@ struct _AdwToastWidget {
   GtkWidget parent_instance;
 
   AdwBin *title_bin;
+  GtkWidget *count_label;
   GtkWidget *action_button;
   GtkWidget *close_button;
 
@@ -242,6 +244,7 @@ adw_toast_widget_class_init (AdwToastWidgetClass *klass)
                                                "/org/gnome/Adwaita/ui/adw-toast-widget.ui");
 
   gtk_widget_class_bind_template_child (widget_class, AdwToastWidget, title_bin);
+  gtk_widget_class_bind_template_child (widget_class, AdwToastWidget, count_label);
   gtk_widget_class_bind_template_child (widget_class, AdwToastWidget, action_button);
   gtk_widget_class_bind_template_child (widget_class, AdwToastWidget, close_button);
 
@@ -282,6 +285,27 @@ adw_toast_widget_reset_timeout (AdwToastWidget *self)
   start_timeout (self);
 }
 
+void
+adw_toast_widget_set_count (AdwToastWidget *self,
+                            guint           count)
+{
+  gboolean visible = count > 1;
+
+  g_assert (ADW_IS_TOAST_WIDGET (self));
+
+  if (visible) {
+    /* Translators: the number of toasts merged into one, shown after its title */
+    char *label = g_strdup_printf (_("(%u)"), count);
+
+    gtk_label_set_label (GTK_LABEL (self->count_label), label);
+
+    g_free (label);
+  }
+
+  gtk_widget_set_visible (self->count_label, visible);
+  gtk_widget_set_hexpand (GTK_WIDGET (self->title_bin), !visible);
+}
+
 gboolean
 adw_toast_widget_get_button_visible (AdwToastWidget *self)
 {
@@ -51,6 +51,9 @@
  * [property@Toast:custom-title] can be used to replace the title label with a
  * custom widget.
  *
+ * Set [property@Toast:key] to merge toasts that would otherwise pile up in the
+ * queue, for example ones sent by background operations.
+ *
  * ## Actions
  *
  * Toasts can have one button on them, with a label and an attached
@@ -158,6 +161,7 @@ struct _AdwToast {
   guint timeout;
   GtkWidget *custom_title;
   gboolean use_markup;
+  char *key;
 
   AdwToastOverlay *overlay;
 };
@@ -172,6 +176,7 @@ enum {
   PROP_TIMEOUT,
   PROP_CUSTOM_TITLE,
   PROP_USE_MARKUP,
+  PROP_KEY,
   LAST_PROP
 };
 
@@ -212,6 +217,7 @@ adw_toast_finalize (GObject *object)
   g_clear_pointer (&self->button_label, g_free);
   g_clear_pointer (&self->action_name, g_free);
   g_clear_pointer (&self->action_target, g_variant_unref);
+  g_clear_pointer (&self->key, g_free);
 
   G_OBJECT_CLASS (adw_toast_parent_class)->finalize (object);
 }
@@ -249,6 +255,9 @@ adw_toast_get_property (GObject    *object,
   case PROP_USE_MARKUP:
     g_value_set_boolean (value, adw_toast_get_use_markup (self));
     break;
+  case PROP_KEY:
+    g_value_set_string (value, adw_toast_get_key (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -287,6 +296,9 @@ adw_toast_set_property (GObject      *object,
   case PROP_USE_MARKUP:
     adw_toast_set_use_markup (self, g_value_get_boolean (value));
     break;
+  case PROP_KEY:
+    adw_toast_set_key (self, g_value_get_string (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -426,6 +438,29 @@ adw_toast_class_init (AdwToastClass *klass)
                           TRUE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwToast:key:
+   *
+   * The key used to merge the toast with other toasts.
+   *
+   * When a toast is added to a [class@ToastOverlay] that is already showing or
+   * queueing a toast with the same key, the new toast isn't queued. Instead,
+   * the existing toast takes its title, button label, action and timeout, and
+   * its timeout is reset if it's being shown. The new toast is dismissed, and
+   * the number of merged toasts is shown next to the title.
+   *
+   * This is useful for toasts sent by background operations, such as
+   * reporting synced files, as many of them can be sent in a short time.
+   *
+   * The key must be set before adding the toast to the overlay.
+   *
+   * Since: 1.10
+   */
+  props[PROP_KEY] =
+    g_param_spec_string ("key", NULL, NULL,
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -1016,3 +1051,49 @@ adw_toast_set_use_markup (AdwToast *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_USE_MARKUP]);
 }
+
+/**
+ * adw_toast_get_key:
+ * @self: a toast
+ *
+ * Gets the key used to merge @self with other toasts.
+ *
+ * Returns: (nullable): the key
+ *
+ * Since: 1.10
+ */
+const char *
+adw_toast_get_key (AdwToast *self)
+{
+  g_return_val_if_fail (ADW_IS_TOAST (self), NULL);
+
+  return self->key;
+}
+
+/**
+ * adw_toast_set_key:
+ * @self: a toast
+ * @key: (nullable): the key
+ *
+ * Sets the key used to merge @self with other toasts.
+ *
+ * See [property@Toast:key].
+ *
+ * Since: 1.10
+ */
+void
+adw_toast_set_key (AdwToast   *self,
+                   const char *key)
+{
+  g_return_if_fail (ADW_IS_TOAST (self));
+
+  if (self->overlay) {
+    g_critical ("Toast keys can't be changed after the toast has been added to an overlay");
+    return;
+  }
+
+  if (!g_set_str (&self->key, key))
+    return;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_KEY]);
+}
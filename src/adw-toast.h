@@ -88,6 +88,12 @@ ADW_AVAILABLE_IN_1_4
 void     adw_toast_set_use_markup (AdwToast *self,
                                    gboolean  use_markup);
 
+ADW_AVAILABLE_IN_1_10
+const char *adw_toast_get_key (AdwToast   *self);
+ADW_AVAILABLE_IN_1_10
+void        adw_toast_set_key (AdwToast   *self,
+                               const char *key);
+
 ADW_AVAILABLE_IN_ALL
 void adw_toast_dismiss (AdwToast *self);
 
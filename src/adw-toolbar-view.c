@@ -10,6 +10,7 @@
 #include "adw-toolbar-view.h"
 
 #include "adw-gtkbuilder-utils-private.h"
+#include "adw-layout-profiler-private.h"
 #include "adw-widget-utils-private.h"
 
 /**
@@ -277,6 +278,7 @@ adw_toolbar_view_measure (GtkWidget      *widget,
   AdwToolbarView *self = ADW_TOOLBAR_VIEW (widget);
   int top_min, bottom_min, content_min = 0;
   int top_nat, bottom_nat, content_nat = 0;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->top_bar, orientation, -1,
                       &top_min, &top_nat, NULL, NULL);
@@ -352,6 +354,8 @@ adw_toolbar_view_measure (GtkWidget      *widget,
     *minimum_baseline = -1;
   if (natural_baseline)
     *natural_baseline = -1;
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static void
@@ -364,6 +368,7 @@ adw_toolbar_view_size_allocate (GtkWidget *widget,
   int top_min, top_nat, bottom_min, bottom_nat, content_min = 0;
   int top_height, bottom_height;
   int content_height, content_offset;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   gtk_widget_measure (self->top_bar, GTK_ORIENTATION_VERTICAL, width,
                       &top_min, &top_nat, NULL, NULL);
@@ -415,6 +420,8 @@ adw_toolbar_view_size_allocate (GtkWidget *widget,
                          gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (0, content_offset)));
 
   update_undershoots (self);
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static void
@@ -15,6 +15,8 @@
 #include "adw-view-stack.h"
 
 #include "adw-animation-util.h"
+#include "adw-bin.h"
+#include "adw-enums.h"
 #include "adw-gizmo-private.h"
 #include "adw-timed-animation.h"
 #include "adw-widget-utils-private.h"
@@ -44,6 +46,16 @@
  * [property@ViewStackPage:section-title] properties. Currently, only
  * [class@ViewSwitcherSidebar] displays groups.
  *
+ * ## Loading Pages on Demand
+ *
+ * Pages added with [method@ViewStack.add_lazy] don't create their contents
+ * until they are shown for the first time. Depending on their
+ * [property@ViewStackPage:unload-policy], their contents can also be destroyed
+ * once they are hidden, and created again the next time they are shown. The
+ * title, icon, attention request and badge of such pages stay available the
+ * whole time, so [class@ViewSwitcher] and other switchers can display them as
+ * usual.
+ *
  * Unlike [class@Gtk.Stack], transitions between views can only be animated via
  * a crossfade and size changes are always interpolated. Animations are disabled
  * by default. Use [property@ViewStack:enable-transitions] to enable them.
@@ -92,6 +104,37 @@
  * An auxiliary class used by [class@ViewStack].
  */
 
+/**
+ * AdwViewStackUnloadPolicy:
+ * @ADW_VIEW_STACK_UNLOAD_POLICY_KEEP: Keep the contents of the page once
+ *   they have been loaded
+ * @ADW_VIEW_STACK_UNLOAD_POLICY_TIMEOUT: Unload the contents of the page once
+ *   it has been hidden for [property@ViewStackPage:unload-timeout] seconds
+ * @ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE: Unload the contents of the page as
+ *   soon as it's hidden
+ *
+ * Describes when the contents of pages added with [method@ViewStack.add_lazy]
+ * are unloaded.
+ *
+ * See [property@ViewStackPage:unload-policy].
+ *
+ * Since: 1.10
+ */
+
+/**
+ * AdwViewStackPageLoadFunc:
+ * @page: the page to load
+ * @user_data: (closure): user data
+ *
+ * Creates the contents of @page.
+ *
+ * See [method@ViewStack.add_lazy].
+ *
+ * Returns: (transfer floating): the contents of @page
+ *
+ * Since: 1.10
+ */
+
 /**
  * AdwViewStackPages:
  *
@@ -129,6 +172,7 @@ struct _AdwViewStackPage {
 
   GtkATContext *at_context;
   AdwViewStackPage *next_page;
+  guint position;
 
   gboolean needs_attention;
   gboolean visible;
@@ -137,6 +181,13 @@ struct _AdwViewStackPage {
 
   gboolean starts_section;
   char *section_title;
+
+  AdwViewStackPageLoadFunc load_func;
+  gpointer load_func_data;
+  GDestroyNotify load_func_data_destroy;
+  AdwViewStackUnloadPolicy unload_policy;
+  guint unload_timeout;
+  guint unload_timeout_id;
 };
 
 static void adw_view_stack_page_accessible_init (GtkAccessibleInterface *iface);
@@ -156,6 +207,9 @@ enum {
   PAGE_PROP_VISIBLE,
   PAGE_PROP_STARTS_SECTION,
   PAGE_PROP_SECTION_TITLE,
+  PAGE_PROP_UNLOAD_POLICY,
+  PAGE_PROP_UNLOAD_TIMEOUT,
+  PAGE_PROP_LOADED,
   LAST_PAGE_PROP,
   PAGE_PROP_ACCESSIBLE_ROLE
 };
@@ -182,6 +236,8 @@ struct _AdwViewStack {
   GtkWidget parent_instance;
 
   GPtrArray *children;
+  GHashTable *pages_by_name;
+  GHashTable *pages_by_widget;
 
   AdwViewStackPage *visible_child;
 
@@ -190,6 +246,7 @@ struct _AdwViewStack {
   gboolean enable_transitions;
   guint transition_duration;
   AdwViewStackPage *last_visible_child;
+  GskRenderNode *last_visible_node;
   gboolean transition_running;
   AdwAnimation *animation;
 
@@ -249,6 +306,15 @@ adw_view_stack_page_get_property (GObject      *object,
   case PAGE_PROP_SECTION_TITLE:
     g_value_set_string (value, adw_view_stack_page_get_section_title (self));
     break;
+  case PAGE_PROP_UNLOAD_POLICY:
+    g_value_set_enum (value, adw_view_stack_page_get_unload_policy (self));
+    break;
+  case PAGE_PROP_UNLOAD_TIMEOUT:
+    g_value_set_uint (value, adw_view_stack_page_get_unload_timeout (self));
+    break;
+  case PAGE_PROP_LOADED:
+    g_value_set_boolean (value, adw_view_stack_page_get_loaded (self));
+    break;
   case PAGE_PROP_ACCESSIBLE_ROLE:
     g_value_set_enum (value, GTK_ACCESSIBLE_ROLE_TAB_PANEL);
     break;
@@ -300,6 +366,12 @@ adw_view_stack_page_set_property (GObject      *object,
   case PAGE_PROP_SECTION_TITLE:
     adw_view_stack_page_set_section_title (self, g_value_get_string (value));
     break;
+  case PAGE_PROP_UNLOAD_POLICY:
+    adw_view_stack_page_set_unload_policy (self, g_value_get_enum (value));
+    break;
+  case PAGE_PROP_UNLOAD_TIMEOUT:
+    adw_view_stack_page_set_unload_timeout (self, g_value_get_uint (value));
+    break;
   case PAGE_PROP_ACCESSIBLE_ROLE:
     break;
   default:
@@ -315,8 +387,14 @@ adw_view_stack_page_dispose (GObject *object)
 
   self->in_destruction = TRUE;
 
+  g_clear_handle_id (&self->unload_timeout_id, g_source_remove);
   g_clear_object (&self->at_context);
 
+  if (self->load_func_data_destroy)
+    g_clear_pointer (&self->load_func_data, self->load_func_data_destroy);
+
+  self->load_func = NULL;
+
   G_OBJECT_CLASS (adw_view_stack_page_parent_class)->dispose (object);
 }
 
@@ -467,6 +545,52 @@ adw_view_stack_page_class_init (AdwViewStackPageClass *class)
                          NULL,
                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwViewStackPage:unload-policy:
+   *
+   * When to unload the contents of this page after it's hidden.
+   *
+   * Only pages added with [method@ViewStack.add_lazy] can be unloaded, as
+   * their contents can be created again when they are shown. This property
+   * does nothing for other pages.
+   *
+   * Since: 1.10
+   */
+  page_props[PAGE_PROP_UNLOAD_POLICY] =
+    g_param_spec_enum ("unload-policy", NULL, NULL,
+                       ADW_TYPE_VIEW_STACK_UNLOAD_POLICY,
+                       ADW_VIEW_STACK_UNLOAD_POLICY_KEEP,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwViewStackPage:unload-timeout:
+   *
+   * The time in seconds after which this page is unloaded once hidden.
+   *
+   * Does nothing unless [property@ViewStackPage:unload-policy] is set to
+   * `ADW_VIEW_STACK_UNLOAD_POLICY_TIMEOUT`.
+   *
+   * Since: 1.10
+   */
+  page_props[PAGE_PROP_UNLOAD_TIMEOUT] =
+    g_param_spec_uint ("unload-timeout", NULL, NULL,
+                       0, G_MAXUINT, 30,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwViewStackPage:loaded:
+   *
+   * Whether the contents of this page are currently loaded.
+   *
+   * This is always `TRUE` for pages not added with [method@ViewStack.add_lazy].
+   *
+   * Since: 1.10
+   */
+  page_props[PAGE_PROP_LOADED] =
+    g_param_spec_boolean ("loaded", NULL, NULL,
+                          TRUE,
+                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PAGE_PROP, page_props);
 
   g_object_class_override_property (object_class, PAGE_PROP_ACCESSIBLE_ROLE, "accessible-role");
@@ -476,6 +600,102 @@ static void
 adw_view_stack_page_init (AdwViewStackPage *self)
 {
   self->visible = TRUE;
+  self->unload_policy = ADW_VIEW_STACK_UNLOAD_POLICY_KEEP;
+  self->unload_timeout = 30;
+}
+
+static gboolean
+page_is_shown (AdwViewStackPage *page)
+{
+  GtkWidget *parent;
+  AdwViewStack *stack;
+
+  if (!page->widget)
+    return FALSE;
+
+  parent = gtk_widget_get_parent (page->widget);
+  if (!ADW_IS_VIEW_STACK (parent))
+    return FALSE;
+
+  stack = ADW_VIEW_STACK (parent);
+
+  return stack->visible_child == page || stack->last_visible_child == page;
+}
+
+static void
+page_load (AdwViewStackPage *page)
+{
+  GtkWidget *content;
+
+  g_clear_handle_id (&page->unload_timeout_id, g_source_remove);
+
+  if (!page->load_func || adw_view_stack_page_get_loaded (page))
+    return;
+
+  content = page->load_func (page, page->load_func_data);
+
+  if (!content) {
+    g_critical ("AdwViewStackPage load function returned NULL for page %s",
+                page->name ? page->name : "(unnamed)");
+    return;
+  }
+
+  adw_bin_set_child (ADW_BIN (page->widget), content);
+
+  g_object_notify_by_pspec (G_OBJECT (page), page_props[PAGE_PROP_LOADED]);
+}
+
+static void
+page_unload (AdwViewStackPage *page)
+{
+  g_clear_handle_id (&page->unload_timeout_id, g_source_remove);
+
+  if (!page->load_func || !adw_view_stack_page_get_loaded (page))
+    return;
+
+  adw_bin_set_child (ADW_BIN (page->widget), NULL);
+
+  g_object_notify_by_pspec (G_OBJECT (page), page_props[PAGE_PROP_LOADED]);
+}
+
+static void
+unload_timeout_cb (AdwViewStackPage *page)
+{
+  page->unload_timeout_id = 0;
+
+  page_unload (page);
+}
+
+static void
+update_page_unload (AdwViewStackPage *page)
+{
+  if (!page->load_func || page->in_destruction)
+    return;
+
+  if (page_is_shown (page) || !adw_view_stack_page_get_loaded (page)) {
+    g_clear_handle_id (&page->unload_timeout_id, g_source_remove);
+    return;
+  }
+
+  switch (page->unload_policy) {
+  case ADW_VIEW_STACK_UNLOAD_POLICY_KEEP:
+    g_clear_handle_id (&page->unload_timeout_id, g_source_remove);
+    break;
+  case ADW_VIEW_STACK_UNLOAD_POLICY_TIMEOUT:
+    if (page->unload_timeout_id)
+      break;
+
+    page->unload_timeout_id =
+      g_timeout_add_seconds_once (page->unload_timeout,
+                                  (GSourceOnceFunc) unload_timeout_cb,
+                                  page);
+    break;
+  case ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE:
+    page_unload (page);
+    break;
+  default:
+    g_assert_not_reached ();
+  }
 }
 
 static GtkATContext *
@@ -875,34 +1095,72 @@ static AdwViewStackPage *
 find_page_for_widget (AdwViewStack *self,
                       GtkWidget    *child)
 {
-  AdwViewStackPage *page;
-  guint i;
-
-  for (i = 0; i < self->children->len; i++) {
-    page = g_ptr_array_index (self->children, i);
-
-    if (page->widget == child)
-      return page;
-  }
-
-  return NULL;
+  return g_hash_table_lookup (self->pages_by_widget, child);
 }
 
 static AdwViewStackPage *
 find_page_for_name (AdwViewStack *self,
                     const char   *name)
 {
-  AdwViewStackPage *page;
+  GPtrArray *pages;
+
+  if (!name)
+    return NULL;
+
+  pages = g_hash_table_lookup (self->pages_by_name, name);
+
+  /* With duplicate names, the first page has the name */
+  return pages ? g_ptr_array_index (pages, 0) : NULL;
+}
+
+static void
+register_page_name (AdwViewStack     *self,
+                    AdwViewStackPage *page)
+{
+  GPtrArray *pages;
   guint i;
 
-  for (i = 0; i < self->children->len; i++) {
-    page = g_ptr_array_index (self->children, i);
+  if (!page->name)
+    return;
 
-    if (g_strcmp0 (page->name, name) == 0)
-      return page;
+  pages = g_hash_table_lookup (self->pages_by_name, page->name);
+
+  if (!pages) {
+    pages = g_ptr_array_new ();
+    g_hash_table_insert (self->pages_by_name, g_strdup (page->name), pages);
   }
 
-  return NULL;
+  /* Keep pages with the same name in order, duplicate names are rare so
+   * there's only ever a few of them */
+  for (i = 0; i < pages->len; i++) {
+    AdwViewStackPage *p = g_ptr_array_index (pages, i);
+
+    if (p->position > page->position)
+      break;
+  }
+
+  g_ptr_array_insert (pages, i, page);
+}
+
+static void
+unregister_page_name (AdwViewStack     *self,
+                      AdwViewStackPage *page)
+{
+  GPtrArray *pages;
+
+  if (!page->name)
+    return;
+
+  pages = g_hash_table_lookup (self->pages_by_name, page->name);
+
+  if (!pages)
+    return;
+
+  /* The next page with the same name, if any, takes the name over */
+  g_ptr_array_remove (pages, page);
+
+  if (pages->len == 0)
+    g_hash_table_remove (self->pages_by_name, page->name);
 }
 
 static void
@@ -932,10 +1190,16 @@ static void
 transition_done_cb (AdwViewStack *self)
 {
   if (self->last_visible_child) {
-    gtk_widget_set_child_visible (self->last_visible_child->widget, FALSE);
+    AdwViewStackPage *last_page = self->last_visible_child;
+
+    gtk_widget_set_child_visible (last_page->widget, FALSE);
     self->last_visible_child = NULL;
+
+    update_page_unload (last_page);
   }
 
+  g_clear_pointer (&self->last_visible_node, gsk_render_node_unref);
+
   adw_animation_reset (self->animation);
 
   set_transition_running (self, FALSE);
@@ -946,6 +1210,7 @@ set_visible_child (AdwViewStack     *self,
                    AdwViewStackPage *page)
 {
   GtkWidget *widget = GTK_WIDGET (self);
+  AdwViewStackPage *old_page;
   GtkRoot *root;
   GtkWidget *focus;
   gboolean contains_focus = FALSE;
@@ -977,16 +1242,11 @@ set_visible_child (AdwViewStack     *self,
     return;
 
   if (self->pages) {
-    guint position, i;
-
-    for (i = 0, position = 0; i < self->children->len; i++, position++) {
-      AdwViewStackPage *p = g_ptr_array_index (self->children, i);
+    if (self->visible_child)
+      old_pos = self->visible_child->position;
 
-      if (p == self->visible_child)
-        old_pos = position;
-      else if (p == page)
-        new_pos = position;
-    }
+    if (page)
+      new_pos = page->position;
   }
 
   root = gtk_widget_get_root (widget);
@@ -1007,6 +1267,8 @@ set_visible_child (AdwViewStack     *self,
   if (self->transition_running)
     adw_animation_skip (self->animation);
 
+  old_page = self->visible_child;
+
   if (self->visible_child && self->visible_child->widget) {
     if (gtk_widget_is_visible (widget)) {
       self->last_visible_child = self->visible_child;
@@ -1019,7 +1281,12 @@ set_visible_child (AdwViewStack     *self,
 
   self->visible_child = page;
 
+  if (old_page)
+    update_page_unload (old_page);
+
   if (page) {
+    page_load (page);
+
     gtk_widget_set_child_visible (page->widget, TRUE);
 
     if (contains_focus) {
@@ -1074,6 +1341,9 @@ update_child_visible (AdwViewStack     *self,
   if (page == self->last_visible_child) {
     gtk_widget_set_child_visible (self->last_visible_child->widget, FALSE);
     self->last_visible_child = NULL;
+    g_clear_pointer (&self->last_visible_node, gsk_render_node_unref);
+
+    update_page_unload (page);
   }
 
   gtk_accessible_update_state (GTK_ACCESSIBLE (page),
@@ -1107,23 +1377,11 @@ stack_child_visibility_notify_cb (GObject    *obj,
 }
 
 static void
-add_page (AdwViewStack     *self,
-          AdwViewStackPage *page)
+insert_page (AdwViewStack     *self,
+             AdwViewStackPage *page)
 {
-  g_return_if_fail (page->widget != NULL);
-
-  if (page->name) {
-    guint i;
-
-    for (i = 0; i < self->children->len; i++) {
-      AdwViewStackPage *p = g_ptr_array_index (self->children, i);
-
-      if (p->name && g_strcmp0 (p->name, page->name) == 0) {
-        g_warning ("While adding page: duplicate child name in AdwViewStack: %s", page->name);
-        break;
-      }
-    }
-  }
+  if (find_page_for_name (self, page->name))
+    g_warning ("While adding page: duplicate child name in AdwViewStack: %s", page->name);
 
   if (self->children->len > 0) {
     AdwViewStackPage *prev_last = g_ptr_array_index (self->children, self->children->len - 1);
@@ -1133,19 +1391,31 @@ add_page (AdwViewStack     *self,
     page->next_page = NULL;
   }
 
+  page->position = self->children->len;
   g_ptr_array_add (self->children, g_object_ref (page));
+  g_hash_table_insert (self->pages_by_widget, page->widget, page);
+  register_page_name (self, page);
 
   gtk_widget_set_child_visible (page->widget, FALSE);
   gtk_widget_set_parent (page->widget, GTK_WIDGET (self));
 
+  g_signal_connect (page->widget, "notify::visible",
+                    G_CALLBACK (stack_child_visibility_notify_cb), self);
+}
+
+static void
+add_page (AdwViewStack     *self,
+          AdwViewStackPage *page)
+{
+  g_return_if_fail (page->widget != NULL);
+
+  insert_page (self, page);
+
   if (self->pages) {
     g_list_model_items_changed (G_LIST_MODEL (self->pages), self->children->len - 1, 0, 1);
     g_object_notify_by_pspec (G_OBJECT (self->pages), pages_props[PAGES_PROP_N_ITEMS]);
   }
 
-  g_signal_connect (page->widget, "notify::visible",
-                    G_CALLBACK (stack_child_visibility_notify_cb), self);
-
   if (self->visible_child == NULL &&
       gtk_widget_get_visible (page->widget))
     set_visible_child (self, page);
@@ -1187,7 +1457,7 @@ stack_remove (AdwViewStack  *self,
 {
   AdwViewStackPage *page;
   gboolean was_visible;
-  guint i;
+  guint position, i;
 
   page = find_page_for_widget (self, child);
   if (!page)
@@ -1197,6 +1467,8 @@ stack_remove (AdwViewStack  *self,
                                         stack_child_visibility_notify_cb,
                                         self);
 
+  g_clear_handle_id (&page->unload_timeout_id, g_source_remove);
+
   was_visible = gtk_widget_get_visible (child);
 
   if (self->visible_child == page)
@@ -1204,16 +1476,25 @@ stack_remove (AdwViewStack  *self,
 
   gtk_widget_unparent (child);
 
+  g_hash_table_remove (self->pages_by_widget, child);
+  unregister_page_name (self, page);
+
   g_clear_object (&page->widget);
 
-  g_ptr_array_remove (self->children, page);
+  position = page->position;
 
-  for (i = 0; i < self->children->len; i++) {
-    AdwViewStackPage *prev_page = g_ptr_array_index (self->children, i);
-    if (prev_page->next_page == page) {
-      prev_page->next_page = page->next_page;
-      break;
-    }
+  if (position > 0) {
+    AdwViewStackPage *prev_page = g_ptr_array_index (self->children, position - 1);
+
+    prev_page->next_page = page->next_page;
+  }
+
+  g_ptr_array_remove_index (self->children, position);
+
+  for (i = position; i < self->children->len; i++) {
+    AdwViewStackPage *next_page = g_ptr_array_index (self->children, i);
+
+    next_page->position = i;
   }
 
   g_object_unref (page);
@@ -1224,6 +1505,26 @@ stack_remove (AdwViewStack  *self,
     gtk_widget_queue_resize (GTK_WIDGET (self));
 }
 
+static void
+snapshot_last_visible_child (AdwViewStack *self,
+                             GtkSnapshot  *snapshot)
+{
+  /* The old page is fading out, so freeze it on the first frame instead of
+   * snapshotting it again every frame in case it keeps redrawing */
+  if (!self->last_visible_node) {
+    GtkSnapshot *child_snapshot = gtk_snapshot_new ();
+
+    gtk_widget_snapshot_child (GTK_WIDGET (self),
+                               self->last_visible_child->widget,
+                               child_snapshot);
+
+    self->last_visible_node = gtk_snapshot_free_to_node (child_snapshot);
+  }
+
+  if (self->last_visible_node)
+    gtk_snapshot_append_node (snapshot, self->last_visible_node);
+}
+
 static void
 adw_view_stack_snapshot (GtkWidget   *widget,
                          GtkSnapshot *snapshot)
@@ -1239,7 +1540,7 @@ adw_view_stack_snapshot (GtkWidget   *widget,
     gtk_snapshot_push_cross_fade (snapshot, t);
 
     if (self->last_visible_child)
-      gtk_widget_snapshot_child (widget, self->last_visible_child->widget, snapshot);
+      snapshot_last_visible_child (self, snapshot);
     gtk_snapshot_pop (snapshot);
 
     gtk_widget_snapshot_child (widget, self->visible_child->widget, snapshot);
@@ -1484,7 +1785,8 @@ adw_view_stack_dispose (GObject *object)
     g_object_notify_by_pspec (G_OBJECT (self->pages), pages_props[PAGES_PROP_N_ITEMS]);
   }
 
-  while ((child = gtk_widget_get_first_child (GTK_WIDGET (self))))
+  /* Remove from the end, so the remaining pages don't need to be renumbered */
+  while ((child = gtk_widget_get_last_child (GTK_WIDGET (self))))
     stack_remove (self, child, TRUE);
 
   G_OBJECT_CLASS (adw_view_stack_parent_class)->dispose (object);
@@ -1498,6 +1800,9 @@ adw_view_stack_finalize (GObject *object)
   g_clear_weak_pointer (&self->pages);
 
   g_ptr_array_free (self->children, TRUE);
+  g_clear_pointer (&self->last_visible_node, gsk_render_node_unref);
+  g_hash_table_unref (self->pages_by_name);
+  g_hash_table_unref (self->pages_by_widget);
 
   G_OBJECT_CLASS (adw_view_stack_parent_class)->finalize (object);
 }
@@ -1652,6 +1957,9 @@ adw_view_stack_init (AdwViewStack *self)
   self->homogeneous[GTK_ORIENTATION_HORIZONTAL] = TRUE;
   self->transition_duration = 200;
   self->children = g_ptr_array_new ();
+  self->pages_by_name = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                               g_free, (GDestroyNotify) g_ptr_array_unref);
+  self->pages_by_widget = g_hash_table_new (NULL, NULL);
 
   target = adw_callback_animation_target_new ((AdwAnimationTargetFunc) transition_cb,
                                               self, NULL);
@@ -1769,32 +2077,32 @@ adw_view_stack_page_set_name (AdwViewStackPage *self,
                               const char       *name)
 {
   AdwViewStack *stack = NULL;
+  AdwViewStackPage *other_page;
 
   g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (self));
 
   if (self->widget &&
       gtk_widget_get_parent (self->widget) &&
-      ADW_IS_VIEW_STACK (gtk_widget_get_parent (self->widget)) &&
-      name) {
-    guint i;
-
+      ADW_IS_VIEW_STACK (gtk_widget_get_parent (self->widget))) {
     stack = ADW_VIEW_STACK (gtk_widget_get_parent (self->widget));
 
-    for (i = 0; i < stack->children->len; i++) {
-      AdwViewStackPage *p = g_ptr_array_index (stack->children, i);
-      if (self == p)
-        continue;
+    other_page = find_page_for_name (stack, name);
 
-      if (g_strcmp0 (p->name, name) == 0) {
-        g_warning ("Duplicate child name in AdwViewStack: %s", name);
-        break;
-      }
-    }
+    if (other_page && other_page != self)
+      g_warning ("Duplicate child name in AdwViewStack: %s", name);
   }
 
-  if (!g_set_str (&self->name, name))
+  if (g_strcmp0 (self->name, name) == 0)
     return;
 
+  if (stack)
+    unregister_page_name (stack, self);
+
+  g_set_str (&self->name, name);
+
+  if (stack)
+    register_page_name (stack, self);
+
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_NAME]);
 
   if (stack && stack->visible_child == self)
@@ -2135,6 +2443,128 @@ adw_view_stack_page_set_section_title (AdwViewStackPage *self,
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_SECTION_TITLE]);
 }
 
+/**
+ * adw_view_stack_page_get_unload_policy:
+ * @self: a view stack page
+ *
+ * Gets when the contents of @self are unloaded after it's hidden.
+ *
+ * Returns: the unload policy
+ *
+ * Since: 1.10
+ */
+AdwViewStackUnloadPolicy
+adw_view_stack_page_get_unload_policy (AdwViewStackPage *self)
+{
+  g_return_val_if_fail (ADW_IS_VIEW_STACK_PAGE (self), ADW_VIEW_STACK_UNLOAD_POLICY_KEEP);
+
+  return self->unload_policy;
+}
+
+/**
+ * adw_view_stack_page_set_unload_policy:
+ * @self: a view stack page
+ * @policy: the unload policy
+ *
+ * Sets when the contents of @self are unloaded after it's hidden.
+ *
+ * Only pages added with [method@ViewStack.add_lazy] can be unloaded, as
+ * their contents can be created again when they are shown. This does nothing
+ * for other pages.
+ *
+ * Since: 1.10
+ */
+void
+adw_view_stack_page_set_unload_policy (AdwViewStackPage         *self,
+                                       AdwViewStackUnloadPolicy  policy)
+{
+  g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (self));
+  g_return_if_fail (policy <= ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE);
+
+  if (self->unload_policy == policy)
+    return;
+
+  self->unload_policy = policy;
+
+  g_clear_handle_id (&self->unload_timeout_id, g_source_remove);
+  update_page_unload (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_UNLOAD_POLICY]);
+}
+
+/**
+ * adw_view_stack_page_get_unload_timeout:
+ * @self: a view stack page
+ *
+ * Gets the time in seconds after which @self is unloaded once hidden.
+ *
+ * Returns: the unload timeout
+ *
+ * Since: 1.10
+ */
+guint
+adw_view_stack_page_get_unload_timeout (AdwViewStackPage *self)
+{
+  g_return_val_if_fail (ADW_IS_VIEW_STACK_PAGE (self), 0);
+
+  return self->unload_timeout;
+}
+
+/**
+ * adw_view_stack_page_set_unload_timeout:
+ * @self: a view stack page
+ * @timeout: the unload timeout, in seconds
+ *
+ * Sets the time in seconds after which @self is unloaded once hidden.
+ *
+ * Does nothing unless [property@ViewStackPage:unload-policy] is set to
+ * `ADW_VIEW_STACK_UNLOAD_POLICY_TIMEOUT`.
+ *
+ * Since: 1.10
+ */
+void
+adw_view_stack_page_set_unload_timeout (AdwViewStackPage *self,
+                                        guint             timeout)
+{
+  g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (self));
+
+  if (self->unload_timeout == timeout)
+    return;
+
+  self->unload_timeout = timeout;
+
+  /* Restart the timeout if it's already running */
+  if (self->unload_timeout_id) {
+    g_clear_handle_id (&self->unload_timeout_id, g_source_remove);
+    update_page_unload (self);
+  }
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_UNLOAD_TIMEOUT]);
+}
+
+/**
+ * adw_view_stack_page_get_loaded:
+ * @self: a view stack page
+ *
+ * Gets whether the contents of @self are currently loaded.
+ *
+ * This is always `TRUE` for pages not added with [method@ViewStack.add_lazy].
+ *
+ * Returns: whether the contents of @self are loaded
+ *
+ * Since: 1.10
+ */
+gboolean
+adw_view_stack_page_get_loaded (AdwViewStackPage *self)
+{
+  g_return_val_if_fail (ADW_IS_VIEW_STACK_PAGE (self), FALSE);
+
+  if (!self->load_func || !self->widget)
+    return TRUE;
+
+  return adw_bin_get_child (ADW_BIN (self->widget)) != NULL;
+}
+
 /**
  * adw_view_stack_new:
  *
@@ -2250,6 +2680,137 @@ adw_view_stack_add_titled_with_icon (AdwViewStack *self,
   return add_internal (self, child, name, title, icon_name);
 }
 
+/**
+ * adw_view_stack_add_lazy:
+ * @self: a view stack
+ * @name: (nullable): the name for the page
+ * @load_func: (scope notified) (closure user_data) (destroy user_data_destroy): the
+ *   function creating the contents of the page
+ * @user_data: user data for @load_func
+ * @user_data_destroy: (nullable): destroy notify for @user_data
+ *
+ * Adds a page to @self whose contents are created on demand.
+ *
+ * @load_func is called to create the contents of the page when it's shown for
+ * the first time. Depending on [property@ViewStackPage:unload-policy], the
+ * contents may be destroyed once the page is hidden, in which case @load_func
+ * will be called again the next time the page is shown. Any state that needs
+ * to survive that, such as scroll positions or entered text, must be stored
+ * elsewhere.
+ *
+ * The page is identified by the @name. Its [property@ViewStackPage:child] is an
+ * [class@Bin] created by @self, containing the page contents while they are
+ * loaded, and can be used with the functions taking a child widget, such as
+ * [method@ViewStack.set_visible_child].
+ *
+ * Since the contents of unloaded pages don't exist, they are not taken into
+ * account by [property@ViewStack:hhomogeneous] and
+ * [property@ViewStack:vhomogeneous].
+ *
+ * Returns: (transfer none): the `AdwViewStackPage` for the new page
+ *
+ * Since: 1.10
+ */
+AdwViewStackPage *
+adw_view_stack_add_lazy (AdwViewStack             *self,
+                         const char               *name,
+                         AdwViewStackPageLoadFunc  load_func,
+                         gpointer                  user_data,
+                         GDestroyNotify            user_data_destroy)
+{
+  AdwViewStackPage *page;
+
+  g_return_val_if_fail (ADW_IS_VIEW_STACK (self), NULL);
+  g_return_val_if_fail (load_func != NULL, NULL);
+
+  page = g_object_new (ADW_TYPE_VIEW_STACK_PAGE, NULL);
+  page->widget = g_object_ref_sink (adw_bin_new ());
+  page->name = g_strdup (name);
+  page->load_func = load_func;
+  page->load_func_data = user_data;
+  page->load_func_data_destroy = user_data_destroy;
+
+  gtk_accessible_set_accessible_parent (GTK_ACCESSIBLE (page->widget),
+                                        GTK_ACCESSIBLE (page), NULL);
+
+  add_page (self, page);
+
+  g_object_unref (page);
+
+  return page;
+}
+
+/**
+ * adw_view_stack_add_pages:
+ * @self: a view stack
+ * @pages: (array length=n_pages): the pages to add
+ * @n_pages: the number of pages
+ *
+ * Adds multiple pages to @self at once.
+ *
+ * The pages must have a [property@ViewStackPage:child] without a parent, and
+ * can be created with `g_object_new()`, for example:
+ *
+ * ```c
+ * AdwViewStackPage *pages[N_PAGES];
+ *
+ * for (i = 0; i < N_PAGES; i++) {
+ *   pages[i] = g_object_new (ADW_TYPE_VIEW_STACK_PAGE,
+ *                            "child", children[i],
+ *                            "name", names[i],
+ *                            "title", titles[i],
+ *                            NULL);
+ * }
+ *
+ * adw_view_stack_add_pages (stack, pages, N_PAGES);
+ *
+ * // The stack holds its own references to the pages
+ * for (i = 0; i < N_PAGES; i++)
+ *   g_object_unref (pages[i]);
+ * ```
+ *
+ * Unlike adding the pages one by one, this emits
+ * [signal@Gio.ListModel::items-changed] on [property@ViewStack:pages] only
+ * once, so widgets like [class@ViewSwitcher] update once for all pages.
+ *
+ * Since: 1.10
+ */
+void
+adw_view_stack_add_pages (AdwViewStack      *self,
+                          AdwViewStackPage **pages,
+                          guint              n_pages)
+{
+  guint position, i;
+
+  g_return_if_fail (ADW_IS_VIEW_STACK (self));
+  g_return_if_fail (pages != NULL || n_pages == 0);
+
+  for (i = 0; i < n_pages; i++) {
+    g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (pages[i]));
+    g_return_if_fail (GTK_IS_WIDGET (pages[i]->widget));
+    g_return_if_fail (gtk_widget_get_parent (pages[i]->widget) == NULL);
+  }
+
+  if (n_pages == 0)
+    return;
+
+  position = self->children->len;
+
+  for (i = 0; i < n_pages; i++)
+    insert_page (self, pages[i]);
+
+  if (self->pages) {
+    g_list_model_items_changed (G_LIST_MODEL (self->pages), position, 0, n_pages);
+    g_object_notify_by_pspec (G_OBJECT (self->pages), pages_props[PAGES_PROP_N_ITEMS]);
+  }
+
+  /* Picks the first visible page if there's no visible child yet */
+  if (self->visible_child == NULL)
+    set_visible_child (self, NULL);
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+}
+
 /**
  * adw_view_stack_remove:
  * @self: a view stack
@@ -2261,18 +2822,15 @@ void
 adw_view_stack_remove (AdwViewStack  *self,
                        GtkWidget     *child)
 {
+  AdwViewStackPage *page;
   guint position;
 
   g_return_if_fail (ADW_IS_VIEW_STACK (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
   g_return_if_fail (gtk_widget_get_parent (child) == GTK_WIDGET (self));
 
-  for (position = 0; position < self->children->len; position++) {
-    AdwViewStackPage *page = g_ptr_array_index (self->children, position);
-
-    if (page->widget == child)
-      break;
-  }
+  page = find_page_for_widget (self, child);
+  position = page->position;
 
   stack_remove (self, child, FALSE);
 
@@ -19,9 +19,16 @@
 #include "adw-version.h"
 
 #include <gtk/gtk.h>
+#include "adw-enums.h"
 
 G_BEGIN_DECLS
 
+typedef enum {
+  ADW_VIEW_STACK_UNLOAD_POLICY_KEEP,
+  ADW_VIEW_STACK_UNLOAD_POLICY_TIMEOUT,
+  ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE,
+} AdwViewStackUnloadPolicy;
+
 #define ADW_TYPE_VIEW_STACK_PAGE (adw_view_stack_page_get_type())
 
 ADW_AVAILABLE_IN_ALL
@@ -84,6 +91,24 @@ ADW_AVAILABLE_IN_1_9
 void        adw_view_stack_page_set_section_title (AdwViewStackPage *self,
                                                    const char       *section_title);
 
+ADW_AVAILABLE_IN_1_10
+AdwViewStackUnloadPolicy adw_view_stack_page_get_unload_policy (AdwViewStackPage         *self);
+ADW_AVAILABLE_IN_1_10
+void                     adw_view_stack_page_set_unload_policy (AdwViewStackPage         *self,
+                                                                AdwViewStackUnloadPolicy  policy);
+
+ADW_AVAILABLE_IN_1_10
+guint adw_view_stack_page_get_unload_timeout (AdwViewStackPage *self);
+ADW_AVAILABLE_IN_1_10
+void  adw_view_stack_page_set_unload_timeout (AdwViewStackPage *self,
+                                              guint             timeout);
+
+ADW_AVAILABLE_IN_1_10
+gboolean adw_view_stack_page_get_loaded (AdwViewStackPage *self);
+
+typedef GtkWidget *(*AdwViewStackPageLoadFunc) (AdwViewStackPage *page,
+                                                gpointer          user_data);
+
 #define ADW_TYPE_VIEW_STACK (adw_view_stack_get_type())
 
 ADW_AVAILABLE_IN_ALL
@@ -111,6 +136,18 @@ AdwViewStackPage *adw_view_stack_add_titled_with_icon (AdwViewStack *self,
                                                        const char   *title,
                                                        const char   *icon_name);
 
+ADW_AVAILABLE_IN_1_10
+AdwViewStackPage *adw_view_stack_add_lazy (AdwViewStack             *self,
+                                           const char               *name,
+                                           AdwViewStackPageLoadFunc  load_func,
+                                           gpointer                  user_data,
+                                           GDestroyNotify            user_data_destroy);
+
+ADW_AVAILABLE_IN_1_10
+void adw_view_stack_add_pages (AdwViewStack      *self,
+                               AdwViewStackPage **pages,
+                               guint              n_pages);
+
 ADW_AVAILABLE_IN_ALL
 void adw_view_stack_remove (AdwViewStack *self,
                             GtkWidget    *child);
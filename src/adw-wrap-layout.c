@@ -9,7 +9,9 @@
 
 #include "config.h"
 
+#include "adw-alloc-counters-private.h"
 #include "adw-enums.h"
+#include "adw-layout-profiler-private.h"
 #include "adw-wrap-layout.h"
 
 #include <math.h>
@@ -288,6 +290,8 @@ box_allocate (AllocationData *child_data,
 
   g_assert (for_size >= 0);
 
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 1);
+
   for (i = 0; i < n_children; i++) {
     if (child_data[i].expand)
       n_expand++;
@@ -434,6 +438,7 @@ compute_sizes (AdwWrapLayout   *self,
   }
 
   child_data = g_new0 (AllocationData, n_visible_children);
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 1);
 
   for (child = gtk_widget_get_first_child (widget);
        child != NULL;
@@ -453,6 +458,7 @@ compute_sizes (AdwWrapLayout   *self,
 
   *n_lines = count_lines (self, for_size, child_spacing, child_data, n_visible_children);
   line_data = g_new0 (AllocationData, *n_lines);
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 1);
   line_start = child_data;
 
   for (i = 0; i < *n_lines; i++) {
@@ -516,6 +522,7 @@ adw_wrap_layout_measure (GtkLayoutManager *manager,
   gboolean multiple_visible_children = FALSE;
   int min = 0, nat = 0, line_spacing, child_spacing, natural_line_length = -1;
   GtkSettings *settings = gtk_widget_get_settings (widget);
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   /* Handle the trivial cases. */
   for (child = gtk_widget_get_first_child (widget);
@@ -547,6 +554,8 @@ adw_wrap_layout_measure (GtkLayoutManager *manager,
       if (natural_baseline)
         *natural_baseline = -1;
     }
+
+    ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
     return;
   }
 
@@ -638,6 +647,8 @@ adw_wrap_layout_measure (GtkLayoutManager *manager,
     *minimum_baseline = -1;
   if (natural_baseline)
     *natural_baseline = -1;
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_MEASURE);
 }
 
 static int
@@ -794,6 +805,7 @@ adw_wrap_layout_allocate (GtkLayoutManager *manager,
   int n_lines;
   gboolean reverse = self->wrap_reverse != (!horiz && is_rtl);
   int line_spacing, child_spacing;
+  ADW_LAYOUT_PROFILER_BEGIN ();
 
   line_spacing = adw_length_unit_to_px (self->line_spacing_unit,
                                         self->line_spacing,
@@ -832,6 +844,8 @@ adw_wrap_layout_allocate (GtkLayoutManager *manager,
 
   g_free (child_data);
   g_free (line_data);
+
+  ADW_LAYOUT_PROFILER_END (widget, ADW_LAYOUT_PASS_ALLOCATE);
 }
 
 static GtkSizeRequestMode
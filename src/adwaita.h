@@ -32,6 +32,7 @@ G_BEGIN_DECLS
 #include "adw-application.h"
 #include "adw-application-window.h"
 #include "adw-avatar.h"
+#include "adw-avatar-paintable.h"
 #include "adw-banner.h"
 #include "adw-bin.h"
 #include "adw-bottom-sheet.h"
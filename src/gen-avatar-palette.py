@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+import re
+import sys
+
+def main(argv):
+    with open(argv[1], 'r', encoding='utf-8') as file:
+        scss = file.read()
+
+    # Extract the gradient colors from the $avatarcolorlist in _avatar.scss
+    match = re.search(r'\$avatarcolorlist: *\((.*?)\n *\);', scss, re.DOTALL)
+    if not match:
+        sys.exit('%s: $avatarcolorlist not found' % argv[1])
+
+    colors = re.findall(r'\( *#([0-9a-fA-F]{6}), *#([0-9a-fA-F]{6}), *#([0-9a-fA-F]{6}) *\), *// *(\w+)',
+                        match.group(1))
+    if not colors:
+        sys.exit('%s: $avatarcolorlist is empty' % argv[1])
+
+    print('/* This file was generated by gen-avatar-palette.py, do not edit it. */\n')
+    print('#pragma once\n')
+    print('#include <glib.h>\n')
+    print('/* Top and bottom colors of the avatar gradients, see _avatar.scss */')
+    print('static const guint32 adw_avatar_palette[][2] = {')
+
+    for _, top, bottom, name in colors:
+        print('  { 0x%s, 0x%s }, /* %s */' % (top.lower(), bottom.lower(), name))
+
+    print('};')
+
+main(sys.argv)
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#include <string.h>
+#ifdef G_OS_UNIX
+#include <unistd.h>
+#endif
+
+static int n_avatars = 1000;
+static int image_size = 512;
+static int avatar_size = 32;
+
+static GOptionEntry entries[] = {
+  { "n-avatars", 'n', 0, G_OPTION_ARG_INT, &n_avatars, "Number of avatars", "N" },
+  { "image-size", 'i', 0, G_OPTION_ARG_INT, &image_size, "Size of the custom images", "SIZE" },
+  { "avatar-size", 's', 0, G_OPTION_ARG_INT, &avatar_size, "Size of the avatars", "SIZE" },
+  { NULL }
+};
+
+/* Only available on Linux, 0 elsewhere */
+static gsize
+get_rss (void)
+{
+  gsize rss = 0;
+#ifdef G_OS_UNIX
+  char *contents = NULL;
+
+  if (g_file_get_contents ("/proc/self/statm", &contents, NULL, NULL)) {
+    char **fields = g_strsplit (contents, " ", -1);
+
+    if (g_strv_length (fields) > 1)
+      rss = g_ascii_strtoull (fields[1], NULL, 10) * sysconf (_SC_PAGESIZE);
+
+    g_strfreev (fields);
+  }
+
+  g_free (contents);
+#endif
+
+  return rss;
+}
+
+static GdkTexture *
+create_texture (int   size,
+                guint fill)
+{
+  gsize stride = size * 4;
+  guchar *data = g_malloc (stride * size);
+  GBytes *bytes;
+  GdkTexture *texture;
+
+  /* Make sure the pages are actually committed */
+  memset (data, fill & 0xff, stride * size);
+
+  bytes = g_bytes_new_take (data, stride * size);
+  texture = gdk_memory_texture_new (size, size, GDK_MEMORY_DEFAULT, bytes, stride);
+
+  g_bytes_unref (bytes);
+
+  return texture;
+}
+
+static void
+texture_finalized_cb (int     *pending,
+                      GObject *texture)
+{
+  (*pending)--;
+}
+
+static gsize
+count_texture_bytes (GPtrArray *avatars)
+{
+  gsize total = 0;
+  guint i;
+
+  for (i = 0; i < avatars->len; i++) {
+    AdwAvatar *avatar = g_ptr_array_index (avatars, i);
+    GdkPaintable *image = adw_avatar_get_custom_image (avatar);
+    int size;
+
+    if (GDK_IS_TEXTURE (image)) {
+      total += (gsize) gdk_texture_get_width (GDK_TEXTURE (image)) *
+               (gsize) gdk_texture_get_height (GDK_TEXTURE (image)) * 4;
+      continue;
+    }
+
+    /* The original is gone, only the downscaled copy is left */
+    size = avatar_size * gtk_widget_get_scale_factor (GTK_WIDGET (avatar));
+    total += (gsize) size * (gsize) size * 4;
+  }
+
+  return total;
+}
+
+static void
+run (gboolean downscale)
+{
+  GPtrArray *avatars = g_ptr_array_new_with_free_func (g_object_unref);
+  gsize rss_before = get_rss ();
+  gint64 start = g_get_monotonic_time ();
+  gsize rss_after;
+  int pending = 0;
+  int i;
+
+  for (i = 0; i < n_avatars; i++) {
+    AdwAvatar *avatar = g_object_ref_sink (ADW_AVATAR (adw_avatar_new (avatar_size, NULL, TRUE)));
+    GdkTexture *texture = create_texture (image_size, i);
+
+    adw_avatar_set_downscale_custom_image (avatar, downscale);
+    adw_avatar_set_custom_image (avatar, GDK_PAINTABLE (texture));
+
+    /* The avatars drop the originals once they're downscaled */
+    if (downscale) {
+      pending++;
+      g_object_weak_ref (G_OBJECT (texture), (GWeakNotify) texture_finalized_cb, &pending);
+    }
+
+    g_object_unref (texture);
+    g_ptr_array_add (avatars, avatar);
+  }
+
+  while (pending > 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  rss_after = get_rss ();
+
+  g_print ("%-10s %d avatars, %d px images at %d px: %" G_GSIZE_FORMAT " KiB in textures, "
+           "%" G_GSSIZE_FORMAT " KiB RSS growth, %.1f ms\n",
+           downscale ? "downscale" : "original",
+           n_avatars, image_size, avatar_size,
+           count_texture_bytes (avatars) / 1024,
+           ((gssize) rss_after - (gssize) rss_before) / 1024,
+           (g_get_monotonic_time () - start) / 1000.0);
+
+  g_ptr_array_unref (avatars);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+
+  context = g_option_context_new (NULL);
+  g_option_context_set_summary (context, "Measure memory used by avatars with custom images");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    g_option_context_free (context);
+
+    return 1;
+  }
+
+  g_option_context_free (context);
+
+  if (n_avatars <= 0 || image_size <= 0 || avatar_size <= 0) {
+    g_printerr ("Sizes and counts must be positive\n");
+
+    return 1;
+  }
+
+  adw_init ();
+
+  /* Downscaled run goes first, so that it doesn't reuse memory freed by the
+   * other run and the RSS growth is comparable */
+  run (TRUE);
+  run (FALSE);
+
+  return 0;
+}
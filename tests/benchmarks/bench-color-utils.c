@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#include "adw-color-utils-private.h"
+
+#include <math.h>
+
+static int n_colors = 1 << 20;
+static int n_runs = 5;
+
+static GOptionEntry entries[] = {
+  { "n-colors", 'n', 0, G_OPTION_ARG_INT, &n_colors, "Number of colors", "N" },
+  { "n-runs", 'r', 0, G_OPTION_ARG_INT, &n_runs, "Number of runs", "N" },
+  { NULL }
+};
+
+static void
+rgb_to_oklab_scalar (const float *rgb,
+                     float       *lab,
+                     gsize        n)
+{
+  gsize i;
+
+  for (i = 0; i < n; i++)
+    adw_rgb_to_oklab (rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2],
+                      &lab[i * 3], &lab[i * 3 + 1], &lab[i * 3 + 2]);
+}
+
+static void
+oklab_to_rgb_scalar (const float *lab,
+                     float       *rgb,
+                     gsize        n)
+{
+  gsize i;
+
+  for (i = 0; i < n; i++)
+    adw_oklab_to_rgb (lab[i * 3], lab[i * 3 + 1], lab[i * 3 + 2],
+                      &rgb[i * 3], &rgb[i * 3 + 1], &rgb[i * 3 + 2]);
+}
+
+static void
+rgb_to_oklch_scalar (const float *rgb,
+                     float       *lch,
+                     gsize        n)
+{
+  gsize i;
+
+  for (i = 0; i < n; i++)
+    adw_rgb_to_oklch (rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2],
+                      &lch[i * 3], &lch[i * 3 + 1], &lch[i * 3 + 2]);
+}
+
+static void
+oklch_to_rgb_scalar (const float *lch,
+                     float       *rgb,
+                     gsize        n)
+{
+  gsize i;
+
+  for (i = 0; i < n; i++)
+    adw_oklch_to_rgb (lch[i * 3], lch[i * 3 + 1], lch[i * 3 + 2],
+                      &rgb[i * 3], &rgb[i * 3 + 1], &rgb[i * 3 + 2]);
+}
+
+typedef void (* ConvertFunc) (const float *input,
+                              float       *output,
+                              gsize        n);
+
+/* Returns the best time out of all runs, in milliseconds */
+static double
+measure (ConvertFunc  func,
+         const float *input,
+         float       *output)
+{
+  double best = G_MAXDOUBLE;
+  int i;
+
+  for (i = 0; i < n_runs; i++) {
+    gint64 start = g_get_monotonic_time ();
+
+    func (input, output, n_colors);
+
+    best = MIN (best, (g_get_monotonic_time () - start) / 1000.0);
+  }
+
+  return best;
+}
+
+static void
+compare (const char  *name,
+         ConvertFunc  scalar_func,
+         ConvertFunc  batch_func,
+         const float *input,
+         gboolean     output_is_lch)
+{
+  float *scalar_output = g_new (float, n_colors * 3);
+  float *batch_output = g_new (float, n_colors * 3);
+  double scalar_time = measure (scalar_func, input, scalar_output);
+  double batch_time = measure (batch_func, input, batch_output);
+  float max_error = 0;
+  int i;
+
+  for (i = 0; i < n_colors * 3; i++) {
+    float error = fabsf (scalar_output[i] - batch_output[i]);
+
+    /* Hue wraps around, and is meaningless for grays */
+    if (output_is_lch && i % 3 == 2) {
+      if (scalar_output[i - 1] < 0.01)
+        continue;
+
+      error = MIN (error, 360 - error);
+    }
+
+    max_error = MAX (max_error, error);
+  }
+
+  g_print ("%-14s scalar %8.2f ms, batch %8.2f ms, %5.2fx, max error %g\n",
+           name, scalar_time, batch_time, scalar_time / batch_time, max_error);
+
+  g_free (scalar_output);
+  g_free (batch_output);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  float *rgb, *lab, *lch;
+  GRand *rand;
+  int i;
+
+  context = g_option_context_new (NULL);
+  g_option_context_set_summary (context, "Compare scalar and batch OKLab and OKLCH conversions");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    g_option_context_free (context);
+
+    return 1;
+  }
+
+  g_option_context_free (context);
+
+  if (n_colors <= 0 || n_runs <= 0) {
+    g_printerr ("Counts must be positive\n");
+
+    return 1;
+  }
+
+  rgb = g_new (float, n_colors * 3);
+  lab = g_new (float, n_colors * 3);
+  lch = g_new (float, n_colors * 3);
+
+  /* Fixed seed, so that runs are comparable */
+  rand = g_rand_new_with_seed (42);
+
+  for (i = 0; i < n_colors * 3; i++)
+    rgb[i] = g_rand_double (rand);
+
+  g_rand_free (rand);
+
+  rgb_to_oklab_scalar (rgb, lab, n_colors);
+  rgb_to_oklch_scalar (rgb, lch, n_colors);
+
+  compare ("rgb → oklab", rgb_to_oklab_scalar, adw_rgb_to_oklab_n, rgb, FALSE);
+  compare ("oklab → rgb", oklab_to_rgb_scalar, adw_oklab_to_rgb_n, lab, FALSE);
+  compare ("rgb → oklch", rgb_to_oklch_scalar, adw_rgb_to_oklch_n, rgb, TRUE);
+  compare ("oklch → rgb", oklch_to_rgb_scalar, adw_oklch_to_rgb_n, lch, FALSE);
+
+  g_free (rgb);
+  g_free (lab);
+  g_free (lch);
+
+  return 0;
+}
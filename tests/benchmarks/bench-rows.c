@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+static int n_rows = 5000;
+static char *row_type = NULL;
+
+static GOptionEntry entries[] = {
+  { "n-rows", 'n', 0, G_OPTION_ARG_INT, &n_rows, "Number of rows", "N" },
+  { "type", 't', 0, G_OPTION_ARG_STRING, &row_type, "Only create rows of this type", "TYPE" },
+  { NULL }
+};
+
+/* The contents of AdwActionRow as they used to be created from its template,
+ * used as a reference for the cost of going through GtkBuilder */
+static const char builder_row_ui[] =
+  "<interface>"
+  "  <object class='GtkBox' id='header'>"
+  "    <property name='valign'>center</property>"
+  "    <property name='hexpand'>False</property>"
+  "    <style><class name='header'/></style>"
+  "    <child>"
+  "      <object class='GtkBox'>"
+  "        <property name='visible'>False</property>"
+  "        <style><class name='prefixes'/></style>"
+  "      </object>"
+  "    </child>"
+  "    <child>"
+  "      <object class='GtkImage'>"
+  "        <property name='visible'>False</property>"
+  "        <property name='valign'>center</property>"
+  "        <property name='accessible-role'>presentation</property>"
+  "        <style><class name='icon'/></style>"
+  "      </object>"
+  "    </child>"
+  "    <child>"
+  "      <object class='GtkBox'>"
+  "        <property name='orientation'>vertical</property>"
+  "        <property name='valign'>center</property>"
+  "        <property name='hexpand'>True</property>"
+  "        <style><class name='title'/></style>"
+  "        <child>"
+  "          <object class='GtkLabel'>"
+  "            <property name='label'>Title</property>"
+  "            <property name='lines'>0</property>"
+  "            <property name='wrap'>True</property>"
+  "            <property name='wrap-mode'>word-char</property>"
+  "            <property name='xalign'>0</property>"
+  "            <style><class name='title'/></style>"
+  "          </object>"
+  "        </child>"
+  "        <child>"
+  "          <object class='GtkLabel'>"
+  "            <property name='visible'>False</property>"
+  "            <property name='lines'>0</property>"
+  "            <property name='wrap'>True</property>"
+  "            <property name='wrap-mode'>word-char</property>"
+  "            <property name='xalign'>0</property>"
+  "            <style><class name='subtitle'/></style>"
+  "          </object>"
+  "        </child>"
+  "      </object>"
+  "    </child>"
+  "    <child>"
+  "      <object class='GtkBox'>"
+  "        <property name='visible'>False</property>"
+  "        <style><class name='suffixes'/></style>"
+  "      </object>"
+  "    </child>"
+  "  </object>"
+  "</interface>";
+
+static GtkWidget *
+create_builder_row (void)
+{
+  GtkBuilder *builder = gtk_builder_new_from_string (builder_row_ui, -1);
+  GtkWidget *row = gtk_list_box_row_new ();
+
+  gtk_list_box_row_set_child (GTK_LIST_BOX_ROW (row),
+                              GTK_WIDGET (gtk_builder_get_object (builder, "header")));
+
+  g_object_unref (builder);
+
+  return row;
+}
+
+static GtkWidget *
+create_combo_row (void)
+{
+  const char * const strings[] = { "First", "Second", "Third", NULL };
+  GtkWidget *row = adw_combo_row_new ();
+  GtkStringList *model = gtk_string_list_new (strings);
+
+  adw_combo_row_set_model (ADW_COMBO_ROW (row), G_LIST_MODEL (model));
+
+  g_object_unref (model);
+
+  return row;
+}
+
+static GtkWidget *
+create_spin_row (void)
+{
+  return adw_spin_row_new_with_range (0, 100, 1);
+}
+
+typedef struct {
+  const char *name;
+  GtkWidget *(* create) (void);
+} RowType;
+
+static RowType row_types[] = {
+  { "builder", create_builder_row },
+  { "action", adw_action_row_new },
+  { "entry", adw_entry_row_new },
+  { "spin", create_spin_row },
+  { "combo", create_combo_row },
+  { "switch", adw_switch_row_new },
+  { "expander", adw_expander_row_new },
+};
+
+/* Only available with glibc, 0 elsewhere */
+static gsize
+get_heap_size (void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2 ();
+
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+static void
+run (RowType *type)
+{
+  GtkWidget **rows = g_new (GtkWidget *, n_rows);
+  gsize heap_before = get_heap_size ();
+  gint64 start = g_get_monotonic_time ();
+  gint64 create_time;
+  gsize heap_after;
+  int i;
+
+  for (i = 0; i < n_rows; i++) {
+    rows[i] = g_object_ref_sink (type->create ());
+
+    if (ADW_IS_PREFERENCES_ROW (rows[i]))
+      adw_preferences_row_set_title (ADW_PREFERENCES_ROW (rows[i]), "Title");
+  }
+
+  create_time = g_get_monotonic_time () - start;
+  heap_after = get_heap_size ();
+
+  for (i = 0; i < n_rows; i++)
+    g_object_unref (rows[i]);
+
+  g_free (rows);
+
+  g_print ("%-10s %d rows: %.1f ms (%.2f µs per row), "
+           "%" G_GSSIZE_FORMAT " KiB heap growth (%.2f KiB per row), "
+           "%.1f ms to free\n",
+           type->name, n_rows,
+           create_time / 1000.0,
+           (double) create_time / n_rows,
+           ((gssize) heap_after - (gssize) heap_before) / 1024,
+           ((gssize) heap_after - (gssize) heap_before) / 1024.0 / n_rows,
+           (g_get_monotonic_time () - start - create_time) / 1000.0);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  gboolean found = FALSE;
+  guint i;
+
+  context = g_option_context_new (NULL);
+  g_option_context_set_summary (context,
+                                "Measure the time and memory it takes to create rows.\n\n"
+                                "Row types: builder, action, entry, spin, combo, switch, expander.\n"
+                                "builder creates the contents of an action row with GtkBuilder for\n"
+                                "comparison.");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    g_option_context_free (context);
+
+    return 1;
+  }
+
+  g_option_context_free (context);
+
+  if (n_rows <= 0) {
+    g_printerr ("The number of rows must be positive\n");
+
+    return 1;
+  }
+
+  adw_init ();
+
+  /* Warm up type registration, style and icon lookups */
+  for (i = 0; i < G_N_ELEMENTS (row_types); i++)
+    g_object_unref (g_object_ref_sink (row_types[i].create ()));
+
+  for (i = 0; i < G_N_ELEMENTS (row_types); i++) {
+    if (row_type && g_strcmp0 (row_type, row_types[i].name))
+      continue;
+
+    run (&row_types[i]);
+    found = TRUE;
+  }
+
+  if (!found) {
+    g_printerr ("Unknown row type: %s\n", row_type);
+
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#define RESOURCE_PATH "/org/gnome/Adwaita1/BenchStyleToggle"
+
+static int n_widgets = 5000;
+static int n_runs = 20;
+static gboolean legacy = FALSE;
+
+static GOptionEntry entries[] = {
+  { "n-widgets", 'n', 0, G_OPTION_ARG_INT, &n_widgets, "Number of widgets in the window", "N" },
+  { "n-runs", 'r', 0, G_OPTION_ARG_INT, &n_runs, "Number of toggles", "N" },
+  { "legacy", 'l', 0, G_OPTION_ARG_NONE, &legacy, "Use the deprecated style-dark.css and style-hc.css", NULL },
+  { NULL }
+};
+
+typedef struct {
+  GtkWidget *window;
+  GdkFrameClock *frame_clock;
+  gulong after_paint_id;
+  gint64 start_time;
+  double *times;
+  int run;
+} BenchData;
+
+static void toggle (BenchData *data);
+
+static int
+compare_times (gconstpointer a,
+               gconstpointer b)
+{
+  double time_a = *(double *) a;
+  double time_b = *(double *) b;
+
+  return (time_a > time_b) - (time_a < time_b);
+}
+
+static void
+finish (BenchData *data)
+{
+  double total = 0;
+  int i;
+
+  g_signal_handler_disconnect (data->frame_clock, data->after_paint_id);
+
+  for (i = 0; i < n_runs; i++)
+    total += data->times[i];
+
+  qsort (data->times, n_runs, sizeof (double), compare_times);
+
+  g_print ("%d widgets%s, %d toggles: "
+           "%.2f ms mean, %.2f ms median, %.2f ms best, %.2f ms worst\n",
+           n_widgets, legacy ? " (legacy stylesheets)" : "", n_runs,
+           total / n_runs,
+           data->times[n_runs / 2],
+           data->times[0],
+           data->times[n_runs - 1]);
+
+  gtk_window_destroy (GTK_WINDOW (data->window));
+}
+
+static void
+after_paint_cb (BenchData *data)
+{
+  if (data->start_time == 0)
+    return;
+
+  data->times[data->run++] = (g_get_monotonic_time () - data->start_time) / 1000.0;
+  data->start_time = 0;
+
+  if (data->run == n_runs)
+    g_idle_add_once ((GSourceOnceFunc) finish, data);
+  else
+    g_idle_add_once ((GSourceOnceFunc) toggle, data);
+}
+
+/* Measures the time from changing the color scheme until the next frame has
+ * been painted, which includes restyling every widget in the window */
+static void
+toggle (BenchData *data)
+{
+  AdwStyleManager *manager = adw_style_manager_get_default ();
+  AdwColorScheme color_scheme;
+
+  if (adw_style_manager_get_dark (manager))
+    color_scheme = ADW_COLOR_SCHEME_FORCE_LIGHT;
+  else
+    color_scheme = ADW_COLOR_SCHEME_FORCE_DARK;
+
+  data->start_time = g_get_monotonic_time ();
+
+  adw_style_manager_set_color_scheme (manager, color_scheme);
+}
+
+static void
+map_cb (BenchData *data)
+{
+  data->frame_clock = gtk_widget_get_frame_clock (data->window);
+  data->after_paint_id =
+    g_signal_connect_swapped (data->frame_clock, "after-paint",
+                              G_CALLBACK (after_paint_cb), data);
+
+  /* Let the first frame finish before starting */
+  g_timeout_add_once (500, (GSourceOnceFunc) toggle, data);
+}
+
+static void
+activate_cb (GtkApplication *app,
+             BenchData      *data)
+{
+  GtkWidget *scrolled_window, *box;
+  int i;
+
+  box = gtk_flow_box_new ();
+  gtk_flow_box_set_selection_mode (GTK_FLOW_BOX (box), GTK_SELECTION_NONE);
+  gtk_flow_box_set_max_children_per_line (GTK_FLOW_BOX (box), 50);
+
+  for (i = 0; i < n_widgets; i++) {
+    char *label = g_strdup_printf ("%d", i);
+    GtkWidget *widget;
+
+    if (i % 2)
+      widget = gtk_button_new_with_label (label);
+    else
+      widget = gtk_label_new (label);
+
+    gtk_widget_add_css_class (widget, "bench-item");
+    gtk_flow_box_append (GTK_FLOW_BOX (box), widget);
+
+    g_free (label);
+  }
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), box);
+
+  data->window = adw_application_window_new (app);
+  adw_application_window_set_content (ADW_APPLICATION_WINDOW (data->window),
+                                      scrolled_window);
+  gtk_window_set_default_size (GTK_WINDOW (data->window), 800, 600);
+
+  g_signal_connect_swapped (data->window, "map", G_CALLBACK (map_cb), data);
+
+  gtk_window_present (GTK_WINDOW (data->window));
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  AdwApplication *app;
+  BenchData data = { 0 };
+
+  context = g_option_context_new (NULL);
+  g_option_context_set_summary (context,
+                                "Measure the time it takes to switch between light and dark\n"
+                                "appearance in a window with many widgets and an application\n"
+                                "stylesheet.\n\n"
+                                "Unlike the other benchmarks, this one opens a window.");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    g_option_context_free (context);
+
+    return 1;
+  }
+
+  g_option_context_free (context);
+
+  if (n_widgets <= 0 || n_runs <= 0) {
+    g_printerr ("The number of widgets and runs must be positive\n");
+
+    return 1;
+  }
+
+  data.times = g_new0 (double, n_runs);
+
+  app = adw_application_new (NULL, G_APPLICATION_NON_UNIQUE);
+  g_application_set_resource_base_path (G_APPLICATION (app),
+                                        legacy ? RESOURCE_PATH "/legacy" : RESOURCE_PATH);
+
+  g_signal_connect (app, "activate", G_CALLBACK (activate_cb), &data);
+
+  g_application_run (G_APPLICATION (app), 0, NULL);
+
+  g_object_unref (app);
+  g_free (data.times);
+
+  return 0;
+}
@@ -0,0 +1,549 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <stdlib.h>
+
+#define WIDTH 800
+#define HEIGHT 600
+
+static int n_runs = 5;
+static double scale = 1;
+static char *scenario_name = NULL;
+static gboolean json = FALSE;
+
+static GOptionEntry entries[] = {
+  { "n-runs", 'r', 0, G_OPTION_ARG_INT, &n_runs, "Number of runs", "N" },
+  { "scale", 's', 0, G_OPTION_ARG_DOUBLE, &scale, "Multiply the number of items in each scenario", "FACTOR" },
+  { "scenario", 'n', 0, G_OPTION_ARG_STRING, &scenario_name, "Only run this scenario", "NAME" },
+  { "json", 'j', 0, G_OPTION_ARG_NONE, &json, "Print the results as JSON", NULL },
+  { NULL }
+};
+
+typedef struct {
+  const char *scenario;
+  int n_items;
+  const char *metric;
+  const char *unit;
+  double value;
+} Result;
+
+static GArray *results;
+
+static GtkWidget *window;
+
+/* Only available with glibc, 0 elsewhere */
+static gsize
+get_heap_size (void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2 ();
+
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+static int
+compare_doubles (gconstpointer a,
+                 gconstpointer b)
+{
+  double value_a = *(double *) a;
+  double value_b = *(double *) b;
+
+  return (value_a > value_b) - (value_a < value_b);
+}
+
+/* Records the median of @values */
+static void
+add_result (const char *scenario,
+            int         n_items,
+            const char *metric,
+            const char *unit,
+            double     *values,
+            int         n_values)
+{
+  Result result = { scenario, n_items, metric, unit, 0 };
+
+  qsort (values, n_values, sizeof (double), compare_doubles);
+
+  if (n_values % 2)
+    result.value = values[n_values / 2];
+  else
+    result.value = (values[n_values / 2 - 1] + values[n_values / 2]) / 2;
+
+  g_array_append_val (results, result);
+}
+
+static inline double
+ms_since (gint64 start)
+{
+  return (g_get_monotonic_time () - start) / 1000.0;
+}
+
+static void
+after_paint_cb (GdkFrameClock *frame_clock,
+                gboolean      *painted)
+{
+  *painted = TRUE;
+}
+
+/* Blocks until the window has gone through a full frame: styling, layout,
+ * snapshot and rendering */
+static void
+wait_for_frame (void)
+{
+  GdkFrameClock *frame_clock = gtk_widget_get_frame_clock (window);
+  gboolean painted = FALSE;
+  gulong id;
+
+  id = g_signal_connect (frame_clock, "after-paint",
+                         G_CALLBACK (after_paint_cb), &painted);
+
+  gtk_widget_queue_draw (window);
+
+  while (!painted)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_signal_handler_disconnect (frame_clock, id);
+}
+
+static void
+layout (GtkWidget *widget,
+        int        width)
+{
+  int min_height;
+
+  gtk_widget_measure (widget, GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, NULL, NULL, NULL);
+  gtk_widget_measure (widget, GTK_ORIENTATION_VERTICAL, width,
+                      &min_height, NULL, NULL, NULL);
+
+  gtk_widget_allocate (widget, width, MAX (min_height, HEIGHT), -1, NULL);
+}
+
+static void
+snapshot_widget (GtkWidget *widget)
+{
+  GtkSnapshot *snapshot = gtk_snapshot_new ();
+  GskRenderNode *node;
+
+  gtk_widget_snapshot_child (window, widget, snapshot);
+
+  node = gtk_snapshot_free_to_node (snapshot);
+
+  g_clear_pointer (&node, gsk_render_node_unref);
+}
+
+static GtkWidget *
+create_tab_view (int n_items)
+{
+  GtkWidget *box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  AdwTabView *view = adw_tab_view_new ();
+  AdwTabBar *bar = adw_tab_bar_new ();
+  int i;
+
+  adw_tab_bar_set_view (bar, view);
+
+  gtk_box_append (GTK_BOX (box), GTK_WIDGET (bar));
+  gtk_box_append (GTK_BOX (box), GTK_WIDGET (view));
+
+  for (i = 0; i < n_items; i++) {
+    char *title = g_strdup_printf ("Tab %d", i);
+    AdwTabPage *page = adw_tab_view_append (view, gtk_label_new (title));
+
+    adw_tab_page_set_title (page, title);
+
+    g_free (title);
+  }
+
+  return box;
+}
+
+static GtkWidget *
+create_preferences_page (int n_items)
+{
+  GtkWidget *page = adw_preferences_page_new ();
+  GtkWidget *group = NULL;
+  int i;
+
+  for (i = 0; i < n_items; i++) {
+    char *title = g_strdup_printf ("Row %d", i);
+    GtkWidget *row;
+
+    if (i % 100 == 0) {
+      group = adw_preferences_group_new ();
+      adw_preferences_page_add (ADW_PREFERENCES_PAGE (page),
+                                ADW_PREFERENCES_GROUP (group));
+    }
+
+    if (i % 2)
+      row = adw_switch_row_new ();
+    else
+      row = adw_action_row_new ();
+
+    adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), title);
+    adw_preferences_group_add (ADW_PREFERENCES_GROUP (group), row);
+
+    g_free (title);
+  }
+
+  return page;
+}
+
+static GtkWidget *
+create_wrap_box (int n_items)
+{
+  GtkWidget *scrolled_window = gtk_scrolled_window_new ();
+  GtkWidget *box = adw_wrap_box_new ();
+  int i;
+
+  adw_wrap_box_set_child_spacing (ADW_WRAP_BOX (box), 6);
+  adw_wrap_box_set_line_spacing (ADW_WRAP_BOX (box), 6);
+
+  for (i = 0; i < n_items; i++) {
+    char *label = g_strdup_printf ("Chip %d", i);
+    GtkWidget *chip = gtk_button_new_with_label (label);
+
+    gtk_widget_add_css_class (chip, "pill");
+    gtk_widget_add_css_class (chip, "small");
+    adw_wrap_box_append (ADW_WRAP_BOX (box), chip);
+
+    g_free (label);
+  }
+
+  gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (scrolled_window),
+                                  GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), box);
+
+  return scrolled_window;
+}
+
+typedef struct _Scenario Scenario;
+
+struct _Scenario {
+  const char *name;
+  int n_items;
+  GtkWidget *(* create) (int n_items);
+  void (* run) (Scenario *scenario,
+                int       n_items);
+};
+
+/* Measures creating the widgets, showing them for the first time, laying them
+ * out and snapshotting them again at a different width, and destroying them */
+static void
+run_widget_scenario (Scenario *scenario,
+                     int       n_items)
+{
+  double *create = g_new (double, n_runs);
+  double *heap = g_new (double, n_runs);
+  double *first_frame = g_new (double, n_runs);
+  double *relayout = g_new (double, n_runs);
+  double *snapshot_time = g_new (double, n_runs);
+  double *destroy = g_new (double, n_runs);
+  int i;
+
+  for (i = 0; i < n_runs; i++) {
+    GtkWidget *widget;
+    gsize heap_before = get_heap_size ();
+    gint64 start = g_get_monotonic_time ();
+
+    widget = scenario->create (n_items);
+
+    create[i] = ms_since (start);
+    heap[i] = ((gssize) get_heap_size () - (gssize) heap_before) / 1024.0;
+
+    start = g_get_monotonic_time ();
+    gtk_window_set_child (GTK_WINDOW (window), widget);
+    wait_for_frame ();
+    first_frame[i] = ms_since (start);
+
+    /* Change the width so that everything inside has to be allocated again */
+    start = g_get_monotonic_time ();
+    layout (widget, WIDTH - 1);
+    relayout[i] = ms_since (start);
+
+    start = g_get_monotonic_time ();
+    snapshot_widget (widget);
+    snapshot_time[i] = ms_since (start);
+
+    start = g_get_monotonic_time ();
+    gtk_window_set_child (GTK_WINDOW (window), NULL);
+    destroy[i] = ms_since (start);
+  }
+
+  add_result (scenario->name, n_items, "create", "ms", create, n_runs);
+  add_result (scenario->name, n_items, "heap-growth", "KiB", heap, n_runs);
+  add_result (scenario->name, n_items, "first-frame", "ms", first_frame, n_runs);
+  add_result (scenario->name, n_items, "relayout", "ms", relayout, n_runs);
+  add_result (scenario->name, n_items, "snapshot", "ms", snapshot_time, n_runs);
+  add_result (scenario->name, n_items, "destroy", "ms", destroy, n_runs);
+
+  g_free (create);
+  g_free (heap);
+  g_free (first_frame);
+  g_free (relayout);
+  g_free (snapshot_time);
+  g_free (destroy);
+}
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+static GtkWidget *
+create_breakpoint_bin (int n_items)
+{
+  GtkWidget *bin = adw_breakpoint_bin_new ();
+  GtkWidget *split_view = adw_overlay_split_view_new ();
+  GtkWidget *toolbar_view = adw_toolbar_view_new ();
+  GtkWidget *clamp = adw_clamp_new ();
+  GtkWidget *wrap_box = adw_wrap_box_new ();
+  AdwBreakpoint *breakpoint;
+  GValue value = G_VALUE_INIT;
+  int i;
+
+  gtk_widget_set_size_request (bin, 360, 200);
+
+  for (i = 0; i < n_items; i++) {
+    char *label = g_strdup_printf ("Chip %d", i);
+
+    adw_wrap_box_append (ADW_WRAP_BOX (wrap_box), gtk_button_new_with_label (label));
+
+    g_free (label);
+  }
+
+  adw_clamp_set_child (ADW_CLAMP (clamp), wrap_box);
+  adw_toolbar_view_add_top_bar (ADW_TOOLBAR_VIEW (toolbar_view), adw_header_bar_new ());
+  adw_toolbar_view_set_content (ADW_TOOLBAR_VIEW (toolbar_view), clamp);
+  adw_overlay_split_view_set_sidebar (ADW_OVERLAY_SPLIT_VIEW (split_view),
+                                      create_preferences_page (20));
+  adw_overlay_split_view_set_content (ADW_OVERLAY_SPLIT_VIEW (split_view), toolbar_view);
+  adw_breakpoint_bin_set_child (ADW_BREAKPOINT_BIN (bin), split_view);
+
+  g_value_init (&value, G_TYPE_BOOLEAN);
+  g_value_set_boolean (&value, TRUE);
+
+  breakpoint = adw_breakpoint_new (adw_breakpoint_condition_parse ("max-width: 800px"));
+  adw_breakpoint_add_setter (breakpoint, G_OBJECT (split_view), "collapsed", &value);
+  adw_breakpoint_bin_add_breakpoint (ADW_BREAKPOINT_BIN (bin), breakpoint);
+
+  breakpoint = adw_breakpoint_new (adw_breakpoint_condition_parse ("max-width: 500px"));
+  adw_breakpoint_add_setter (breakpoint, G_OBJECT (split_view), "collapsed", &value);
+  adw_breakpoint_add_setter (breakpoint, G_OBJECT (wrap_box), "justify-last-line", &value);
+  adw_breakpoint_bin_add_breakpoint (ADW_BREAKPOINT_BIN (bin), breakpoint);
+
+  g_value_unset (&value);
+
+  return bin;
+}
+
+/* Allocates a breakpoint bin at every width from 360 to 1440 px and back in
+ * 8 px steps, crossing both of its breakpoints on the way */
+static void
+run_breakpoint_resize (Scenario *scenario,
+                       int       n_items)
+{
+  double *per_allocation = g_new (double, n_runs);
+  GtkWidget *bin = create_breakpoint_bin (n_items);
+  int n_changes = 0;
+  int i;
+
+  g_signal_connect_swapped (bin, "notify::current-breakpoint",
+                            G_CALLBACK (increment), &n_changes);
+
+  gtk_window_set_child (GTK_WINDOW (window), bin);
+  wait_for_frame ();
+
+  for (i = 0; i < n_runs; i++) {
+    gint64 start = g_get_monotonic_time ();
+    int n_allocations = 0;
+    int width;
+
+    for (width = 360; width <= 1440; width += 8, n_allocations++)
+      layout (bin, width);
+
+    for (width = 1440; width >= 360; width -= 8, n_allocations++)
+      layout (bin, width);
+
+    per_allocation[i] = (g_get_monotonic_time () - start) / (double) n_allocations;
+  }
+
+  add_result (scenario->name, n_items, "resize", "us", per_allocation, n_runs);
+
+  if (!json)
+    g_print ("%s: %d breakpoint changes\n", scenario->name, n_changes);
+
+  gtk_window_set_child (GTK_WINDOW (window), NULL);
+
+  g_free (per_allocation);
+}
+
+/* Switches between light and dark appearance and waits for the next frame
+ * each time, with a preferences page in the window */
+static void
+run_style_switch (Scenario *scenario,
+                  int       n_items)
+{
+  AdwStyleManager *manager = adw_style_manager_get_default ();
+  AdwColorScheme old_color_scheme = adw_style_manager_get_color_scheme (manager);
+  double *switch_time = g_new (double, n_runs * 2);
+  int i;
+
+  gtk_window_set_child (GTK_WINDOW (window), create_preferences_page (n_items));
+  wait_for_frame ();
+
+  for (i = 0; i < n_runs * 2; i++) {
+    gint64 start = g_get_monotonic_time ();
+
+    adw_style_manager_set_color_scheme (manager,
+                                        i % 2 ? ADW_COLOR_SCHEME_FORCE_LIGHT :
+                                                ADW_COLOR_SCHEME_FORCE_DARK);
+    wait_for_frame ();
+
+    switch_time[i] = ms_since (start);
+  }
+
+  add_result (scenario->name, n_items, "switch", "ms", switch_time, n_runs * 2);
+
+  adw_style_manager_set_color_scheme (manager, old_color_scheme);
+  gtk_window_set_child (GTK_WINDOW (window), NULL);
+
+  g_free (switch_time);
+}
+
+static Scenario scenarios[] = {
+  { "tab-view", 1000, create_tab_view, run_widget_scenario },
+  { "preferences-page", 5000, create_preferences_page, run_widget_scenario },
+  { "wrap-box", 10000, create_wrap_box, run_widget_scenario },
+  { "breakpoint-resize", 200, NULL, run_breakpoint_resize },
+  { "style-switch", 1000, NULL, run_style_switch },
+};
+
+static void
+print_results (void)
+{
+  guint i;
+
+  if (!json) {
+    for (i = 0; i < results->len; i++) {
+      Result *result = &g_array_index (results, Result, i);
+
+      g_print ("%-18s %6d items  %-12s %10.2f %s\n",
+               result->scenario, result->n_items,
+               result->metric, result->value, result->unit);
+    }
+
+    return;
+  }
+
+  g_print ("{\n");
+  g_print ("  \"benchmark\": \"bench-widgets\",\n");
+  g_print ("  \"version\": \"%d.%d.%d\",\n",
+           adw_get_major_version (),
+           adw_get_minor_version (),
+           adw_get_micro_version ());
+  g_print ("  \"n-runs\": %d,\n", n_runs);
+  g_print ("  \"results\": [\n");
+
+  for (i = 0; i < results->len; i++) {
+    Result *result = &g_array_index (results, Result, i);
+    char value[G_ASCII_DTOSTR_BUF_SIZE];
+
+    g_ascii_formatd (value, sizeof (value), "%.3f", result->value);
+
+    g_print ("    { \"scenario\": \"%s\", \"n-items\": %d, \"metric\": \"%s\", "
+             "\"unit\": \"%s\", \"value\": %s }%s\n",
+             result->scenario, result->n_items, result->metric,
+             result->unit, value, i < results->len - 1 ? "," : "");
+  }
+
+  g_print ("  ]\n");
+  g_print ("}\n");
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  gboolean found = FALSE;
+  guint i;
+
+  context = g_option_context_new (NULL);
+  g_option_context_set_summary (context,
+                                "Measure creating, laying out, drawing and destroying large\n"
+                                "widget trees.\n\n"
+                                "Scenarios: tab-view, preferences-page, wrap-box,\n"
+                                "breakpoint-resize, style-switch.\n\n"
+                                "Unlike most other benchmarks, this one opens a window. Use a\n"
+                                "headless display, such as Xvfb or broadway, to run it\n"
+                                "unattended.");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    g_option_context_free (context);
+
+    return 1;
+  }
+
+  g_option_context_free (context);
+
+  if (n_runs <= 0 || scale <= 0) {
+    g_printerr ("The number of runs and the scale must be positive\n");
+
+    return 1;
+  }
+
+  adw_init ();
+
+  results = g_array_new (FALSE, FALSE, sizeof (Result));
+
+  window = gtk_window_new ();
+  gtk_window_set_default_size (GTK_WINDOW (window), WIDTH, HEIGHT);
+  gtk_window_present (GTK_WINDOW (window));
+
+  while (!gtk_widget_get_mapped (window))
+    g_main_context_iteration (NULL, TRUE);
+
+  for (i = 0; i < G_N_ELEMENTS (scenarios); i++) {
+    Scenario *scenario = &scenarios[i];
+    int n_items = MAX (1, (int) (scenario->n_items * scale));
+
+    if (scenario_name && g_strcmp0 (scenario_name, scenario->name))
+      continue;
+
+    scenario->run (scenario, n_items);
+
+    found = TRUE;
+  }
+
+  gtk_window_destroy (GTK_WINDOW (window));
+
+  if (!found) {
+    g_printerr ("Unknown scenario: %s\n", scenario_name);
+    g_array_unref (results);
+
+    return 1;
+  }
+
+  print_results ();
+
+  g_array_unref (results);
+
+  return 0;
+}
@@ -271,6 +271,132 @@ test_adw_accent_color_rgba_to_standalone (void)
   TEST_RGBA_TO_STANDALONE (0x959595, TRUE,  0xcecece);
 }
 
+static GdkTexture *
+create_texture (int      width,
+                int      height,
+                guint32  color,
+                guint32  stripe_color,
+                int      stripe_width)
+{
+  gsize stride = width * 4;
+  guchar *data = g_malloc (stride * height);
+  GBytes *bytes;
+  GdkTexture *texture;
+  int x, y;
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      guint32 c = x < stripe_width ? stripe_color : color;
+      guchar *p = data + y * stride + x * 4;
+
+      p[0] = (c >> 24) & 0xff;
+      p[1] = (c >> 16) & 0xff;
+      p[2] = (c >> 8) & 0xff;
+      p[3] = c & 0xff;
+    }
+  }
+
+  bytes = g_bytes_new_take (data, stride * height);
+  texture = gdk_memory_texture_new (width, height, GDK_MEMORY_R8G8B8A8, bytes, stride);
+
+  g_bytes_unref (bytes);
+
+  return texture;
+}
+
+static void
+from_texture_cb (GObject       *source,
+                 GAsyncResult  *result,
+                 GAsyncResult **out_result)
+{
+  *out_result = g_object_ref (result);
+}
+
+static AdwAccentColor
+accent_color_from_texture (GdkTexture    *texture,
+                           GCancellable  *cancellable,
+                           GdkRGBA       *rgba,
+                           GError       **error)
+{
+  GAsyncResult *result = NULL;
+  AdwAccentColor accent;
+
+  adw_accent_color_from_texture_async (texture, cancellable,
+                                       (GAsyncReadyCallback) from_texture_cb,
+                                       &result);
+
+  while (!result)
+    g_main_context_iteration (NULL, TRUE);
+
+  accent = adw_accent_color_from_texture_finish (result, rgba, error);
+
+  g_object_unref (result);
+
+  return accent;
+}
+
+#define TEST_FROM_TEXTURE(width, height, color, stripe_color, stripe_width, expected) \
+  texture = create_texture (width, height, color, stripe_color, stripe_width); \
+  g_assert_cmpint (accent_color_from_texture (texture, NULL, NULL, &error), ==, expected); \
+  g_assert_no_error (error); \
+  g_assert_finalize_object (texture);
+
+static void
+test_adw_accent_color_from_texture (void)
+{
+  GdkTexture *texture;
+  GError *error = NULL;
+  GCancellable *cancellable;
+  GdkRGBA rgba;
+  int i;
+
+  /* Solid accent colors */
+  for (i = 0; i <= ADW_ACCENT_COLOR_PURPLE; i++) {
+    guint32 color;
+
+    adw_accent_color_to_rgba (i, &rgba);
+    color = (guint32) round (rgba.red * 0xff) << 24 |
+            (guint32) round (rgba.green * 0xff) << 16 |
+            (guint32) round (rgba.blue * 0xff) << 8 |
+            0xff;
+
+    TEST_FROM_TEXTURE (100, 100, color, color, 0, i);
+  }
+
+  /* Grays */
+  TEST_FROM_TEXTURE (100, 100, 0x959595ff, 0, 0, ADW_ACCENT_COLOR_SLATE);
+  TEST_FROM_TEXTURE (100, 100, 0xffffffff, 0, 0, ADW_ACCENT_COLOR_SLATE);
+
+  /* Gray with a bit of color */
+  TEST_FROM_TEXTURE (200, 100, 0x959595ff, 0xe62d42ff, 1, ADW_ACCENT_COLOR_SLATE);
+
+  /* Mostly gray with a significant amount of color */
+  TEST_FROM_TEXTURE (200, 100, 0x959595ff, 0x3a944aff, 40, ADW_ACCENT_COLOR_GREEN);
+
+  /* Transparent parts are ignored */
+  TEST_FROM_TEXTURE (200, 100, 0xe62d4200, 0x3584e4ff, 40, ADW_ACCENT_COLOR_BLUE);
+  TEST_FROM_TEXTURE (100, 100, 0x00000000, 0, 0, ADW_ACCENT_COLOR_BLUE);
+
+  /* Large texture and the dominant color */
+  texture = create_texture (3840, 2160, 0xe62d42ff, 0xe62d42ff, 0);
+  g_assert_cmpint (accent_color_from_texture (texture, NULL, &rgba, &error), ==, ADW_ACCENT_COLOR_RED);
+  g_assert_no_error (error);
+  g_assert_cmpfloat_with_epsilon (rgba.red, 0xe6 / 255.0, 0.005);
+  g_assert_cmpfloat_with_epsilon (rgba.green, 0x2d / 255.0, 0.005);
+  g_assert_cmpfloat_with_epsilon (rgba.blue, 0x42 / 255.0, 0.005);
+  g_assert_cmpfloat (rgba.alpha, ==, 1);
+
+  /* Cancelled */
+  cancellable = g_cancellable_new ();
+  g_cancellable_cancel (cancellable);
+  g_assert_cmpint (accent_color_from_texture (texture, cancellable, NULL, &error), ==, ADW_ACCENT_COLOR_BLUE);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+  g_clear_error (&error);
+  g_assert_finalize_object (cancellable);
+
+  g_assert_finalize_object (texture);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -282,6 +408,7 @@ main (int   argc,
   g_test_add_func ("/Adwaita/AccentColor/to_rgba", test_adw_accent_color_to_rgba);
   g_test_add_func ("/Adwaita/AccentColor/to_standalone_rgba", test_adw_accent_color_to_standalone_rgba);
   g_test_add_func ("/Adwaita/AccentColor/rgba_to_standalone", test_adw_accent_color_rgba_to_standalone);
+  g_test_add_func ("/Adwaita/AccentColor/from_texture", test_adw_accent_color_from_texture);
 
   return g_test_run ();
 }
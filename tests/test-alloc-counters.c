@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#include "adw-alloc-counters-private.h"
+
+static void
+test_adw_alloc_counters_disabled (void)
+{
+  AdwAllocCounterStats stats;
+
+  adw_alloc_counters_set_enabled (FALSE);
+  adw_alloc_counters_reset ();
+
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 3);
+  adw_alloc_counters_end_frame ();
+
+  adw_alloc_counters_get_stats (ADW_ALLOC_COUNTER_WRAP_LAYOUT, &stats);
+  g_assert_cmpuint (stats.total, ==, 0);
+  g_assert_cmpuint (adw_alloc_counters_get_n_frames (), ==, 0);
+}
+
+static void
+test_adw_alloc_counters_frames (void)
+{
+  AdwAllocCounterStats stats;
+
+  adw_alloc_counters_set_enabled (TRUE);
+  adw_alloc_counters_reset ();
+
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 3);
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 2);
+  adw_alloc_counters_end_frame ();
+
+  adw_alloc_counters_get_stats (ADW_ALLOC_COUNTER_WRAP_LAYOUT, &stats);
+  g_assert_cmpuint (stats.last_frame, ==, 5);
+  g_assert_cmpuint (stats.peak, ==, 5);
+  g_assert_cmpuint (stats.total, ==, 5);
+
+  adw_alloc_counters_add (ADW_ALLOC_COUNTER_WRAP_LAYOUT, 1);
+  adw_alloc_counters_end_frame ();
+
+  adw_alloc_counters_get_stats (ADW_ALLOC_COUNTER_WRAP_LAYOUT, &stats);
+  g_assert_cmpuint (stats.last_frame, ==, 1);
+  g_assert_cmpuint (stats.peak, ==, 5);
+  g_assert_cmpuint (stats.total, ==, 6);
+
+  adw_alloc_counters_end_frame ();
+
+  adw_alloc_counters_get_stats (ADW_ALLOC_COUNTER_WRAP_LAYOUT, &stats);
+  g_assert_cmpuint (stats.last_frame, ==, 0);
+  g_assert_cmpuint (adw_alloc_counters_get_n_frames (), ==, 3);
+  g_assert_cmpuint (adw_alloc_counters_get_n_clean_frames (), ==, 1);
+
+  adw_alloc_counters_reset ();
+
+  adw_alloc_counters_get_stats (ADW_ALLOC_COUNTER_WRAP_LAYOUT, &stats);
+  g_assert_cmpuint (stats.total, ==, 0);
+  g_assert_cmpuint (adw_alloc_counters_get_n_frames (), ==, 0);
+
+  adw_alloc_counters_set_enabled (FALSE);
+}
+
+static void
+test_adw_alloc_counters_snap_points (void)
+{
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  AdwAllocCounterStats stats;
+  double *points;
+  int n_points;
+
+  adw_alloc_counters_set_enabled (TRUE);
+  adw_alloc_counters_reset ();
+
+  points = adw_swipeable_get_snap_points (ADW_SWIPEABLE (carousel), &n_points);
+  g_free (points);
+
+  adw_alloc_counters_get_stats (ADW_ALLOC_COUNTER_SNAP_POINTS, &stats);
+  g_assert_cmpuint (stats.total, ==, 1);
+
+  adw_alloc_counters_set_enabled (FALSE);
+
+  g_assert_finalize_object (carousel);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Adwaita/AllocCounters/disabled", test_adw_alloc_counters_disabled);
+  g_test_add_func ("/Adwaita/AllocCounters/frames", test_adw_alloc_counters_frames);
+  g_test_add_func ("/Adwaita/AllocCounters/snap_points", test_adw_alloc_counters_snap_points);
+
+  return g_test_run ();
+}
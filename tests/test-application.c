@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+static gboolean
+parsing_error_cb (GSignalInvocationHint *hint,
+                  guint                  n_param_values,
+                  const GValue          *param_values,
+                  gpointer               user_data)
+{
+  int *n_errors = user_data;
+
+  (*n_errors)++;
+
+  return TRUE;
+}
+
+static void
+test_adw_application_relative_url (void)
+{
+  GApplication *app;
+  GError *error = NULL;
+  guint signal_id;
+  gulong hook_id;
+  int n_errors = 0;
+
+  g_type_class_ref (GTK_TYPE_CSS_PROVIDER);
+  signal_id = g_signal_lookup ("parsing-error", GTK_TYPE_CSS_PROVIDER);
+  hook_id = g_signal_add_emission_hook (signal_id, 0, parsing_error_cb, &n_errors, NULL);
+
+  app = g_object_new (ADW_TYPE_APPLICATION,
+                      "application-id", "org.gnome.Adwaita1.Test",
+                      "resource-base-path", "/org/gnome/Adwaita1/Test/application",
+                      "flags", G_APPLICATION_NON_UNIQUE,
+                      NULL);
+
+  g_test_expect_message (ADW_LOG_DOMAIN, G_LOG_LEVEL_WARNING,
+                         "The resource style-dark.css is deprecated*");
+  g_test_expect_message (ADW_LOG_DOMAIN, G_LOG_LEVEL_WARNING,
+                         "The resource style-hc.css is deprecated*");
+
+  g_application_register (app, NULL, &error);
+  g_assert_no_error (error);
+
+  g_test_assert_expected_messages ();
+
+  /* style-dark.css refers to image.svg next to it, and style-hc.css imports
+   * a stylesheet from a subdirectory referring to the same image. These are
+   * only resolved correctly relative to the file they're in */
+  g_assert_cmpint (n_errors, ==, 0);
+
+  g_signal_remove_emission_hook (signal_id, hook_id);
+
+  g_object_unref (app);
+}
+
+static GtkWidget *
+find_shortcuts_dialog (GtkWidget *widget)
+{
+  GtkWidget *child;
+
+  if (ADW_IS_SHORTCUTS_DIALOG (widget))
+    return widget;
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkWidget *dialog = find_shortcuts_dialog (child);
+
+    if (dialog)
+      return dialog;
+  }
+
+  return NULL;
+}
+
+static AdwDialog *
+show_shortcuts_dialog (GApplication *app)
+{
+  GListModel *toplevels = gtk_window_get_toplevels ();
+  guint i;
+
+  g_action_group_activate_action (G_ACTION_GROUP (app), "shortcuts", NULL);
+
+  for (i = 0; i < g_list_model_get_n_items (toplevels); i++) {
+    GtkWidget *window = g_list_model_get_item (toplevels, i);
+    GtkWidget *dialog = find_shortcuts_dialog (window);
+
+    g_object_unref (window);
+
+    if (dialog)
+      return ADW_DIALOG (dialog);
+  }
+
+  return NULL;
+}
+
+static void
+close_shortcuts_dialog (AdwDialog *dialog)
+{
+  adw_dialog_force_close (dialog);
+
+  while (gtk_widget_get_root (GTK_WIDGET (dialog)))
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+test_adw_application_cache_shortcuts_dialog (void)
+{
+  GApplication *app;
+  AdwDialog *dialog, *cached;
+  GError *error = NULL;
+
+  app = g_object_new (ADW_TYPE_APPLICATION,
+                      "application-id", "org.gnome.Adwaita1.Test",
+                      "resource-base-path", "/org/gnome/Adwaita1/Test/shortcuts",
+                      "flags", G_APPLICATION_NON_UNIQUE,
+                      "cache-shortcuts-dialog", TRUE,
+                      NULL);
+
+  g_application_register (app, NULL, &error);
+  g_assert_no_error (error);
+
+  cached = show_shortcuts_dialog (app);
+  g_assert_nonnull (cached);
+  g_object_add_weak_pointer (G_OBJECT (cached), (gpointer *) &cached);
+  close_shortcuts_dialog (cached);
+
+  /* The same dialog is presented again */
+  dialog = show_shortcuts_dialog (app);
+  g_assert_true (dialog == cached);
+  close_shortcuts_dialog (dialog);
+
+  /* Not caching drops the dialog */
+  adw_application_set_cache_shortcuts_dialog (ADW_APPLICATION (app), FALSE);
+  g_assert_null (cached);
+
+  /* And caching again builds a new one */
+  adw_application_set_cache_shortcuts_dialog (ADW_APPLICATION (app), TRUE);
+
+  cached = show_shortcuts_dialog (app);
+  g_assert_nonnull (cached);
+  g_object_add_weak_pointer (G_OBJECT (cached), (gpointer *) &cached);
+  close_shortcuts_dialog (cached);
+
+  dialog = show_shortcuts_dialog (app);
+  g_assert_true (dialog == cached);
+  close_shortcuts_dialog (dialog);
+
+  g_object_remove_weak_pointer (G_OBJECT (cached), (gpointer *) &cached);
+
+  g_object_unref (app);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Adwaita/Application/relative_url", test_adw_application_relative_url);
+  g_test_add_func ("/Adwaita/Application/cache_shortcuts_dialog", test_adw_application_cache_shortcuts_dialog);
+
+  return g_test_run ();
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#include "adw-avatar-cache-private.h"
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+static void
+draw (GdkPaintable *paintable)
+{
+  GtkSnapshot *snapshot = gtk_snapshot_new ();
+  GskRenderNode *node;
+
+  gdk_paintable_snapshot (paintable, snapshot,
+                          gdk_paintable_get_intrinsic_width (paintable),
+                          gdk_paintable_get_intrinsic_height (paintable));
+
+  node = gtk_snapshot_free_to_node (snapshot);
+  g_assert_nonnull (node);
+
+  gsk_render_node_unref (node);
+}
+
+static void
+test_adw_avatar_paintable_new (void)
+{
+  AdwAvatarPaintable *paintable = adw_avatar_paintable_new (48, "Mario Rossi", TRUE);
+
+  g_assert_nonnull (paintable);
+
+  g_assert_cmpint (adw_avatar_paintable_get_size (paintable), ==, 48);
+  g_assert_cmpstr (adw_avatar_paintable_get_text (paintable), ==, "Mario Rossi");
+  g_assert_true (adw_avatar_paintable_get_show_initials (paintable));
+  g_assert_null (adw_avatar_paintable_get_icon_name (paintable));
+  g_assert_null (adw_avatar_paintable_get_custom_image (paintable));
+  g_assert_null (adw_avatar_paintable_get_widget (paintable));
+
+  g_assert_cmpint (gdk_paintable_get_intrinsic_width (GDK_PAINTABLE (paintable)), ==, 48);
+  g_assert_cmpint (gdk_paintable_get_intrinsic_height (GDK_PAINTABLE (paintable)), ==, 48);
+
+  g_assert_finalize_object (paintable);
+}
+
+static void
+test_adw_avatar_paintable_invalidate (void)
+{
+  AdwAvatarPaintable *paintable = adw_avatar_paintable_new (32, NULL, FALSE);
+  int contents = 0, size = 0;
+
+  g_signal_connect_swapped (paintable, "invalidate-contents", G_CALLBACK (increment), &contents);
+  g_signal_connect_swapped (paintable, "invalidate-size", G_CALLBACK (increment), &size);
+
+  adw_avatar_paintable_set_text (paintable, "Mario Rossi");
+  g_assert_cmpint (contents, ==, 1);
+
+  adw_avatar_paintable_set_text (paintable, "Mario Rossi");
+  g_assert_cmpint (contents, ==, 1);
+
+  adw_avatar_paintable_set_show_initials (paintable, TRUE);
+  g_assert_cmpint (contents, ==, 2);
+
+  adw_avatar_paintable_set_icon_name (paintable, "avatar-default-symbolic");
+  g_assert_cmpint (contents, ==, 3);
+
+  adw_avatar_paintable_set_size (paintable, 64);
+  g_assert_cmpint (contents, ==, 4);
+  g_assert_cmpint (size, ==, 1);
+  g_assert_cmpint (gdk_paintable_get_intrinsic_width (GDK_PAINTABLE (paintable)), ==, 64);
+
+  g_assert_finalize_object (paintable);
+}
+
+static void
+test_adw_avatar_paintable_widget (void)
+{
+  GtkWidget *image = g_object_ref_sink (gtk_image_new ());
+  AdwAvatarPaintable *paintable = adw_avatar_paintable_new (32, "Mario Rossi", TRUE);
+  int notified = 0;
+
+  g_signal_connect_swapped (paintable, "notify::widget", G_CALLBACK (increment), &notified);
+
+  adw_avatar_paintable_set_widget (paintable, image);
+  g_assert_true (adw_avatar_paintable_get_widget (paintable) == image);
+  g_assert_cmpint (notified, ==, 1);
+
+  gtk_image_set_from_paintable (GTK_IMAGE (image), GDK_PAINTABLE (paintable));
+
+  g_assert_finalize_object (image);
+  g_assert_null (adw_avatar_paintable_get_widget (paintable));
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (paintable);
+}
+
+static void
+test_adw_avatar_paintable_cache (void)
+{
+  AdwAvatarCache *cache = adw_avatar_cache_get_for_display (gdk_display_get_default ());
+  AdwAvatarPaintable *paintable1 = adw_avatar_paintable_new (32, "Mario Rossi", TRUE);
+  AdwAvatarPaintable *paintable2 = adw_avatar_paintable_new (32, "Mario Rossi", TRUE);
+  AdwAvatarPaintable *paintable3 = adw_avatar_paintable_new (48, "Mario Rossi", TRUE);
+
+  adw_avatar_cache_clear (cache);
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 0);
+
+  draw (GDK_PAINTABLE (paintable1));
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 1);
+
+  draw (GDK_PAINTABLE (paintable2));
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 1);
+
+  draw (GDK_PAINTABLE (paintable3));
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 2);
+
+  /* The cache doesn't need any windows to render */
+  g_assert_cmpint (g_list_model_get_n_items (gtk_window_get_toplevels ()), ==, 0);
+
+  adw_avatar_paintable_set_show_initials (paintable1, FALSE);
+  draw (GDK_PAINTABLE (paintable1));
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 3);
+
+  adw_avatar_cache_clear (cache);
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 0);
+
+  g_assert_finalize_object (paintable1);
+  g_assert_finalize_object (paintable2);
+  g_assert_finalize_object (paintable3);
+}
+
+static void
+test_adw_avatar_paintable_custom_image (void)
+{
+  AdwAvatarCache *cache = adw_avatar_cache_get_for_display (gdk_display_get_default ());
+  AdwAvatarPaintable *paintable = adw_avatar_paintable_new (32, "Mario Rossi", TRUE);
+  GBytes *bytes = g_bytes_new_static ("\xff\x00\x00\xff", 4);
+  GdkPaintable *image = GDK_PAINTABLE (gdk_memory_texture_new (1, 1, GDK_MEMORY_R8G8B8A8, bytes, 4));
+
+  g_bytes_unref (bytes);
+
+  adw_avatar_cache_clear (cache);
+
+  adw_avatar_paintable_set_custom_image (paintable, image);
+  draw (GDK_PAINTABLE (paintable));
+
+  /* The cache must not keep custom images alive */
+  g_assert_cmpint (adw_avatar_cache_get_n_entries (cache), ==, 0);
+
+  adw_avatar_paintable_set_custom_image (paintable, NULL);
+  g_assert_finalize_object (image);
+
+  g_assert_finalize_object (paintable);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Adwaita/AvatarPaintable/new", test_adw_avatar_paintable_new);
+  g_test_add_func ("/Adwaita/AvatarPaintable/invalidate", test_adw_avatar_paintable_invalidate);
+  g_test_add_func ("/Adwaita/AvatarPaintable/widget", test_adw_avatar_paintable_widget);
+  g_test_add_func ("/Adwaita/AvatarPaintable/cache", test_adw_avatar_paintable_cache);
+  g_test_add_func ("/Adwaita/AvatarPaintable/custom-image", test_adw_avatar_paintable_custom_image);
+
+  return g_test_run ();
+}
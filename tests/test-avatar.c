@@ -47,6 +47,138 @@ test_adw_avatar_size (void)
   g_assert_finalize_object (avatar);
 }
 
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+static GdkTexture *
+create_texture (int width,
+                int height)
+{
+  gsize stride = width * 4;
+  guchar *data = g_malloc0 (stride * height);
+  GBytes *bytes = g_bytes_new_take (data, stride * height);
+  GdkTexture *texture;
+
+  texture = gdk_memory_texture_new (width, height, GDK_MEMORY_DEFAULT, bytes, stride);
+
+  g_bytes_unref (bytes);
+
+  return texture;
+}
+
+/* The image widget showing the custom image inside the avatar */
+static GtkWidget *
+get_custom_image_widget (AdwAvatar *avatar)
+{
+  GtkWidget *gizmo = gtk_widget_get_first_child (GTK_WIDGET (avatar));
+  GtkWidget *child;
+
+  for (child = gtk_widget_get_first_child (gizmo);
+       child;
+       child = gtk_widget_get_next_sibling (child))
+    if (GTK_IS_IMAGE (child) && gtk_image_get_storage_type (GTK_IMAGE (child)) == GTK_IMAGE_PAINTABLE)
+      return child;
+
+  return NULL;
+}
+
+static void
+test_adw_avatar_downscale_custom_image (void)
+{
+  AdwAvatar *avatar = g_object_ref_sink (ADW_AVATAR (adw_avatar_new (TEST_SIZE, NULL, TRUE)));
+  GdkTexture *texture = create_texture (TEST_SIZE * 8, TEST_SIZE * 4);
+  GdkPaintable *downscaled;
+  int notified = 0;
+
+  g_assert_false (adw_avatar_get_downscale_custom_image (avatar));
+
+  adw_avatar_set_downscale_custom_image (avatar, TRUE);
+  g_assert_true (adw_avatar_get_downscale_custom_image (avatar));
+
+  g_signal_connect_swapped (avatar, "notify::custom-image", G_CALLBACK (increment), &notified);
+
+  adw_avatar_set_custom_image (avatar, GDK_PAINTABLE (texture));
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_true (adw_avatar_get_custom_image (avatar) == GDK_PAINTABLE (texture));
+
+  g_object_add_weak_pointer (G_OBJECT (texture), (gpointer *) &texture);
+  g_object_unref (texture);
+  g_assert_nonnull (texture);
+
+  /* The original texture is replaced and dropped once it's downscaled */
+  while (notified < 2)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_null (texture);
+
+  downscaled = adw_avatar_get_custom_image (avatar);
+  g_assert_true (GDK_IS_TEXTURE (downscaled));
+  g_assert_cmpint (gdk_texture_get_width (GDK_TEXTURE (downscaled)), ==, TEST_SIZE);
+  g_assert_cmpint (gdk_texture_get_height (GDK_TEXTURE (downscaled)), ==, TEST_SIZE);
+  g_assert_nonnull (get_custom_image_widget (avatar));
+
+  /* The downscaled texture stays */
+  adw_avatar_set_downscale_custom_image (avatar, FALSE);
+  g_assert_true (adw_avatar_get_custom_image (avatar) == downscaled);
+  g_assert_nonnull (get_custom_image_widget (avatar));
+  g_assert_cmpint (notified, ==, 2);
+
+  adw_avatar_set_custom_image (avatar, NULL);
+  g_assert_null (get_custom_image_widget (avatar));
+  g_assert_cmpint (notified, ==, 3);
+
+  g_assert_finalize_object (avatar);
+}
+
+static void
+test_adw_avatar_downscale_custom_image_resize (void)
+{
+  AdwAvatar *avatar = g_object_ref_sink (ADW_AVATAR (adw_avatar_new (TEST_SIZE, NULL, TRUE)));
+  GdkTexture *texture = create_texture (TEST_SIZE * 4, TEST_SIZE * 4);
+  GdkPaintable *downscaled;
+  int notified = 0;
+
+  adw_avatar_set_downscale_custom_image (avatar, TRUE);
+
+  g_signal_connect_swapped (avatar, "notify::custom-image", G_CALLBACK (increment), &notified);
+
+  adw_avatar_set_custom_image (avatar, GDK_PAINTABLE (texture));
+
+  while (notified < 2)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* The property returns the texture that's displayed */
+  downscaled = adw_avatar_get_custom_image (avatar);
+  g_assert_true (downscaled != GDK_PAINTABLE (texture));
+  g_assert_cmpint (gdk_texture_get_width (GDK_TEXTURE (downscaled)), ==, TEST_SIZE);
+
+  /* The downscaled texture is never scaled back up */
+  adw_avatar_set_size (avatar, TEST_SIZE * 2);
+  g_assert_true (adw_avatar_get_custom_image (avatar) == downscaled);
+  g_assert_cmpint (notified, ==, 2);
+
+  /* But it's downscaled further */
+  adw_avatar_set_size (avatar, TEST_SIZE / 2);
+
+  while (notified < 3)
+    g_main_context_iteration (NULL, TRUE);
+
+  downscaled = adw_avatar_get_custom_image (avatar);
+  g_assert_cmpint (gdk_texture_get_width (GDK_TEXTURE (downscaled)), ==, TEST_SIZE / 2);
+
+  /* Setting the original again starts over */
+  adw_avatar_set_size (avatar, TEST_SIZE * 8);
+  adw_avatar_set_custom_image (avatar, GDK_PAINTABLE (texture));
+  g_assert_true (adw_avatar_get_custom_image (avatar) == GDK_PAINTABLE (texture));
+  g_assert_cmpint (notified, ==, 4);
+
+  g_assert_finalize_object (avatar);
+  g_assert_finalize_object (texture);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -57,6 +189,8 @@ main (int   argc,
   g_test_add_func ("/Adwaita/Avatar/icon_name", test_adw_avatar_icon_name);
   g_test_add_func ("/Adwaita/Avatar/text", test_adw_avatar_text);
   g_test_add_func ("/Adwaita/Avatar/size", test_adw_avatar_size);
+  g_test_add_func ("/Adwaita/Avatar/downscale_custom_image", test_adw_avatar_downscale_custom_image);
+  g_test_add_func ("/Adwaita/Avatar/downscale_custom_image_resize", test_adw_avatar_downscale_custom_image_resize);
 
   return g_test_run ();
 }
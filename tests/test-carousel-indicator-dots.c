@@ -41,6 +41,131 @@ test_adw_carousel_indicator_dots_carousel (void)
   g_assert_finalize_object (carousel);
 }
 
+static int
+count_dots (GskRenderNode *node)
+{
+  int n = 0;
+  guint i;
+
+  switch (gsk_render_node_get_node_type (node)) {
+  case GSK_ROUNDED_CLIP_NODE:
+    return 1;
+  case GSK_CONTAINER_NODE:
+    for (i = 0; i < gsk_container_node_get_n_children (node); i++)
+      n += count_dots (gsk_container_node_get_child (node, i));
+    return n;
+  default:
+    return 0;
+  }
+}
+
+static int
+count_drawn_dots (GtkWidget *widget)
+{
+  GtkSnapshot *snapshot = gtk_snapshot_new ();
+  GskRenderNode *node;
+  int n;
+
+  GTK_WIDGET_GET_CLASS (widget)->snapshot (widget, snapshot);
+
+  node = gtk_snapshot_free_to_node (snapshot);
+  g_assert_nonnull (node);
+
+  n = count_dots (node);
+
+  gsk_render_node_unref (node);
+
+  return n;
+}
+
+static void
+allocate_carousel (AdwCarousel *carousel)
+{
+  /* The snap points are only known after allocating the carousel */
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, NULL, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_VERTICAL, 100,
+                      NULL, NULL, NULL, NULL);
+  gtk_widget_allocate (GTK_WIDGET (carousel), 100, 100, -1, NULL);
+}
+
+static void
+test_adw_carousel_indicator_dots_max_dots (void)
+{
+  AdwCarouselIndicatorDots *dots = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_DOTS (adw_carousel_indicator_dots_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  int notified = 0;
+  int full_width, width, i;
+
+  g_signal_connect_swapped (dots, "notify::max-dots", G_CALLBACK (increment), &notified);
+
+  for (i = 0; i < 10; i++)
+    adw_carousel_append (carousel, gtk_label_new ("Page"));
+
+  allocate_carousel (carousel);
+
+  adw_carousel_indicator_dots_set_carousel (dots, carousel);
+
+  g_assert_cmpuint (adw_carousel_indicator_dots_get_max_dots (dots), ==, 0);
+  g_assert_cmpint (notified, ==, 0);
+
+  gtk_widget_measure (GTK_WIDGET (dots), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &full_width, NULL, NULL);
+
+  adw_carousel_indicator_dots_set_max_dots (dots, 5);
+  g_assert_cmpuint (adw_carousel_indicator_dots_get_max_dots (dots), ==, 5);
+  g_assert_cmpint (notified, ==, 1);
+
+  gtk_widget_measure (GTK_WIDGET (dots), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width, NULL, NULL);
+  g_assert_cmpint (width, <, full_width);
+
+  g_object_set (dots, "max-dots", 20, NULL);
+  g_assert_cmpuint (adw_carousel_indicator_dots_get_max_dots (dots), ==, 20);
+  g_assert_cmpint (notified, ==, 2);
+
+  gtk_widget_measure (GTK_WIDGET (dots), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width, NULL, NULL);
+  g_assert_cmpint (width, ==, full_width);
+
+  g_assert_finalize_object (dots);
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adw_carousel_indicator_dots_max_dots_redraw (void)
+{
+  AdwCarouselIndicatorDots *dots = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_DOTS (adw_carousel_indicator_dots_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  int width, height, i;
+
+  for (i = 0; i < 10; i++)
+    adw_carousel_append (carousel, gtk_label_new ("Page"));
+
+  allocate_carousel (carousel);
+
+  adw_carousel_indicator_dots_set_carousel (dots, carousel);
+
+  gtk_widget_measure (GTK_WIDGET (dots), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (dots), GTK_ORIENTATION_VERTICAL, width,
+                      NULL, &height, NULL, NULL);
+  gtk_widget_allocate (GTK_WIDGET (dots), width, height, -1, NULL);
+
+  g_assert_cmpint (count_drawn_dots (GTK_WIDGET (dots)), ==, 10);
+
+  /* The size stays the same, but the dots past max-dots must not be drawn
+   * from the cache */
+  adw_carousel_indicator_dots_set_max_dots (dots, 5);
+  g_assert_cmpint (count_drawn_dots (GTK_WIDGET (dots)), ==, 5);
+
+  adw_carousel_indicator_dots_set_max_dots (dots, 0);
+  g_assert_cmpint (count_drawn_dots (GTK_WIDGET (dots)), ==, 10);
+
+  g_assert_finalize_object (dots);
+  g_assert_finalize_object (carousel);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -49,5 +174,7 @@ main (int   argc,
   adw_init ();
 
   g_test_add_func("/Adwaita/CarouselIndicatorDots/carousel", test_adw_carousel_indicator_dots_carousel);
+  g_test_add_func("/Adwaita/CarouselIndicatorDots/max_dots", test_adw_carousel_indicator_dots_max_dots);
+  g_test_add_func("/Adwaita/CarouselIndicatorDots/max_dots_redraw", test_adw_carousel_indicator_dots_max_dots_redraw);
   return g_test_run();
 }
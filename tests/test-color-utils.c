@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+#include "adw-color-utils-private.h"
+
+#include <math.h>
+
+#define N_STEPS 17
+#define N_COLORS (N_STEPS * N_STEPS * N_STEPS)
+#define EPSILON 1e-5
+
+static float *
+create_rgb_grid (void)
+{
+  float *rgb = g_new (float, N_COLORS * 3);
+  int i = 0, r, g, b;
+
+  for (r = 0; r < N_STEPS; r++) {
+    for (g = 0; g < N_STEPS; g++) {
+      for (b = 0; b < N_STEPS; b++) {
+        rgb[i++] = (float) r / (N_STEPS - 1);
+        rgb[i++] = (float) g / (N_STEPS - 1);
+        rgb[i++] = (float) b / (N_STEPS - 1);
+      }
+    }
+  }
+
+  return rgb;
+}
+
+static void
+test_adw_color_utils_oklab_n (void)
+{
+  float *rgb = create_rgb_grid ();
+  float *lab = g_new (float, N_COLORS * 3);
+  float *result = g_new (float, N_COLORS * 3);
+  int i;
+
+  adw_rgb_to_oklab_n (rgb, lab, N_COLORS);
+
+  for (i = 0; i < N_COLORS; i++) {
+    float L, a, b;
+
+    adw_rgb_to_oklab (rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2], &L, &a, &b);
+
+    g_assert_cmpfloat_with_epsilon (lab[i * 3], L, EPSILON);
+    g_assert_cmpfloat_with_epsilon (lab[i * 3 + 1], a, EPSILON);
+    g_assert_cmpfloat_with_epsilon (lab[i * 3 + 2], b, EPSILON);
+  }
+
+  adw_oklab_to_rgb_n (lab, result, N_COLORS);
+
+  for (i = 0; i < N_COLORS; i++) {
+    float red, green, blue;
+
+    adw_oklab_to_rgb (lab[i * 3], lab[i * 3 + 1], lab[i * 3 + 2], &red, &green, &blue);
+
+    g_assert_cmpfloat_with_epsilon (result[i * 3], red, EPSILON);
+    g_assert_cmpfloat_with_epsilon (result[i * 3 + 1], green, EPSILON);
+    g_assert_cmpfloat_with_epsilon (result[i * 3 + 2], blue, EPSILON);
+  }
+
+  /* In place */
+  adw_rgb_to_oklab_n (rgb, rgb, N_COLORS);
+
+  for (i = 0; i < N_COLORS * 3; i++)
+    g_assert_cmpfloat (rgb[i], ==, lab[i]);
+
+  g_free (rgb);
+  g_free (lab);
+  g_free (result);
+}
+
+static void
+test_adw_color_utils_oklch_n (void)
+{
+  float *rgb = create_rgb_grid ();
+  float *lch = g_new (float, N_COLORS * 3);
+  float *result = g_new (float, N_COLORS * 3);
+  int i;
+
+  adw_rgb_to_oklch_n (rgb, lch, N_COLORS);
+
+  for (i = 0; i < N_COLORS; i++) {
+    float L, c, h, diff;
+
+    adw_rgb_to_oklch (rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2], &L, &c, &h);
+
+    g_assert_cmpfloat_with_epsilon (lch[i * 3], L, EPSILON);
+    g_assert_cmpfloat_with_epsilon (lch[i * 3 + 1], c, EPSILON);
+
+    /* Hue is unstable for grays */
+    if (c < 0.01)
+      continue;
+
+    diff = fabsf (lch[i * 3 + 2] - h);
+    g_assert_cmpfloat (MIN (diff, 360 - diff), <, 0.01);
+  }
+
+  adw_oklch_to_rgb_n (lch, result, N_COLORS);
+
+  for (i = 0; i < N_COLORS * 3; i++)
+    g_assert_cmpfloat_with_epsilon (result[i], rgb[i], 1e-4);
+
+  g_free (rgb);
+  g_free (lch);
+  g_free (result);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Adwaita/ColorUtils/oklab_n", test_adw_color_utils_oklab_n);
+  g_test_add_func ("/Adwaita/ColorUtils/oklch_n", test_adw_color_utils_oklch_n);
+
+  return g_test_run ();
+}
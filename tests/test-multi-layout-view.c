@@ -213,6 +213,200 @@ test_adw_multi_layout_view_children (void)
   g_assert_finalize_object (slot22);
 }
 
+static void
+test_adw_multi_layout_view_nested_slots (void)
+{
+  AdwMultiLayoutView *view = g_object_ref_sink (ADW_MULTI_LAYOUT_VIEW (adw_multi_layout_view_new ()));
+  GtkWidget *slot1 = g_object_ref_sink (adw_layout_slot_new ("outer"));
+  GtkWidget *slot2 = g_object_ref_sink (adw_layout_slot_new ("outer"));
+  GtkWidget *inner_slot = adw_layout_slot_new ("inner");
+  GtkWidget *content1 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *content2 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *outer = g_object_ref_sink (gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0));
+  GtkWidget *inner = g_object_ref_sink (adw_bin_new ());
+  AdwLayout *layout1, *layout2;
+  GtkWidget *window = adw_window_new ();
+  int notified = 0;
+
+  adw_bin_set_child (ADW_BIN (content1), slot1);
+  adw_bin_set_child (ADW_BIN (content2), slot2);
+  gtk_box_append (GTK_BOX (outer), inner_slot);
+
+  layout1 = adw_layout_new (content1);
+  layout2 = adw_layout_new (content2);
+
+  adw_window_set_content (ADW_WINDOW (window), GTK_WIDGET (view));
+  adw_multi_layout_view_add_layout (view, g_object_ref (layout1));
+  adw_multi_layout_view_add_layout (view, g_object_ref (layout2));
+
+  adw_multi_layout_view_set_child (view, "inner", inner);
+  g_assert_null (gtk_widget_get_parent (inner));
+
+  adw_multi_layout_view_set_child (view, "outer", outer);
+  g_assert_true (gtk_widget_get_parent (outer) == slot1);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot);
+
+  g_signal_connect_swapped (inner, "notify::parent", G_CALLBACK (increment), &notified);
+
+  adw_multi_layout_view_set_layout (view, layout2);
+  g_assert_true (gtk_widget_get_parent (outer) == slot2);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot);
+
+  adw_multi_layout_view_set_layout (view, layout1);
+  g_assert_true (gtk_widget_get_parent (outer) == slot1);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot);
+
+  g_assert_cmpint (notified, ==, 0);
+
+  g_assert_finalize_object (window);
+  g_assert_finalize_object (view);
+  g_assert_finalize_object (layout1);
+  g_assert_finalize_object (layout2);
+  g_assert_finalize_object (content1);
+  g_assert_finalize_object (content2);
+  g_assert_finalize_object (slot1);
+  g_assert_finalize_object (slot2);
+}
+
+static void
+test_adw_multi_layout_view_replace_nested (void)
+{
+  AdwMultiLayoutView *view = g_object_ref_sink (ADW_MULTI_LAYOUT_VIEW (adw_multi_layout_view_new ()));
+  GtkWidget *slot1 = g_object_ref_sink (adw_layout_slot_new ("outer"));
+  GtkWidget *slot2 = g_object_ref_sink (adw_layout_slot_new ("outer"));
+  GtkWidget *inner_slot1 = adw_layout_slot_new ("inner");
+  GtkWidget *inner_slot2 = adw_layout_slot_new ("inner");
+  GtkWidget *content1 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *content2 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *outer1 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *outer2 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *inner = g_object_ref_sink (adw_bin_new ());
+  AdwLayout *layout1, *layout2;
+  GtkWidget *window = adw_window_new ();
+
+  adw_bin_set_child (ADW_BIN (content1), slot1);
+  adw_bin_set_child (ADW_BIN (content2), slot2);
+  adw_bin_set_child (ADW_BIN (outer1), inner_slot1);
+  adw_bin_set_child (ADW_BIN (outer2), inner_slot2);
+
+  layout1 = adw_layout_new (content1);
+  layout2 = adw_layout_new (content2);
+
+  adw_window_set_content (ADW_WINDOW (window), GTK_WIDGET (view));
+  adw_multi_layout_view_add_layout (view, g_object_ref (layout1));
+  adw_multi_layout_view_add_layout (view, g_object_ref (layout2));
+
+  adw_multi_layout_view_set_child (view, "outer", outer1);
+  adw_multi_layout_view_set_child (view, "inner", inner);
+  g_assert_true (gtk_widget_get_parent (outer1) == slot1);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot1);
+
+  adw_multi_layout_view_set_child (view, "outer", outer2);
+  g_assert_null (gtk_widget_get_parent (outer1));
+  g_assert_true (gtk_widget_get_parent (outer2) == slot1);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot2);
+
+  g_assert_finalize_object (outer1);
+
+  adw_multi_layout_view_set_layout (view, layout2);
+  g_assert_true (gtk_widget_get_parent (outer2) == slot2);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot2);
+
+  adw_multi_layout_view_set_layout (view, layout1);
+  g_assert_true (gtk_widget_get_parent (outer2) == slot1);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot2);
+
+  g_assert_finalize_object (window);
+  g_assert_finalize_object (view);
+  g_assert_finalize_object (layout1);
+  g_assert_finalize_object (layout2);
+  g_assert_finalize_object (content1);
+  g_assert_finalize_object (content2);
+  g_assert_finalize_object (slot1);
+  g_assert_finalize_object (slot2);
+  g_assert_finalize_object (outer2);
+  g_assert_finalize_object (inner);
+}
+
+static void
+test_adw_multi_layout_view_deeply_nested (void)
+{
+  AdwMultiLayoutView *view = g_object_ref_sink (ADW_MULTI_LAYOUT_VIEW (adw_multi_layout_view_new ()));
+  GtkWidget *slot1 = g_object_ref_sink (adw_layout_slot_new ("outer"));
+  GtkWidget *slot2 = g_object_ref_sink (adw_layout_slot_new ("outer"));
+  GtkWidget *middle_slot = adw_layout_slot_new ("middle");
+  GtkWidget *inner_slot1 = adw_layout_slot_new ("inner");
+  GtkWidget *inner_slot2 = adw_layout_slot_new ("inner");
+  GtkWidget *deep_slot = adw_layout_slot_new ("deep");
+  GtkWidget *content1 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *content2 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *outer = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *middle1 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *middle2 = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *inner = g_object_ref_sink (adw_bin_new ());
+  GtkWidget *deep = g_object_ref_sink (adw_bin_new ());
+  AdwLayout *layout1, *layout2;
+  GtkWidget *window = adw_window_new ();
+
+  adw_bin_set_child (ADW_BIN (content1), slot1);
+  adw_bin_set_child (ADW_BIN (content2), slot2);
+  adw_bin_set_child (ADW_BIN (outer), middle_slot);
+  adw_bin_set_child (ADW_BIN (middle1), inner_slot1);
+  adw_bin_set_child (ADW_BIN (middle2), inner_slot2);
+  adw_bin_set_child (ADW_BIN (inner), deep_slot);
+
+  layout1 = adw_layout_new (content1);
+  layout2 = adw_layout_new (content2);
+
+  adw_window_set_content (ADW_WINDOW (window), GTK_WIDGET (view));
+  adw_multi_layout_view_add_layout (view, g_object_ref (layout1));
+  adw_multi_layout_view_add_layout (view, g_object_ref (layout2));
+
+  adw_multi_layout_view_set_child (view, "outer", outer);
+  adw_multi_layout_view_set_child (view, "middle", middle1);
+  adw_multi_layout_view_set_child (view, "inner", inner);
+  adw_multi_layout_view_set_child (view, "deep", deep);
+  g_assert_true (gtk_widget_get_parent (outer) == slot1);
+  g_assert_true (gtk_widget_get_parent (middle1) == middle_slot);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot1);
+  g_assert_true (gtk_widget_get_parent (deep) == deep_slot);
+
+  /* All of the nested slots register again, each must still belong to the
+   * child containing it rather than to the outermost one */
+  adw_multi_layout_view_set_layout (view, layout2);
+  g_assert_true (gtk_widget_get_parent (outer) == slot2);
+  g_assert_true (gtk_widget_get_parent (middle1) == middle_slot);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot1);
+  g_assert_true (gtk_widget_get_parent (deep) == deep_slot);
+
+  adw_multi_layout_view_set_child (view, "middle", middle2);
+  g_assert_null (gtk_widget_get_parent (middle1));
+  g_assert_true (gtk_widget_get_parent (middle2) == middle_slot);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot2);
+  g_assert_true (gtk_widget_get_parent (deep) == deep_slot);
+
+  g_assert_finalize_object (middle1);
+
+  adw_multi_layout_view_set_layout (view, layout1);
+  g_assert_true (gtk_widget_get_parent (outer) == slot1);
+  g_assert_true (gtk_widget_get_parent (middle2) == middle_slot);
+  g_assert_true (gtk_widget_get_parent (inner) == inner_slot2);
+  g_assert_true (gtk_widget_get_parent (deep) == deep_slot);
+
+  g_assert_finalize_object (window);
+  g_assert_finalize_object (view);
+  g_assert_finalize_object (layout1);
+  g_assert_finalize_object (layout2);
+  g_assert_finalize_object (content1);
+  g_assert_finalize_object (content2);
+  g_assert_finalize_object (slot1);
+  g_assert_finalize_object (slot2);
+  g_assert_finalize_object (outer);
+  g_assert_finalize_object (middle2);
+  g_assert_finalize_object (inner);
+  g_assert_finalize_object (deep);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -224,6 +418,9 @@ main (int   argc,
   g_test_add_func ("/Adwaita/MultiLayoutView/layout", test_adw_multi_layout_view_layout);
   g_test_add_func ("/Adwaita/MultiLayoutView/layout-name", test_adw_multi_layout_view_layout_name);
   g_test_add_func ("/Adwaita/MultiLayoutView/children", test_adw_multi_layout_view_children);
+  g_test_add_func ("/Adwaita/MultiLayoutView/nested-slots", test_adw_multi_layout_view_nested_slots);
+  g_test_add_func ("/Adwaita/MultiLayoutView/replace-nested", test_adw_multi_layout_view_replace_nested);
+  g_test_add_func ("/Adwaita/MultiLayoutView/deeply-nested", test_adw_multi_layout_view_deeply_nested);
 
   return g_test_run ();
 }
@@ -847,6 +847,112 @@ test_adw_navigation_page_signals (void)
   g_assert_finalize_object (page_3);
 }
 
+typedef struct {
+  int n_loaded;
+  int n_alive;
+} LoadData;
+
+static void
+child_finalized_cb (int     *n_alive,
+                    GObject *object)
+{
+  (*n_alive)--;
+}
+
+static GtkWidget *
+load_page (AdwNavigationPage *page,
+           LoadData          *data)
+{
+  GtkWidget *child = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  int i;
+
+  for (i = 0; i < 10; i++)
+    gtk_box_append (GTK_BOX (child), gtk_label_new ("Label"));
+
+  data->n_loaded++;
+  data->n_alive++;
+
+  g_object_weak_ref (G_OBJECT (child), (GWeakNotify) child_finalized_cb, &data->n_alive);
+
+  return child;
+}
+
+static void
+test_adw_navigation_view_max_loaded_pages (void)
+{
+  AdwNavigationView *view = g_object_ref_sink (ADW_NAVIGATION_VIEW (adw_navigation_view_new ()));
+  LoadData data = { 0, 0 };
+  GListModel *stack;
+  AdwNavigationPage *page;
+  int i, notified = 0;
+
+  g_assert_nonnull (view);
+
+  g_signal_connect_swapped (view, "notify::max-loaded-pages", G_CALLBACK (increment), &notified);
+
+  g_assert_cmpuint (adw_navigation_view_get_max_loaded_pages (view), ==, 0);
+
+  adw_navigation_view_set_max_loaded_pages (view, 3);
+  g_assert_cmpuint (adw_navigation_view_get_max_loaded_pages (view), ==, 3);
+  g_assert_cmpint (notified, ==, 1);
+
+  for (i = 0; i < 200; i++) {
+    page = g_object_new (ADW_TYPE_NAVIGATION_PAGE, "title", "Page", NULL);
+
+    adw_navigation_page_set_load_func (page, (AdwNavigationPageLoadFunc) load_page, &data, NULL);
+    g_assert_false (adw_navigation_page_get_loaded (page));
+
+    adw_navigation_view_push (view, page);
+    g_assert_true (adw_navigation_page_get_loaded (page));
+  }
+
+  /* Only the 3 topmost pages keep their children */
+  g_assert_cmpint (data.n_loaded, ==, 200);
+  g_assert_cmpint (data.n_alive, ==, 3);
+
+  stack = adw_navigation_view_get_navigation_stack (view);
+  g_assert_cmpuint (g_list_model_get_n_items (stack), ==, 200);
+
+  page = g_list_model_get_item (stack, 0);
+  g_assert_false (adw_navigation_page_get_loaded (page));
+  g_assert_null (adw_navigation_page_get_child (page));
+  g_assert_cmpstr (adw_navigation_page_get_title (page), ==, "Page");
+  g_object_unref (page);
+
+  page = g_list_model_get_item (stack, 197);
+  g_assert_true (adw_navigation_page_get_loaded (page));
+  g_object_unref (page);
+
+  g_object_unref (stack);
+
+  /* Popped pages are destroyed, unloaded pages are loaded again when shown */
+  adw_navigation_view_pop (view);
+  adw_navigation_view_pop (view);
+  g_assert_cmpint (data.n_loaded, ==, 200);
+  g_assert_cmpint (data.n_alive, ==, 1);
+
+  adw_navigation_view_pop (view);
+  g_assert_cmpint (data.n_loaded, ==, 201);
+  g_assert_cmpint (data.n_alive, ==, 1);
+  g_assert_true (adw_navigation_page_get_loaded (adw_navigation_view_get_visible_page (view)));
+
+  /* Without a limit, pages aren't unloaded */
+  adw_navigation_view_set_max_loaded_pages (view, 0);
+  g_assert_cmpint (notified, ==, 2);
+
+  for (i = 0; i < 5; i++) {
+    page = g_object_new (ADW_TYPE_NAVIGATION_PAGE, "title", "Page", NULL);
+
+    adw_navigation_page_set_load_func (page, (AdwNavigationPageLoadFunc) load_page, &data, NULL);
+    adw_navigation_view_push (view, page);
+  }
+
+  g_assert_cmpint (data.n_alive, ==, 6);
+
+  g_assert_finalize_object (view);
+  g_assert_cmpint (data.n_alive, ==, 0);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -863,6 +969,7 @@ main (int   argc,
   g_test_add_func ("/Adwaita/NavigationView/find_page", test_adw_navigation_view_find_page);
   g_test_add_func ("/Adwaita/NavigationView/animate_transitions", test_adw_navigation_view_animate_transitions);
   g_test_add_func ("/Adwaita/NavigationView/pop_on_escape", test_adw_navigation_view_pop_on_escape);
+  g_test_add_func ("/Adwaita/NavigationView/max_loaded_pages", test_adw_navigation_view_max_loaded_pages);
   g_test_add_func ("/Adwaita/NavigationPage/child", test_adw_navigation_page_child);
   g_test_add_func ("/Adwaita/NavigationPage/title", test_adw_navigation_page_title);
   g_test_add_func ("/Adwaita/NavigationPage/tag", test_adw_navigation_page_tag);
@@ -89,6 +89,222 @@ test_adw_preferences_group_separate_rows (void)
   g_assert_finalize_object (group);
 }
 
+static void
+setup_row_cb (GtkSignalListItemFactory *factory,
+              GtkListItem              *item)
+{
+  gtk_list_item_set_child (item, adw_action_row_new ());
+}
+
+static void
+test_adw_preferences_group_bind_model_with_factory (void)
+{
+  AdwPreferencesGroup *group = g_object_ref_sink (ADW_PREFERENCES_GROUP (adw_preferences_group_new ()));
+  const char * const strings[] = { "First", "Second", "Third", NULL };
+  GtkStringList *model = gtk_string_list_new (strings);
+  GtkListItemFactory *factory = gtk_signal_list_item_factory_new ();
+
+  g_assert_nonnull (group);
+
+  g_signal_connect (factory, "setup", G_CALLBACK (setup_row_cb), NULL);
+
+  adw_preferences_group_bind_model_with_factory (group, G_LIST_MODEL (model), factory);
+  g_assert_null (adw_preferences_group_get_row (group, 0));
+
+  adw_preferences_group_add (group, adw_preferences_row_new ());
+  g_assert_nonnull (adw_preferences_group_get_row (group, 0));
+  g_assert_null (adw_preferences_group_get_row (group, 1));
+
+  adw_preferences_group_bind_model_with_factory (group, NULL, NULL);
+
+  g_assert_finalize_object (model);
+  g_assert_finalize_object (factory);
+  g_assert_finalize_object (group);
+}
+
+typedef struct {
+  guint n_setup;
+  guint n_bind;
+  guint last_position;
+} FactoryData;
+
+static void
+count_setup_cb (GtkSignalListItemFactory *factory,
+                GtkListItem              *item,
+                FactoryData              *data)
+{
+  gtk_list_item_set_child (item, adw_action_row_new ());
+
+  data->n_setup++;
+}
+
+static void
+count_bind_cb (GtkSignalListItemFactory *factory,
+               GtkListItem              *item,
+               FactoryData              *data)
+{
+  GtkStringObject *string = gtk_list_item_get_item (item);
+
+  adw_preferences_row_set_title (ADW_PREFERENCES_ROW (gtk_list_item_get_child (item)),
+                                 gtk_string_object_get_string (string));
+
+  data->n_bind++;
+  data->last_position = MAX (data->last_position, gtk_list_item_get_position (item));
+}
+
+#define N_ITEMS 10000
+
+static void
+test_adw_preferences_group_bind_model_with_factory_recycle (void)
+{
+  GtkWidget *window = gtk_window_new ();
+  AdwPreferencesPage *page = ADW_PREFERENCES_PAGE (adw_preferences_page_new ());
+  AdwPreferencesGroup *group = ADW_PREFERENCES_GROUP (adw_preferences_group_new ());
+  GtkStringList *model = gtk_string_list_new (NULL);
+  GtkListItemFactory *factory = gtk_signal_list_item_factory_new ();
+  FactoryData data = { 0 };
+  GtkWidget *scrolled_window;
+  GtkAdjustment *adjustment;
+  guint i, n_setup;
+
+  for (i = 0; i < N_ITEMS; i++) {
+    char *string = g_strdup_printf ("Item %u", i);
+
+    gtk_string_list_take (model, string);
+  }
+
+  g_signal_connect (factory, "setup", G_CALLBACK (count_setup_cb), &data);
+  g_signal_connect (factory, "bind", G_CALLBACK (count_bind_cb), &data);
+
+  adw_preferences_group_bind_model_with_factory (group, G_LIST_MODEL (model), factory);
+  adw_preferences_page_add (page, group);
+
+  gtk_window_set_default_size (GTK_WINDOW (window), 400, 400);
+  gtk_window_set_child (GTK_WINDOW (window), GTK_WIDGET (page));
+  gtk_window_present (GTK_WINDOW (window));
+
+  while (data.n_bind == 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  /* Only the rows around the visible area exist */
+  g_assert_cmpuint (data.n_setup, >, 0);
+  g_assert_cmpuint (data.n_setup, <, N_ITEMS / 50);
+  g_assert_cmpuint (data.last_position, <, N_ITEMS / 50);
+
+  /* The list is scrolled along with the page */
+  scrolled_window = gtk_widget_get_ancestor (GTK_WIDGET (group), GTK_TYPE_SCROLLED_WINDOW);
+  adjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled_window));
+  g_assert_cmpfloat (gtk_adjustment_get_upper (adjustment), >, 400 * 10);
+
+  n_setup = data.n_setup;
+
+  gtk_adjustment_set_value (adjustment, gtk_adjustment_get_upper (adjustment));
+
+  while (data.last_position < N_ITEMS - 1)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* The existing rows have been reused for the new items */
+  g_assert_cmpuint (data.n_setup, <, n_setup * 2);
+  g_assert_cmpuint (data.n_bind, >, data.n_setup);
+
+  g_assert_finalize_object (window);
+  g_assert_finalize_object (model);
+  g_assert_finalize_object (factory);
+}
+
+static char *activated_title = NULL;
+
+static void
+row_activated_cb (AdwPreferencesRow *row)
+{
+  g_set_str (&activated_title, adw_preferences_row_get_title (row));
+}
+
+static GtkWidget *
+find_list_view (GtkWidget *widget)
+{
+  GtkWidget *child;
+
+  if (GTK_IS_LIST_VIEW (widget))
+    return widget;
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkWidget *list_view = find_list_view (child);
+
+    if (list_view)
+      return list_view;
+  }
+
+  return NULL;
+}
+
+static const char row_ui[] =
+  "<interface>"
+  "  <template class=\"GtkListItem\">"
+  "    <property name=\"child\">"
+  "      <object class=\"AdwActionRow\">"
+  "        <binding name=\"title\">"
+  "          <lookup name=\"string\" type=\"GtkStringObject\">"
+  "            <lookup name=\"item\">GtkListItem</lookup>"
+  "          </lookup>"
+  "        </binding>"
+  "        <signal name=\"activated\" handler=\"row_activated_cb\"/>"
+  "      </object>"
+  "    </property>"
+  "  </template>"
+  "</interface>";
+
+static void
+test_adw_preferences_group_bind_model_with_factory_activate (void)
+{
+  GtkWidget *window = gtk_window_new ();
+  AdwPreferencesPage *page = ADW_PREFERENCES_PAGE (adw_preferences_page_new ());
+  AdwPreferencesGroup *group = ADW_PREFERENCES_GROUP (adw_preferences_group_new ());
+  const char * const strings[] = { "First", "Second", "Third", NULL };
+  GtkStringList *model = gtk_string_list_new (strings);
+  GtkBuilderScope *scope = gtk_builder_cscope_new ();
+  GBytes *bytes = g_bytes_new_static (row_ui, sizeof (row_ui) - 1);
+  GtkListItemFactory *factory;
+  GtkWidget *list_view;
+
+  gtk_builder_cscope_add_callback (GTK_BUILDER_CSCOPE (scope), row_activated_cb);
+
+  /* Rows must activate without the group knowing how the factory works */
+  factory = gtk_builder_list_item_factory_new_from_bytes (scope, bytes);
+
+  adw_preferences_group_bind_model_with_factory (group, G_LIST_MODEL (model), factory);
+  adw_preferences_page_add (page, group);
+
+  gtk_window_set_default_size (GTK_WINDOW (window), 400, 400);
+  gtk_window_set_child (GTK_WINDOW (window), GTK_WIDGET (page));
+  gtk_window_present (GTK_WINDOW (window));
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  list_view = find_list_view (GTK_WIDGET (group));
+  g_assert_nonnull (list_view);
+
+  gtk_widget_activate_action (list_view, "list.activate-item", "u", 1);
+  g_assert_cmpstr (activated_title, ==, "Second");
+
+  gtk_widget_activate_action (list_view, "list.activate-item", "u", 2);
+  g_assert_cmpstr (activated_title, ==, "Third");
+
+  g_clear_pointer (&activated_title, g_free);
+
+  g_assert_finalize_object (window);
+  g_assert_finalize_object (model);
+  g_assert_finalize_object (factory);
+  g_object_unref (scope);
+  g_bytes_unref (bytes);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -100,6 +316,9 @@ main (int   argc,
   g_test_add_func("/Adwaita/PreferencesGroup/title", test_adw_preferences_group_title);
   g_test_add_func("/Adwaita/PreferencesGroup/description", test_adw_preferences_group_description);
   g_test_add_func("/Adwaita/PreferencesGroup/separate_rows", test_adw_preferences_group_separate_rows);
+  g_test_add_func("/Adwaita/PreferencesGroup/bind_model_with_factory", test_adw_preferences_group_bind_model_with_factory);
+  g_test_add_func("/Adwaita/PreferencesGroup/bind_model_with_factory_recycle", test_adw_preferences_group_bind_model_with_factory_recycle);
+  g_test_add_func("/Adwaita/PreferencesGroup/bind_model_with_factory_activate", test_adw_preferences_group_bind_model_with_factory_activate);
 
   return g_test_run();
 }
@@ -8,6 +8,8 @@
 
 #include <adwaita.h>
 
+#include "adw-shortcut-label-private.h"
+
 static void
 increment (int *data)
 {
@@ -68,6 +70,127 @@ test_adw_shortcut_label_disabled_text (void)
   g_assert_finalize_object (label);
 }
 
+static void
+test_adw_shortcut_label_search_text (void)
+{
+  char *text;
+
+  text = adw_shortcut_label_get_search_text (NULL);
+  g_assert_cmpstr (text, ==, "");
+  g_free (text);
+
+  text = adw_shortcut_label_get_search_text ("<Control>C");
+  g_assert_nonnull (strstr (text, "Ctrl "));
+  g_assert_nonnull (strstr (text, "Ctrl+C"));
+  g_free (text);
+
+  text = adw_shortcut_label_get_search_text ("<Shift>Page_Up <Alt>1...9");
+  g_assert_nonnull (strstr (text, "Shift "));
+  g_assert_nonnull (strstr (text, "Alt "));
+  g_assert_nonnull (strstr (text, "9 "));
+  g_free (text);
+}
+
+static int
+count_text_nodes (GskRenderNode *node)
+{
+  int n = 0;
+  guint i;
+
+  switch (gsk_render_node_get_node_type (node)) {
+  case GSK_TEXT_NODE:
+    return 1;
+  case GSK_CONTAINER_NODE:
+    for (i = 0; i < gsk_container_node_get_n_children (node); i++)
+      n += count_text_nodes (gsk_container_node_get_child (node, i));
+    return n;
+  case GSK_TRANSFORM_NODE:
+    return count_text_nodes (gsk_transform_node_get_child (node));
+  case GSK_OPACITY_NODE:
+    return count_text_nodes (gsk_opacity_node_get_child (node));
+  case GSK_ROUNDED_CLIP_NODE:
+    return count_text_nodes (gsk_rounded_clip_node_get_child (node));
+  case GSK_CLIP_NODE:
+    return count_text_nodes (gsk_clip_node_get_child (node));
+  default:
+    return 0;
+  }
+}
+
+static int
+count_drawn_labels (GtkWidget *widget)
+{
+  GtkSnapshot *snapshot = gtk_snapshot_new ();
+  GskRenderNode *node;
+  int n;
+
+  GTK_WIDGET_GET_CLASS (widget)->snapshot (widget, snapshot);
+
+  node = gtk_snapshot_free_to_node (snapshot);
+  g_assert_nonnull (node);
+
+  n = count_text_nodes (node);
+
+  gsk_render_node_unref (node);
+
+  return n;
+}
+
+static void
+test_adw_shortcut_label_draw_keycaps (void)
+{
+  AdwShortcutLabel *label = g_object_ref_sink (ADW_SHORTCUT_LABEL (adw_shortcut_label_new ("<Control>C <Control>X <Control>V")));
+  int width, height, width_wrapped, height_wrapped;
+
+  adw_shortcut_label_set_draw_keycaps (label, TRUE);
+
+  /* Everything is drawn by the label itself */
+  g_assert_null (gtk_widget_get_first_child (GTK_WIDGET (label)));
+
+  gtk_widget_measure (GTK_WIDGET (label), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (label), GTK_ORIENTATION_VERTICAL, width,
+                      NULL, &height, NULL, NULL);
+  g_assert_cmpint (width, >, 0);
+  g_assert_cmpint (height, >, 0);
+
+  gtk_widget_allocate (GTK_WIDGET (label), width, height, -1, NULL);
+
+  /* Six keycaps and two separators */
+  g_assert_cmpint (count_drawn_labels (GTK_WIDGET (label)), ==, 8);
+
+  /* Wrapping puts the shortcuts on separate lines */
+  adw_shortcut_label_set_wrap (label, TRUE);
+  gtk_widget_measure (GTK_WIDGET (label), GTK_ORIENTATION_HORIZONTAL, -1,
+                      &width_wrapped, NULL, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (label), GTK_ORIENTATION_VERTICAL, width_wrapped,
+                      NULL, &height_wrapped, NULL, NULL);
+  g_assert_cmpint (width_wrapped, <, width);
+  g_assert_cmpint (height_wrapped, >, height);
+
+  gtk_widget_allocate (GTK_WIDGET (label), width_wrapped, height_wrapped, -1, NULL);
+  g_assert_cmpint (count_drawn_labels (GTK_WIDGET (label)), ==, 8);
+
+  adw_shortcut_label_set_accelerator (label, "<Control>C");
+
+  /* Two keycaps, each at least as wide as the keycap minimum width and
+   * padding, with spacing between them */
+  gtk_widget_measure (GTK_WIDGET (label), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width_wrapped, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (label), GTK_ORIENTATION_VERTICAL, width_wrapped,
+                      NULL, &height_wrapped, NULL, NULL);
+  g_assert_cmpint (width_wrapped, <, width);
+  g_assert_cmpint (width_wrapped, >=, 2 * (20 + 12) + 6);
+
+  gtk_widget_allocate (GTK_WIDGET (label), width_wrapped, height_wrapped, -1, NULL);
+  g_assert_cmpint (count_drawn_labels (GTK_WIDGET (label)), ==, 2);
+
+  adw_shortcut_label_set_draw_keycaps (label, FALSE);
+  g_assert_nonnull (gtk_widget_get_first_child (GTK_WIDGET (label)));
+
+  g_assert_finalize_object (label);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -77,6 +200,8 @@ main (int   argc,
 
   g_test_add_func("/Adwaita/ShortcutLabel/accelerator", test_adw_shortcut_label_accelerator);
   g_test_add_func("/Adwaita/ShortcutLabel/disabled_text", test_adw_shortcut_label_disabled_text);
+  g_test_add_func("/Adwaita/ShortcutLabel/search_text", test_adw_shortcut_label_search_text);
+  g_test_add_func("/Adwaita/ShortcutLabel/draw_keycaps", test_adw_shortcut_label_draw_keycaps);
 
   return g_test_run();
 }
@@ -8,6 +8,7 @@
 
 #include <adwaita.h>
 #include "adw-settings-private.h"
+#include "adw-style-manager-private.h"
 
 static void
 increment (int *data)
@@ -200,6 +201,137 @@ test_adw_style_manager_inheritance (void)
   adw_style_manager_set_color_scheme (default_manager, ADW_COLOR_SCHEME_DEFAULT);
 }
 
+static void
+flush_main_context (void)
+{
+  while (g_main_context_iteration (NULL, FALSE));
+}
+
+static void
+record_n_updates (AdwStyleManager *manager,
+                  GParamSpec      *pspec,
+                  guint           *n_updates)
+{
+  *n_updates = adw_style_manager_get_n_stylesheet_updates (manager);
+}
+
+static void
+frame_update_cb (GdkFrameClock *frame_clock,
+                 guint         *n_updates)
+{
+  AdwStyleManager *manager = adw_style_manager_get_for_display (gdk_display_get_default ());
+
+  *n_updates = adw_style_manager_get_n_stylesheet_updates (manager);
+}
+
+static void
+test_adw_style_manager_batch_updates (void)
+{
+  AdwStyleManager *manager = adw_style_manager_get_for_display (gdk_display_get_default ());
+  AdwSettings *settings = adw_settings_get_default ();
+  guint n_updates, n_updates_when_notified = 0;
+
+  adw_settings_start_override (settings);
+  adw_settings_override_system_supports_color_schemes (settings, TRUE);
+  adw_settings_override_system_supports_accent_colors (settings, TRUE);
+  adw_settings_override_color_scheme (settings, ADW_SYSTEM_COLOR_SCHEME_DEFAULT);
+  adw_settings_override_high_contrast (settings, FALSE);
+  adw_settings_override_accent_color (settings, ADW_ACCENT_COLOR_BLUE);
+  flush_main_context ();
+
+  n_updates = adw_style_manager_get_n_stylesheet_updates (manager);
+
+  g_signal_connect (manager, "notify::dark",
+                    G_CALLBACK (record_n_updates), &n_updates_when_notified);
+
+  adw_settings_override_color_scheme (settings, ADW_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+  adw_settings_override_high_contrast (settings, TRUE);
+  adw_settings_override_accent_color (settings, ADW_ACCENT_COLOR_PURPLE);
+
+  /* Values change right away, the stylesheet only on the next frame */
+  g_assert_true (adw_style_manager_get_dark (manager));
+  g_assert_true (adw_style_manager_get_high_contrast (manager));
+  g_assert_cmpint (adw_style_manager_get_accent_color (manager), ==, ADW_ACCENT_COLOR_PURPLE);
+  g_assert_cmpuint (adw_style_manager_get_n_stylesheet_updates (manager), ==, n_updates);
+  g_assert_cmpuint (n_updates_when_notified, ==, 0);
+
+  /* Notifications are only emitted once the stylesheet is updated */
+  flush_main_context ();
+  g_assert_cmpuint (adw_style_manager_get_n_stylesheet_updates (manager), ==, n_updates + 1);
+  g_assert_cmpuint (n_updates_when_notified, ==, n_updates + 1);
+
+  g_signal_handlers_disconnect_by_func (manager, record_n_updates, &n_updates_when_notified);
+
+  adw_settings_end_override (settings);
+  flush_main_context ();
+  g_assert_cmpuint (adw_style_manager_get_n_stylesheet_updates (manager), ==, n_updates + 2);
+
+  /* Setting the color scheme explicitly applies immediately */
+  adw_style_manager_set_color_scheme (manager, ADW_COLOR_SCHEME_FORCE_DARK);
+  g_assert_cmpuint (adw_style_manager_get_n_stylesheet_updates (manager), ==, n_updates + 3);
+
+  adw_style_manager_set_color_scheme (manager, ADW_COLOR_SCHEME_DEFAULT);
+  flush_main_context ();
+}
+
+static void
+test_adw_style_manager_batch_updates_mapped (void)
+{
+  AdwStyleManager *manager = adw_style_manager_get_for_display (gdk_display_get_default ());
+  AdwSettings *settings = adw_settings_get_default ();
+  GtkWidget *window = gtk_window_new ();
+  GdkFrameClock *frame_clock;
+  guint n_updates, n_updates_in_frame = 0, n_updates_when_notified = 0;
+
+  adw_settings_start_override (settings);
+  adw_settings_override_system_supports_color_schemes (settings, TRUE);
+  adw_settings_override_color_scheme (settings, ADW_SYSTEM_COLOR_SCHEME_DEFAULT);
+  adw_settings_override_high_contrast (settings, FALSE);
+  flush_main_context ();
+
+  gtk_window_present (GTK_WINDOW (window));
+
+  while (!gtk_widget_get_mapped (window))
+    g_main_context_iteration (NULL, TRUE);
+
+  frame_clock = gtk_widget_get_frame_clock (window);
+  g_assert_nonnull (frame_clock);
+
+  flush_main_context ();
+
+  n_updates = adw_style_manager_get_n_stylesheet_updates (manager);
+
+  g_signal_connect (manager, "notify::dark",
+                    G_CALLBACK (record_n_updates), &n_updates_when_notified);
+
+  adw_settings_override_color_scheme (settings, ADW_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+  adw_settings_override_high_contrast (settings, TRUE);
+
+  g_assert_true (adw_style_manager_get_dark (manager));
+  g_assert_true (adw_style_manager_get_high_contrast (manager));
+  g_assert_cmpuint (adw_style_manager_get_n_stylesheet_updates (manager), ==, n_updates);
+
+  /* The style manager connected to the frame clock first, so this runs after
+   * it in the same update phase */
+  g_signal_connect (frame_clock, "update",
+                    G_CALLBACK (frame_update_cb), &n_updates_in_frame);
+
+  while (n_updates_when_notified == 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpuint (n_updates_in_frame, ==, n_updates + 1);
+  g_assert_cmpuint (n_updates_when_notified, ==, n_updates + 1);
+  g_assert_cmpuint (adw_style_manager_get_n_stylesheet_updates (manager), ==, n_updates + 1);
+
+  g_signal_handlers_disconnect_by_func (frame_clock, frame_update_cb, &n_updates_in_frame);
+  g_signal_handlers_disconnect_by_func (manager, record_n_updates, &n_updates_when_notified);
+
+  adw_settings_end_override (settings);
+  flush_main_context ();
+
+  g_assert_finalize_object (window);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -212,6 +344,8 @@ main (int   argc,
   g_test_add_func("/Adwaita/StyleManager/high_contrast", test_adw_style_manager_high_contrast);
   g_test_add_func("/Adwaita/StyleManager/system_supports_color_schemes", test_adw_style_manager_system_supports_color_schemes);
   g_test_add_func("/Adwaita/StyleManager/inheritance", test_adw_style_manager_inheritance);
+  g_test_add_func("/Adwaita/StyleManager/batch_updates", test_adw_style_manager_batch_updates);
+  g_test_add_func("/Adwaita/StyleManager/batch_updates_mapped", test_adw_style_manager_batch_updates_mapped);
 
   return g_test_run();
 }
@@ -8,12 +8,22 @@
 
 #include <adwaita.h>
 
+#include "adw-tab-search-private.h"
+
 static void
 increment (int *data)
 {
   (*data)++;
 }
 
+static void
+filter_changed_cb (GtkFilter       *filter,
+                   GtkFilterChange  change,
+                   GtkFilterChange *last_change)
+{
+  *last_change = change;
+}
+
 static void
 test_adw_tab_overview_view (void)
 {
@@ -305,6 +315,87 @@ test_adw_tab_overview_actions (void)
   g_assert_finalize_object (view);
 }
 
+static void
+test_adw_tab_overview_search (void)
+{
+  AdwTabView *view = g_object_ref_sink (ADW_TAB_VIEW (adw_tab_view_new ()));
+  AdwTabSearch *search = adw_tab_search_new ();
+  GtkFilter *filter = GTK_FILTER (search);
+  AdwTabPage *page1, *page2;
+  GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+  int notified = 0;
+
+  page1 = adw_tab_view_append (view, gtk_button_new ());
+  adw_tab_page_set_title (page1, "GNOME Foundation");
+
+  page2 = adw_tab_view_append (view, gtk_button_new ());
+  adw_tab_page_set_title (page2, "Blog");
+  adw_tab_page_set_keyword (page2, "https://blogs.gnome.org");
+
+  g_signal_connect (search, "changed", G_CALLBACK (filter_changed_cb), &change);
+  g_signal_connect_swapped (search, "changed", G_CALLBACK (increment), &notified);
+
+  g_assert_false (adw_tab_search_get_active (search));
+  g_assert_true (gtk_filter_match (filter, page1));
+  g_assert_true (gtk_filter_match (filter, page2));
+
+  adw_tab_search_set_terms (search, "gno");
+  g_assert_true (adw_tab_search_get_active (search));
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_true (gtk_filter_match (filter, page1));
+  g_assert_true (gtk_filter_match (filter, page2));
+
+  adw_tab_search_set_terms (search, "GNOME F");
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_true (gtk_filter_match (filter, page1));
+  g_assert_false (gtk_filter_match (filter, page2));
+
+  adw_tab_search_set_terms (search, "gnome f");
+  g_assert_cmpint (notified, ==, 2);
+
+  /* The page stopped matching */
+  adw_tab_page_set_title (page1, "Foundation");
+  g_assert_cmpint (notified, ==, 3);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_false (gtk_filter_match (filter, page1));
+
+  adw_tab_search_set_terms (search, "found");
+  g_assert_cmpint (notified, ==, 4);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_DIFFERENT);
+  g_assert_true (gtk_filter_match (filter, page1));
+  g_assert_false (gtk_filter_match (filter, page2));
+
+  /* A page that didn't match must be checked again when its title changes */
+  adw_tab_page_set_title (page2, "Found it");
+  g_assert_cmpint (notified, ==, 5);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_LESS_STRICT);
+  g_assert_true (gtk_filter_match (filter, page2));
+
+  /* Nothing changes if the page still matches, or for other properties */
+  adw_tab_page_set_tooltip (page2, "Blog post");
+  adw_tab_page_set_needs_attention (page2, TRUE);
+  g_assert_cmpint (notified, ==, 5);
+  g_assert_true (gtk_filter_match (filter, page2));
+
+  adw_tab_search_set_terms (search, "fo");
+  g_assert_cmpint (notified, ==, 6);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_LESS_STRICT);
+
+  adw_tab_search_set_terms (search, "");
+  g_assert_false (adw_tab_search_get_active (search));
+  g_assert_cmpint (notified, ==, 7);
+  g_assert_cmpint (change, ==, GTK_FILTER_CHANGE_LESS_STRICT);
+  g_assert_true (gtk_filter_match (filter, page2));
+
+  adw_tab_search_remove_page (search, page1);
+  adw_tab_search_remove_page (search, page2);
+
+  g_assert_finalize_object (search);
+  g_assert_finalize_object (view);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -322,6 +413,7 @@ main (int   argc,
   g_test_add_func ("/Adwaita/TabOverview/show_start_title_buttons", test_adw_tab_overview_show_start_title_buttons);
   g_test_add_func ("/Adwaita/TabOverview/show_end_title_buttons", test_adw_tab_overview_show_end_title_buttons);
   g_test_add_func ("/Adwaita/TabOverview/actions", test_adw_tab_overview_actions);
+  g_test_add_func ("/Adwaita/TabOverview/search", test_adw_tab_overview_search);
 
   return g_test_run ();
 }
@@ -8,6 +8,8 @@
 
 #include <adwaita.h>
 
+#include "adw-tab-view-private.h"
+
 static void
 increment (int *data)
 {
@@ -1408,6 +1410,105 @@ test_adw_tab_view_pages_to_list_view (void)
   g_assert_finalize_object (pages);
 }
 
+typedef struct {
+  GdkFrameClock *frame_clock;
+  gint64 frame;
+  int n_in_frame;
+  int max_in_frame;
+} RenderCounter;
+
+typedef struct {
+  RenderCounter *counter;
+  int n_renders;
+} PageRenders;
+
+static void
+thumbnail_rendered_cb (PageRenders *renders)
+{
+  RenderCounter *counter = renders->counter;
+  gint64 frame = gdk_frame_clock_get_frame_counter (counter->frame_clock);
+
+  if (frame != counter->frame) {
+    counter->frame = frame;
+    counter->n_in_frame = 0;
+  }
+
+  counter->n_in_frame++;
+  counter->max_in_frame = MAX (counter->max_in_frame, counter->n_in_frame);
+
+  renders->n_renders++;
+}
+
+static void
+set_done (gboolean *done)
+{
+  *done = TRUE;
+}
+
+#define N_LIVE_PAGES 6
+#define RENDER_TEST_DURATION 500
+
+static void
+test_adw_tab_view_thumbnail_render_limit (void)
+{
+  GtkWidget *window = gtk_window_new ();
+  AdwTabView *view = ADW_TAB_VIEW (adw_tab_view_new ());
+  AdwTabPage *pages[N_LIVE_PAGES];
+  PageRenders renders[N_LIVE_PAGES];
+  RenderCounter counter = { NULL, -1, 0, 0 };
+  gboolean done = FALSE;
+  int i;
+
+  gtk_window_set_child (GTK_WINDOW (window), GTK_WIDGET (view));
+  gtk_window_present (GTK_WINDOW (window));
+
+  /* Spinners redraw on every frame */
+  for (i = 0; i < N_LIVE_PAGES; i++) {
+    pages[i] = adw_tab_view_append (view, adw_spinner_new ());
+    adw_tab_page_set_live_thumbnail (pages[i], TRUE);
+  }
+
+  while (!gtk_widget_get_mapped (GTK_WIDGET (view)))
+    g_main_context_iteration (NULL, TRUE);
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  counter.frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (view));
+
+  for (i = 0; i < N_LIVE_PAGES; i++) {
+    GdkPaintable *paintable = adw_tab_page_get_paintable (pages[i]);
+
+    renders[i].counter = &counter;
+    renders[i].n_renders = 0;
+
+    g_signal_connect_swapped (paintable, "invalidate-contents",
+                              G_CALLBACK (thumbnail_rendered_cb), &renders[i]);
+    g_signal_connect_swapped (paintable, "invalidate-size",
+                              G_CALLBACK (thumbnail_rendered_cb), &renders[i]);
+  }
+
+  adw_tab_view_open_overview (view);
+
+  g_timeout_add_once (RENDER_TEST_DURATION, (GSourceOnceFunc) set_done, &done);
+
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* At most 2 thumbnails are rendered per frame, and each one at most 15
+   * times per second, but all of them are rendered eventually */
+  g_assert_cmpint (counter.max_in_frame, <=, 2);
+
+  for (i = 0; i < N_LIVE_PAGES; i++) {
+    g_assert_cmpint (renders[i].n_renders, >, 0);
+    g_assert_cmpint (renders[i].n_renders, <=, RENDER_TEST_DURATION * 15 / 1000 + 1);
+  }
+
+  adw_tab_view_close_overview (view);
+
+  g_assert_finalize_object (window);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -1448,6 +1549,7 @@ main (int   argc,
   g_test_add_func ("/Adwaita/TabPage/thumbnail_xalign", test_adw_tab_page_thumbnail_xalign);
   g_test_add_func ("/Adwaita/TabPage/thumbnail_yalign", test_adw_tab_page_thumbnail_yalign);
   g_test_add_func ("/Adwaita/TabPage/live_thumbnail", test_adw_tab_page_live_thumbnail);
+  g_test_add_func ("/Adwaita/TabView/thumbnail_render_limit", test_adw_tab_view_thumbnail_render_limit);
 
   return g_test_run ();
 }
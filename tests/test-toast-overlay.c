@@ -12,6 +12,26 @@ increment (int *data)
   (*data)++;
 }
 
+static GtkWidget *
+find_count_label (GtkWidget *widget)
+{
+  GtkWidget *child;
+
+  if (GTK_IS_LABEL (widget) && gtk_widget_has_css_class (widget, "numeric"))
+    return widget;
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkWidget *label = find_count_label (child);
+
+    if (label)
+      return label;
+  }
+
+  return NULL;
+}
+
 static void
 test_adw_toast_overlay_child (void)
 {
@@ -75,6 +95,195 @@ test_adw_toast_overlay_dismiss_all (void)
   g_assert_finalize_object (toast);
 }
 
+static void
+test_adw_toast_overlay_key (void)
+{
+  AdwToastOverlay *toast_overlay = g_object_ref_sink (ADW_TOAST_OVERLAY (adw_toast_overlay_new ()));
+  AdwToast *toast1 = adw_toast_new ("First");
+  AdwToast *toast2 = adw_toast_new ("Second");
+  AdwToast *toast3 = adw_toast_new ("3 files synced");
+  AdwToast *toast4 = adw_toast_new ("4 files synced");
+  int dismissed = 0, discarded = 0;
+
+  adw_toast_set_key (toast3, "sync");
+  adw_toast_set_key (toast4, "sync");
+  adw_toast_set_button_label (toast4, "Open");
+  adw_toast_set_detailed_action_name (toast4, "app.open-folder::Documents");
+
+  g_signal_connect_swapped (toast3, "dismissed", G_CALLBACK (increment), &dismissed);
+  g_signal_connect_swapped (toast4, "dismissed", G_CALLBACK (increment), &discarded);
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast1));
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast2));
+
+  /* Queued */
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast3));
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast4));
+
+  g_assert_cmpstr (adw_toast_get_title (toast3), ==, "4 files synced");
+  g_assert_cmpstr (adw_toast_get_button_label (toast3), ==, "Open");
+  g_assert_cmpstr (adw_toast_get_action_name (toast3), ==, "app.open-folder");
+  g_assert_cmpstr (g_variant_get_string (adw_toast_get_action_target_value (toast3), NULL), ==, "Documents");
+  g_assert_cmpint (dismissed, ==, 0);
+  g_assert_cmpint (discarded, ==, 1);
+
+  g_assert_finalize_object (toast4);
+
+  /* Shown */
+  adw_toast_dismiss (toast1);
+  adw_toast_dismiss (toast2);
+
+  toast4 = adw_toast_new ("5 files synced");
+  adw_toast_set_key (toast4, "sync");
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast4));
+
+  g_assert_cmpstr (adw_toast_get_title (toast3), ==, "5 files synced");
+  g_assert_finalize_object (toast4);
+
+  /* Once the toast is dismissed, the key can be used again */
+  adw_toast_dismiss (toast3);
+  g_assert_cmpint (dismissed, ==, 1);
+
+  toast4 = adw_toast_new ("6 files synced");
+  adw_toast_set_key (toast4, "sync");
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast4));
+
+  g_assert_cmpstr (adw_toast_get_title (toast3), ==, "5 files synced");
+
+  g_assert_finalize_object (toast_overlay);
+  g_assert_finalize_object (toast1);
+  g_assert_finalize_object (toast2);
+  g_assert_finalize_object (toast3);
+  g_assert_finalize_object (toast4);
+}
+
+static void
+test_adw_toast_overlay_key_count (void)
+{
+  AdwToastOverlay *toast_overlay = g_object_ref_sink (ADW_TOAST_OVERLAY (adw_toast_overlay_new ()));
+  AdwToast *toast1 = adw_toast_new ("1 file synced");
+  AdwToast *toast2 = adw_toast_new ("2 files synced");
+  AdwToast *toast3 = adw_toast_new ("3 files synced");
+  GtkWidget *label;
+
+  adw_toast_set_key (toast1, "sync");
+  adw_toast_set_key (toast2, "sync");
+  adw_toast_set_key (toast3, "sync");
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast1));
+
+  label = find_count_label (GTK_WIDGET (toast_overlay));
+  g_assert_nonnull (label);
+  g_assert_false (gtk_widget_get_visible (label));
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast2));
+  g_assert_true (gtk_widget_get_visible (label));
+  g_assert_cmpstr (gtk_label_get_label (GTK_LABEL (label)), ==, "(2)");
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toast3));
+  g_assert_cmpstr (gtk_label_get_label (GTK_LABEL (label)), ==, "(3)");
+
+  g_assert_finalize_object (toast_overlay);
+  g_assert_finalize_object (toast1);
+  g_assert_finalize_object (toast2);
+  g_assert_finalize_object (toast3);
+}
+
+static void
+test_adw_toast_overlay_max_queue_length (void)
+{
+  AdwToastOverlay *toast_overlay = g_object_ref_sink (ADW_TOAST_OVERLAY (adw_toast_overlay_new ()));
+  AdwToast *toasts[5];
+  int dismissed[5] = { 0 };
+  int notified = 0;
+  guint max_queue_length;
+  AdwToastDropPolicy policy;
+  guint i;
+
+  g_signal_connect_swapped (toast_overlay, "notify::max-queue-length", G_CALLBACK (increment), &notified);
+  g_signal_connect_swapped (toast_overlay, "notify::drop-policy", G_CALLBACK (increment), &notified);
+
+  g_object_get (toast_overlay,
+                "max-queue-length", &max_queue_length,
+                "drop-policy", &policy,
+                NULL);
+  g_assert_cmpuint (max_queue_length, ==, 0);
+  g_assert_cmpint (policy, ==, ADW_TOAST_DROP_POLICY_OLDEST);
+
+  adw_toast_overlay_set_max_queue_length (toast_overlay, 2);
+  g_assert_cmpuint (adw_toast_overlay_get_max_queue_length (toast_overlay), ==, 2);
+  g_assert_cmpint (notified, ==, 1);
+
+  for (i = 0; i < G_N_ELEMENTS (toasts); i++) {
+    toasts[i] = adw_toast_new ("Toast");
+    g_signal_connect_swapped (toasts[i], "dismissed", G_CALLBACK (increment), &dismissed[i]);
+  }
+
+  /* The first toast is shown, the next two are queued */
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[0]));
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[1]));
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[2]));
+  g_assert_cmpint (dismissed[1], ==, 0);
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[3]));
+  g_assert_cmpint (dismissed[0], ==, 0);
+  g_assert_cmpint (dismissed[1], ==, 1);
+  g_assert_cmpint (dismissed[2], ==, 0);
+  g_assert_cmpint (dismissed[3], ==, 0);
+
+  adw_toast_overlay_set_drop_policy (toast_overlay, ADW_TOAST_DROP_POLICY_NEWEST);
+  g_assert_cmpint (adw_toast_overlay_get_drop_policy (toast_overlay), ==, ADW_TOAST_DROP_POLICY_NEWEST);
+  g_assert_cmpint (notified, ==, 2);
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[4]));
+  g_assert_cmpint (dismissed[2], ==, 0);
+  g_assert_cmpint (dismissed[3], ==, 0);
+  g_assert_cmpint (dismissed[4], ==, 1);
+
+  adw_toast_overlay_set_max_queue_length (toast_overlay, 1);
+  g_assert_cmpint (dismissed[2], ==, 0);
+  g_assert_cmpint (dismissed[3], ==, 1);
+  g_assert_cmpint (notified, ==, 3);
+
+  g_assert_finalize_object (toast_overlay);
+
+  for (i = 0; i < G_N_ELEMENTS (toasts); i++)
+    g_assert_finalize_object (toasts[i]);
+}
+
+static void
+test_adw_toast_overlay_max_queue_length_priority (void)
+{
+  AdwToastOverlay *toast_overlay = g_object_ref_sink (ADW_TOAST_OVERLAY (adw_toast_overlay_new ()));
+  AdwToast *toasts[3];
+  int dismissed[3] = { 0 };
+  guint i;
+
+  adw_toast_overlay_set_max_queue_length (toast_overlay, 1);
+
+  for (i = 0; i < G_N_ELEMENTS (toasts); i++) {
+    toasts[i] = adw_toast_new ("Toast");
+    g_signal_connect_swapped (toasts[i], "dismissed", G_CALLBACK (increment), &dismissed[i]);
+  }
+
+  adw_toast_set_priority (toasts[2], ADW_TOAST_PRIORITY_HIGH);
+
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[0]));
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[1]));
+
+  /* The first toast goes back into the queue, the oldest queued toast is
+   * dropped instead of it */
+  adw_toast_overlay_add_toast (toast_overlay, g_object_ref (toasts[2]));
+  g_assert_cmpint (dismissed[0], ==, 0);
+  g_assert_cmpint (dismissed[1], ==, 1);
+  g_assert_cmpint (dismissed[2], ==, 0);
+
+  g_assert_finalize_object (toast_overlay);
+
+  for (i = 0; i < G_N_ELEMENTS (toasts); i++)
+    g_assert_finalize_object (toasts[i]);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -85,6 +294,10 @@ main (int   argc,
   g_test_add_func ("/Adwaita/ToastOverlay/child", test_adw_toast_overlay_child);
   g_test_add_func ("/Adwaita/ToastOverlay/add_toast", test_adw_toast_overlay_add_toast);
   g_test_add_func ("/Adwaita/ToastOverlay/dismiss_all", test_adw_toast_overlay_dismiss_all);
+  g_test_add_func ("/Adwaita/ToastOverlay/key", test_adw_toast_overlay_key);
+  g_test_add_func ("/Adwaita/ToastOverlay/key_count", test_adw_toast_overlay_key_count);
+  g_test_add_func ("/Adwaita/ToastOverlay/max_queue_length", test_adw_toast_overlay_max_queue_length);
+  g_test_add_func ("/Adwaita/ToastOverlay/max_queue_length_priority", test_adw_toast_overlay_max_queue_length_priority);
 
   return g_test_run ();
 }
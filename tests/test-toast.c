@@ -317,6 +317,52 @@ test_adw_toast_use_markup (void)
   g_assert_finalize_object (toast);
 }
 
+static void
+test_adw_toast_key (void)
+{
+  AdwToast *toast = adw_toast_new ("Title");
+  char *key;
+  int notified = 0;
+
+  g_signal_connect_swapped (toast, "notify::key", G_CALLBACK (increment), &notified);
+
+  g_object_get (toast, "key", &key, NULL);
+  g_assert_null (key);
+
+  adw_toast_set_key (toast, "sync");
+  g_assert_cmpstr (adw_toast_get_key (toast), ==, "sync");
+  g_assert_cmpint (notified, ==, 1);
+
+  adw_toast_set_key (toast, "sync");
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (toast, "key", NULL, NULL);
+  g_assert_null (adw_toast_get_key (toast));
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (toast);
+}
+
+static void
+test_adw_toast_key_action_target (void)
+{
+  AdwToast *toast = adw_toast_new ("Title");
+  int notified = 0;
+
+  adw_toast_set_key (toast, "sync");
+
+  g_signal_connect_swapped (toast, "notify::key", G_CALLBACK (increment), &notified);
+
+  adw_toast_set_action_target (toast, "i", 1);
+  g_assert_cmpstr (adw_toast_get_key (toast), ==, "sync");
+
+  adw_toast_set_action_target_value (toast, NULL);
+  g_assert_cmpstr (adw_toast_get_key (toast), ==, "sync");
+  g_assert_cmpint (notified, ==, 0);
+
+  g_assert_finalize_object (toast);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -336,6 +382,8 @@ main (int   argc,
   g_test_add_func ("/Adwaita/Toast/custom_title", test_adw_toast_custom_title);
   g_test_add_func ("/Adwaita/Toast/custom_title_overlay", test_adw_toast_custom_title_overlay);
   g_test_add_func ("/Adwaita/Toast/use_markup", test_adw_toast_use_markup);
+  g_test_add_func ("/Adwaita/Toast/key", test_adw_toast_key);
+  g_test_add_func ("/Adwaita/Toast/key_action_target", test_adw_toast_key_action_target);
 
   return g_test_run ();
 }
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 GNOME Foundation Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adwaita.h>
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+static GtkWidget *
+load_page (AdwViewStackPage *page,
+           int              *n_loaded)
+{
+  (*n_loaded)++;
+
+  return gtk_button_new ();
+}
+
+static void
+test_adw_view_stack_lazy (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  AdwViewStackPage *page1, *page2;
+  GtkWidget *child1, *child2;
+  int n_loaded1 = 0, n_loaded2 = 0, notified = 0;
+
+  g_assert_nonnull (stack);
+
+  page1 = adw_view_stack_add_lazy (stack, "page1",
+                                   (AdwViewStackPageLoadFunc) load_page,
+                                   &n_loaded1, NULL);
+  page2 = adw_view_stack_add_lazy (stack, "page2",
+                                   (AdwViewStackPageLoadFunc) load_page,
+                                   &n_loaded2, NULL);
+  adw_view_stack_page_set_title (page2, "Page 2");
+  adw_view_stack_page_set_badge_number (page2, 3);
+
+  child1 = adw_view_stack_page_get_child (page1);
+  child2 = adw_view_stack_page_get_child (page2);
+
+  g_signal_connect_swapped (page2, "notify::loaded", G_CALLBACK (increment), &notified);
+
+  /* The first page is shown right away, the second one isn't loaded yet */
+  g_assert_true (adw_view_stack_get_visible_child (stack) == child1);
+  g_assert_true (adw_view_stack_page_get_loaded (page1));
+  g_assert_false (adw_view_stack_page_get_loaded (page2));
+  g_assert_cmpint (n_loaded1, ==, 1);
+  g_assert_cmpint (n_loaded2, ==, 0);
+  g_assert_cmpstr (adw_view_stack_page_get_title (page2), ==, "Page 2");
+
+  adw_view_stack_set_visible_child_name (stack, "page2");
+  g_assert_true (adw_view_stack_get_visible_child (stack) == child2);
+  g_assert_true (adw_view_stack_page_get_loaded (page2));
+  g_assert_cmpint (n_loaded2, ==, 1);
+  g_assert_cmpint (notified, ==, 1);
+
+  /* Pages are kept by default */
+  g_assert_cmpint (adw_view_stack_page_get_unload_policy (page1), ==, ADW_VIEW_STACK_UNLOAD_POLICY_KEEP);
+  g_assert_true (adw_view_stack_page_get_loaded (page1));
+
+  adw_view_stack_page_set_unload_policy (page2, ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE);
+  g_assert_true (adw_view_stack_page_get_loaded (page2));
+
+  adw_view_stack_set_visible_child (stack, child1);
+  g_assert_false (adw_view_stack_page_get_loaded (page2));
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_cmpstr (adw_view_stack_page_get_title (page2), ==, "Page 2");
+  g_assert_cmpuint (adw_view_stack_page_get_badge_number (page2), ==, 3);
+
+  /* The page is loaded again when shown */
+  adw_view_stack_set_visible_child (stack, child2);
+  g_assert_true (adw_view_stack_page_get_loaded (page2));
+  g_assert_cmpint (n_loaded2, ==, 2);
+  g_assert_cmpint (notified, ==, 3);
+
+  /* Hidden pages are unloaded as soon as the policy allows it */
+  adw_view_stack_page_set_unload_policy (page1, ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE);
+  g_assert_false (adw_view_stack_page_get_loaded (page1));
+
+  g_assert_finalize_object (stack);
+}
+
+static void
+test_adw_view_stack_lazy_policy (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  AdwViewStackPage *page;
+  GtkWidget *child;
+  int notified = 0;
+
+  g_assert_nonnull (stack);
+
+  child = gtk_button_new ();
+  adw_view_stack_add (stack, child);
+  page = adw_view_stack_add (stack, gtk_button_new ());
+
+  g_signal_connect_swapped (page, "notify::unload-policy", G_CALLBACK (increment), &notified);
+
+  g_assert_cmpuint (adw_view_stack_page_get_unload_timeout (page), ==, 30);
+
+  adw_view_stack_page_set_unload_policy (page, ADW_VIEW_STACK_UNLOAD_POLICY_KEEP);
+  g_assert_cmpint (notified, ==, 0);
+
+  g_object_set (page, "unload-policy", ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE, NULL);
+  g_assert_cmpint (adw_view_stack_page_get_unload_policy (page), ==, ADW_VIEW_STACK_UNLOAD_POLICY_IMMEDIATE);
+  g_assert_cmpint (notified, ==, 1);
+
+  /* Regular pages can't be unloaded */
+  adw_view_stack_set_visible_child (stack, adw_view_stack_page_get_child (page));
+  adw_view_stack_set_visible_child (stack, child);
+  g_assert_true (adw_view_stack_page_get_loaded (page));
+  g_assert_nonnull (adw_view_stack_page_get_child (page));
+
+  g_assert_finalize_object (stack);
+}
+
+static void
+test_adw_view_stack_names (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  GtkWidget *child1 = gtk_button_new ();
+  GtkWidget *child2 = gtk_button_new ();
+  AdwViewStackPage *page1, *page2;
+
+  g_assert_nonnull (stack);
+
+  page1 = adw_view_stack_add_named (stack, child1, "page1");
+  page2 = adw_view_stack_add_named (stack, child2, "page2");
+
+  g_assert_true (adw_view_stack_get_page (stack, child1) == page1);
+  g_assert_true (adw_view_stack_get_page (stack, child2) == page2);
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "page1") == child1);
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "page2") == child2);
+
+  adw_view_stack_page_set_name (page2, "renamed");
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "page2"));
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "renamed") == child2);
+
+  adw_view_stack_set_visible_child_name (stack, "renamed");
+  g_assert_true (adw_view_stack_get_visible_child (stack) == child2);
+  g_assert_cmpstr (adw_view_stack_get_visible_child_name (stack), ==, "renamed");
+
+  adw_view_stack_remove (stack, child1);
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "page1"));
+
+  adw_view_stack_page_set_name (page2, NULL);
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "renamed"));
+
+  g_assert_finalize_object (stack);
+}
+
+static void
+items_changed_cb (GListModel *model,
+                  guint       position,
+                  guint       removed,
+                  guint       added,
+                  int        *n_added)
+{
+  *n_added += added;
+}
+
+static void
+test_adw_view_stack_add_pages (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  GtkSelectionModel *pages = adw_view_stack_get_pages (stack);
+  AdwViewStackPage *new_pages[3];
+  int changed = 0, n_added = 0;
+  guint i;
+
+  g_assert_nonnull (stack);
+
+  g_signal_connect_swapped (pages, "items-changed", G_CALLBACK (increment), &changed);
+  g_signal_connect (pages, "items-changed", G_CALLBACK (items_changed_cb), &n_added);
+
+  for (i = 0; i < G_N_ELEMENTS (new_pages); i++) {
+    char *name = g_strdup_printf ("page%u", i);
+
+    new_pages[i] = g_object_new (ADW_TYPE_VIEW_STACK_PAGE,
+                                 "child", gtk_button_new (),
+                                 "name", name,
+                                 NULL);
+
+    g_free (name);
+  }
+
+  adw_view_stack_add_pages (stack, new_pages, G_N_ELEMENTS (new_pages));
+  g_assert_cmpint (changed, ==, 1);
+  g_assert_cmpint (n_added, ==, 3);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (pages)), ==, 3);
+  g_assert_true (adw_view_stack_get_visible_child (stack) == adw_view_stack_page_get_child (new_pages[0]));
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "page2") == adw_view_stack_page_get_child (new_pages[2]));
+
+  for (i = 0; i < G_N_ELEMENTS (new_pages); i++)
+    g_object_unref (new_pages[i]);
+
+  g_assert_finalize_object (pages);
+  g_assert_finalize_object (stack);
+}
+
+static void
+removed_cb (GListModel *model,
+            guint       position,
+            guint       removed,
+            guint       added,
+            int        *removed_position)
+{
+  *removed_position = position;
+}
+
+static void
+test_adw_view_stack_remove (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  GtkSelectionModel *pages = adw_view_stack_get_pages (stack);
+  GtkWidget *children[4];
+  int removed_position = -1;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (children); i++) {
+    children[i] = gtk_button_new ();
+    adw_view_stack_add (stack, children[i]);
+  }
+
+  g_signal_connect (pages, "items-changed", G_CALLBACK (removed_cb), &removed_position);
+
+  adw_view_stack_remove (stack, children[1]);
+  g_assert_cmpint (removed_position, ==, 1);
+
+  adw_view_stack_remove (stack, children[3]);
+  g_assert_cmpint (removed_position, ==, 2);
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (pages)), ==, 2);
+
+  for (i = 0; i < 2; i++) {
+    AdwViewStackPage *page = g_list_model_get_item (G_LIST_MODEL (pages), i);
+
+    g_assert_true (adw_view_stack_page_get_child (page) == children[i * 2]);
+
+    g_object_unref (page);
+  }
+
+  adw_view_stack_remove (stack, children[0]);
+  g_assert_cmpint (removed_position, ==, 0);
+
+  adw_view_stack_remove (stack, children[2]);
+  g_assert_cmpint (removed_position, ==, 0);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (pages)), ==, 0);
+
+  g_assert_finalize_object (pages);
+  g_assert_finalize_object (stack);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Adwaita/ViewStack/lazy", test_adw_view_stack_lazy);
+  g_test_add_func ("/Adwaita/ViewStack/lazy_policy", test_adw_view_stack_lazy_policy);
+  g_test_add_func ("/Adwaita/ViewStack/names", test_adw_view_stack_names);
+  g_test_add_func ("/Adwaita/ViewStack/add_pages", test_adw_view_stack_add_pages);
+  g_test_add_func ("/Adwaita/ViewStack/remove", test_adw_view_stack_remove);
+
+  return g_test_run ();
+}